@@ -0,0 +1,65 @@
+#include <ActionChainExecutor.h>
+#include <NullPlatform.h>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+// How late action chain steps send their keybind against their deadlines. Each iteration runs a 20-step chain with 5 ms between
+// steps to completion; the lateness statistics over all steps are reported as counters, in nanoseconds.
+void ActionChainLateness(benchmark::State& state)
+{
+    using namespace std::chrono;
+    using Clock                     = ActionChainExecutor::Clock;
+    constexpr uint32_t     Steps    = 20;
+    constexpr milliseconds StepDelay{ 5 };
+
+    NullPlatform           platform;
+    const Platform         previous = CurrentPlatform();
+    SetCurrentPlatform(platform.platform());
+
+    ActionChainExecutor executor;
+    std::mutex          latenessMutex;
+    std::vector<double> lateness;
+    for (auto _ : state)
+    {
+        const auto                             start = Clock::now() + StepDelay;
+        std::vector<ActionChainExecutor::Step> steps;
+        for (uint32_t i = 0; i < Steps; i++)
+            steps.push_back({ [&, due = start + StepDelay * i]
+                              {
+                                  const bool      sent = CurrentPlatform().input->PressKeybindNow({ 0x1E, 0 });
+                                  std::lock_guard lock(latenessMutex);
+                                  lateness.push_back(duration<double, std::nano>(Clock::now() - due).count());
+                                  return sent;
+                              },
+                              StepDelay });
+
+        const auto chain = executor.Submit(std::move(steps), start);
+        while (ActionChainExecutor::IsActive(chain))
+            std::this_thread::sleep_for(StepDelay);
+    }
+
+    std::lock_guard lock(latenessMutex);
+    if (!lateness.empty())
+    {
+        std::ranges::sort(lateness);
+        double sum = 0.0;
+        for (double l : lateness)
+            sum += l;
+        state.counters["mean_ns"] = sum / double(lateness.size());
+        state.counters["p99_ns"]  = lateness[lateness.size() * 99 / 100];
+        state.counters["max_ns"]  = lateness.back();
+    }
+    state.counters["sent"] = double(platform.sentKeybinds.size());
+
+    if (previous.clock)
+        SetCurrentPlatform(previous);
+}
+BENCHMARK(ActionChainLateness)->Unit(benchmark::kMillisecond)->Iterations(5);
+} // namespace
+} // namespace GW2Radial
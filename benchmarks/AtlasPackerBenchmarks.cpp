@@ -0,0 +1,45 @@
+#include <AtlasPacker.h>
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace GW2Radial
+{
+namespace
+{
+// Icon sizes as wheels load them: mostly square, up to IconAtlas::MaxIconEdge
+std::vector<AtlasSize> MakeIconSizes(size_t count)
+{
+    std::mt19937                            rng(42);
+    std::uniform_int_distribution<uint32_t> edge(32, 512);
+    std::vector<AtlasSize>                  sizes(count);
+    for (auto& size : sizes)
+        size.width = size.height = edge(rng);
+    return sizes;
+}
+
+// A full repack, with IconAtlas' page size, padding and alignment
+void PackIcons(benchmark::State& state)
+{
+    const auto sizes = MakeIconSizes(size_t(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PackIntoPages(sizes, 2048, 2048, 16, 16));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PackIcons)->Arg(200);
+
+// Icons added one at a time into a page with room to spare, as Add does between repacks
+void InsertIcons(benchmark::State& state)
+{
+    const auto  sizes = MakeIconSizes(size_t(state.range(0)));
+    AtlasPacker packer(8192, 8192, 16, 16);
+    for (auto _ : state)
+    {
+        packer.Reset();
+        for (const auto& size : sizes)
+            benchmark::DoNotOptimize(packer.Insert(size.width, size.height));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(InsertIcons)->Arg(200);
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,190 @@
+#include <BlobCache.h>
+#include <ConfigSnapshot.h>
+#include <ConfigWriteBehind.h>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef GW2RADIAL_HAVE_SIMPLEINI
+#include <SimpleIni.h>
+#endif
+
+namespace GW2Radial
+{
+namespace
+{
+// A configuration of 500 options by default in INI form, standing in for GW2Common's CSimpleIni serialization
+class FakeConfig
+{
+public:
+    static constexpr uint32_t DefaultOptions = 500;
+
+    explicit FakeConfig(uint32_t options = DefaultOptions)
+        : values_(options, "0")
+    {
+    }
+
+    [[nodiscard]] static std::string Section(uint32_t option)
+    {
+        return "Section" + std::to_string(option / 25);
+    }
+
+    [[nodiscard]] static std::string Key(uint32_t option)
+    {
+        return "option_" + std::to_string(option);
+    }
+
+    [[nodiscard]] uint32_t options() const
+    {
+        return uint32_t(values_.size());
+    }
+
+    void Change()
+    {
+        values_[0] = std::to_string(edits_++);
+    }
+
+    [[nodiscard]] std::string Serialize() const
+    {
+        std::string text;
+        for (uint32_t i = 0; i < options(); i++)
+        {
+            if (i % 25 == 0)
+                text.append("[").append(Section(i)).append("]\n");
+            text += Key(i) + " = " + values_[i] + "\n";
+        }
+        return text;
+    }
+
+    [[nodiscard]] std::vector<uint8_t> Snapshot(uint64_t sourceSize) const
+    {
+        ConfigSnapshot::Writer writer;
+        for (uint32_t i = 0; i < options(); i++)
+            writer.Add(Section(i), Key(i), values_[i]);
+        return writer.Serialize(sourceSize);
+    }
+
+private:
+    std::vector<std::string> values_;
+    uint64_t                 edits_ = 0;
+};
+
+std::filesystem::path BenchmarkPath()
+{
+    return std::filesystem::temp_directory_path() / "gw2radial_config_benchmark.ini";
+}
+
+// The INI and its snapshot on disk, as a write-behind flush leaves them, removed again at the end of the benchmark
+class ConfigOnDisk
+{
+public:
+    explicit ConfigOnDisk(uint32_t options)
+        : config_(options)
+    {
+        const auto text = config_.Serialize();
+        BlobCache::Writer::WriteFile(path(), { reinterpret_cast<const uint8_t*>(text.data()), text.size() });
+        BlobCache::Writer::WriteFile(ConfigSnapshot::PathFor(path()), config_.Snapshot(text.size()));
+
+        for (uint32_t i = 0; i < options; i++)
+            keys_.emplace_back(FakeConfig::Section(i), FakeConfig::Key(i));
+    }
+
+    ~ConfigOnDisk()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path(), ec);
+        std::filesystem::remove(ConfigSnapshot::PathFor(path()), ec);
+    }
+
+    [[nodiscard]] static std::filesystem::path path()
+    {
+        return BenchmarkPath();
+    }
+
+    // Every section and key, built up front so lookups are all that is timed
+    [[nodiscard]] const std::vector<std::pair<std::string, std::string>>& keys() const
+    {
+        return keys_;
+    }
+
+private:
+    FakeConfig                                       config_;
+    std::vector<std::pair<std::string, std::string>> keys_;
+};
+
+// Render thread cost of saving one change, written out right away and through the write-behind store
+void ConfigSaveSync(benchmark::State& state)
+{
+    FakeConfig config;
+    const auto path = BenchmarkPath();
+    for (auto _ : state)
+    {
+        config.Change();
+        const auto text = config.Serialize();
+        benchmark::DoNotOptimize(BlobCache::Writer::WriteFile(path, { reinterpret_cast<const uint8_t*>(text.data()), text.size() }));
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+BENCHMARK(ConfigSaveSync);
+
+void ConfigSaveWriteBehind(benchmark::State& state)
+{
+    FakeConfig config;
+    const auto path = BenchmarkPath();
+    {
+        ConfigWriteBehind store(path, [&]() -> std::optional<std::string> { return config.Serialize(); });
+        for (auto _ : state)
+        {
+            config.Change();
+            store.MarkDirty("Section0");
+            store.Update();
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+BENCHMARK(ConfigSaveWriteBehind);
+
+// Startup cost of loading every option, parsing the INI as GW2Common does against mapping the snapshot
+#ifdef GW2RADIAL_HAVE_SIMPLEINI
+void ConfigLoadIni(benchmark::State& state)
+{
+    const ConfigOnDisk disk(uint32_t(state.range(0)));
+    for (auto _ : state)
+    {
+        std::ifstream     file(disk.path(), std::ios::binary);
+        const std::string text(std::istreambuf_iterator<char>(file), {});
+        CSimpleIniA       ini(true);
+        ini.LoadData(text.data(), text.size());
+        for (const auto& [section, key] : disk.keys())
+            benchmark::DoNotOptimize(ini.GetValue(section.c_str(), key.c_str(), ""));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ConfigLoadIni)->Arg(1000)->Unit(benchmark::kMicrosecond);
+#endif
+
+void ConfigLoadSnapshot(benchmark::State& state)
+{
+    const ConfigOnDisk disk(uint32_t(state.range(0)));
+    for (auto _ : state)
+    {
+        const BlobCache::MappedFile file(ConfigSnapshot::PathFor(disk.path()));
+        ConfigSnapshot::Reader      snapshot;
+        if (!snapshot.Open(file.data(), std::filesystem::file_size(disk.path())))
+        {
+            state.SkipWithError("Snapshot did not validate");
+            break;
+        }
+        for (const auto& [section, key] : disk.keys())
+            benchmark::DoNotOptimize(snapshot.Find(section, key));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ConfigLoadSnapshot)->Arg(1000)->Unit(benchmark::kMicrosecond);
+} // namespace
+} // namespace GW2Radial
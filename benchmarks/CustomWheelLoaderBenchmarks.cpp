@@ -0,0 +1,127 @@
+#include <CustomWheelLoader.h>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace GW2Radial
+{
+namespace
+{
+constexpr size_t        WheelCount   = 20;
+constexpr size_t        ElementCount = 6;
+constexpr std::uint32_t IconEdge     = 128;
+
+// Twenty wheels of six raw 128x128 RGBA icons each in a temporary folder, written once and removed at exit
+class WheelFolder
+{
+public:
+    WheelFolder()
+        : root_(std::filesystem::temp_directory_path() / "gw2radial_wheel_benchmark")
+    {
+        std::filesystem::remove_all(root_);
+        std::mt19937      rng(42);
+        std::vector<char> icon(IconEdge * IconEdge * 4);
+        for (size_t w = 0; w < WheelCount; w++)
+        {
+            const auto folder = root_ / ("wheel" + std::to_string(w));
+            std::filesystem::create_directories(folder);
+
+            std::string config = "[General]\nnickname = wheel" + std::to_string(w) + "\ndisplay_name = Wheel " + std::to_string(w) + "\n";
+            for (size_t e = 0; e < ElementCount; e++)
+            {
+                const auto name = "element" + std::to_string(e);
+                config += "[" + name + "]\ncolor = 255, 128, 0\nicon = " + name + ".raw\n";
+                for (auto& b : icon)
+                    b = char(rng());
+                std::ofstream(folder / (name + ".raw"), std::ios::binary).write(icon.data(), std::streamsize(icon.size()));
+            }
+            std::ofstream(folder / "config.ini", std::ios::binary) << config;
+        }
+    }
+
+    ~WheelFolder()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(root_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& root() const
+    {
+        return root_;
+    }
+
+private:
+    std::filesystem::path root_;
+};
+
+const WheelFolder& Folder()
+{
+    static WheelFolder folder;
+    return folder;
+}
+
+CustomWheelFiles DiskFiles()
+{
+    return {
+        .exists     = [](const std::filesystem::path& path) { return std::filesystem::exists(path); },
+        .read       = [](const std::filesystem::path& path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), {});
+        },
+        .zipFolders = [](const std::filesystem::path&) { return std::vector<std::filesystem::path>{}; },
+    };
+}
+
+// Stands in for WIC decoding: premultiplies every pixel into a new buffer
+CustomIconData PremultiplyRaw(const std::filesystem::path&, std::span<const std::uint8_t> data, std::wstring&)
+{
+    CustomIconData icon{ IconEdge, IconEdge, std::vector<std::uint8_t>(data.size()), {} };
+    for (size_t i = 0; i + 3 < data.size(); i += 4)
+    {
+        const std::uint32_t a = data[i + 3];
+        for (size_t c = 0; c < 3; c++)
+            icon.pixels[i + c] = std::uint8_t(data[i + c] * a / 255);
+        icon.pixels[i + 3] = std::uint8_t(a);
+    }
+    return icon;
+}
+
+std::vector<CustomWheelSettings> Load(const CustomWheelLoader::ContentHashes& known)
+{
+    CustomWheelLoader loader(DiskFiles(), PremultiplyRaw);
+    loader.Start(Folder().root(), known);
+    for (;;)
+    {
+        if (auto results = loader.TakeResults())
+            return std::move(*results);
+        std::this_thread::yield();
+    }
+}
+
+// Every wheel decoded again, as before reloads compared hashes
+void ReloadAllWheels(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Load({}));
+    state.SetItemsProcessed(state.iterations() * WheelCount);
+}
+BENCHMARK(ReloadAllWheels)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Hashes from the previous load with one wheel's file changed since: everything is read and hashed, one wheel is decoded
+void ReloadOneChangedWheel(benchmark::State& state)
+{
+    CustomWheelLoader::ContentHashes known;
+    for (const auto& wheel : Load({}))
+        known[wheel.configPath] = wheel.contentHash;
+    known.begin()->second++;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Load(known));
+    state.SetItemsProcessed(state.iterations() * WheelCount);
+}
+BENCHMARK(ReloadOneChangedWheel)->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace
+} // namespace GW2Radial
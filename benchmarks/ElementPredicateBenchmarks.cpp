@@ -0,0 +1,164 @@
+#include <ElementPredicateTable.h>
+#include <WheelFavorite.h>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+// Elements spread over every visibility and usability restriction, a few of them gated, so filtering has real work to do
+std::vector<ElementConditions> MakeElements(size_t count)
+{
+    std::vector<ElementConditions> elements(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto props = ConditionalProperties(std::uint32_t(ConditionalProperties::VisibleDefault) | std::uint32_t(ConditionalProperties::UsableDefault) |
+                                                 ((std::uint32_t(i) * 0x9E3779B9u >> 8) & 0x3FC));
+        elements[i]      = { VisibleStates(props), UsableStates(props), true, {} };
+        if (i % 8 == 0)
+            elements[i].gate = { GateMode::Precheck, SlotBit(i % 64) };
+    }
+    return elements;
+}
+
+// Visibility and usability of every element for one state, evaluated element by element
+void VisibilityLoop(benchmark::State& state)
+{
+    const auto          elements = MakeElements(size_t(state.range(0)));
+    const std::uint64_t word     = ~std::uint64_t(0) >> 1;
+
+    std::uint32_t       c        = 0;
+    for (auto _ : state)
+    {
+        const auto    key   = StateKey(c++ & GameCondition::All);
+        std::uint32_t count = 0;
+        for (const auto& e : elements)
+            count += EvaluateElement(e.visibleStates, key, e.bound, e.gate.mode, e.gate.passes(word)) ||
+                     EvaluateElement(e.usableStates, key, e.bound, e.gate.mode, e.gate.passes(word));
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(VisibilityLoop)->RangeMultiplier(2)->Range(4, 128);
+
+// The same through the precomputed bitsets
+void VisibilityTable(benchmark::State& state)
+{
+    const auto            elements = MakeElements(size_t(state.range(0)));
+    const std::uint64_t   word     = ~std::uint64_t(0) >> 1;
+    ElementPredicateTable table;
+    table.Compile(elements);
+
+    std::uint32_t c = 0;
+    for (auto _ : state)
+    {
+        const auto conditions = c++ & GameCondition::All;
+        benchmark::DoNotOptimize((table.Visible(conditions, word) | table.Usable(conditions, word)).count());
+    }
+}
+BENCHMARK(VisibilityTable)->RangeMultiplier(2)->Range(4, 128);
+
+// Stands in for WheelElement in the element lists
+struct Element
+{
+    size_t index = 0;
+};
+
+// Display order as a wheel's sorted order would have it, not the order elements were added in
+std::vector<std::uint32_t> MakeOrder(size_t count)
+{
+    std::vector<std::uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::reverse(order);
+    return order;
+}
+
+// Wheel::GetFavorite: the favorite for the current conditions, if it is a bound element of the wheel
+void FavoritePick(benchmark::State& state)
+{
+    const auto            elements = MakeElements(size_t(state.range(0)));
+    const int             last     = std::min(int(elements.size()) - 1, WheelFavorite::MaxIndex);
+    ElementPredicateTable table;
+    table.Compile(elements);
+
+    WheelFavorite favorite{};
+    favorite.bits = { 0, last, last / 2, -1, 1 };
+
+    std::uint32_t c = 0;
+    for (auto _ : state)
+    {
+        const int id = favorite.Pick(c++ & GameCondition::All);
+        benchmark::DoNotOptimize(id >= 0 && id < int(elements.size()) && table.bound().test(size_t(id)) ? &elements[size_t(id)] : nullptr);
+    }
+}
+BENCHMARK(FavoritePick)->RangeMultiplier(2)->Range(4, 128);
+
+// Wheel::ShouldSkip: whether exactly one element is usable, and which
+void SkipSingleUsable(benchmark::State& state)
+{
+    const auto            elements = MakeElements(size_t(state.range(0)));
+    const std::uint64_t   word     = ~std::uint64_t(0) >> 1;
+    ElementPredicateTable table;
+    table.Compile(elements);
+
+    std::uint32_t c = 0;
+    for (auto _ : state)
+    {
+        const auto usable = table.Usable(c++ & GameCondition::All, word);
+        benchmark::DoNotOptimize(usable.count() == 1 ? ElementPredicateTable::FirstSet(usable) : elements.size());
+    }
+}
+BENCHMARK(SkipSingleUsable)->RangeMultiplier(2)->Range(4, 128);
+
+// Wheel::GetVisibleElements and GetUsableElements: the selected elements in display order, collected into a new list per call
+void ElementsCollect(benchmark::State& state)
+{
+    const auto            elements = MakeElements(size_t(state.range(0)));
+    const auto            order    = MakeOrder(elements.size());
+    const std::uint64_t   word     = ~std::uint64_t(0) >> 1;
+    std::vector<Element>  items(elements.size());
+    ElementPredicateTable table;
+    table.Compile(elements);
+
+    std::uint32_t c = 0;
+    for (auto _ : state)
+    {
+        const auto            conditions = c++ & GameCondition::All;
+        const auto            mask       = state.range(1) ? table.Usable(conditions, word) : table.Visible(conditions, word);
+        std::vector<Element*> selected;
+        selected.reserve(mask.count());
+        for (std::uint32_t index : order)
+            if (mask.test(index))
+                selected.push_back(&items[index]);
+        benchmark::DoNotOptimize(selected.data());
+    }
+}
+BENCHMARK(ElementsCollect)->ArgNames({ "elements", "usable" })->ArgsProduct({ benchmark::CreateRange(4, 128, 2), { 0, 1 } });
+
+// The same through ElementSetCache, as the render and hover paths query it: refilled only when the conditions change, which
+// here happens every changeEvery calls
+void ElementsCached(benchmark::State& state)
+{
+    const auto               elements = MakeElements(size_t(state.range(0)));
+    const auto               order    = MakeOrder(elements.size());
+    const std::uint64_t      word     = ~std::uint64_t(0) >> 1;
+    const std::uint32_t      every    = std::uint32_t(state.range(1));
+    std::vector<Element>     items(elements.size());
+    ElementPredicateTable    table;
+    ElementSetCache<Element> cache;
+    table.Compile(elements);
+    cache.Reserve(items.size());
+
+    std::uint32_t c = 0;
+    for (auto _ : state)
+    {
+        const auto conditions = (c++ / every) & GameCondition::All;
+        benchmark::DoNotOptimize(cache.Get(conditions, word, order, [&] { return table.Visible(conditions, word); }, [&](std::uint32_t i) { return &items[i]; }).data());
+    }
+    state.counters["fills"] = double(cache.fillCount());
+}
+BENCHMARK(ElementsCached)->ArgNames({ "elements", "changeEvery" })->ArgsProduct({ benchmark::CreateRange(4, 128, 2), { 1, 1000 } });
+} // namespace
+} // namespace GW2Radial
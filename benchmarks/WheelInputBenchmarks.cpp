@@ -0,0 +1,142 @@
+#include <ActionQueue.h>
+#include <ElementPredicateTable.h>
+#include <HoverTracker.h>
+#include <NullPlatform.h>
+#include <WheelLayout.h>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+// The input paths of an open wheel, built from the same modules Wheel calls into. Wheel itself still needs GW2Common and D3D11,
+// so its options, logging and Core lookups are left out.
+constexpr float        DeadZoneSq  = 0.01f * 0.01f;
+constexpr std::int64_t FlickWindow = 60;
+
+// Every element visible and usable in every state, so the sector count is the element count
+std::vector<ElementConditions> MakeElements(size_t count)
+{
+    const auto                     props = ConditionalProperties(std::uint32_t(ConditionalProperties::VisibleAll) | std::uint32_t(ConditionalProperties::UsableAll));
+    std::vector<ElementConditions> elements(count, { VisibleStates(props), UsableStates(props), true, {} });
+    return elements;
+}
+
+// Cursor offsets circling the ring a degree per move, outside the dead zone
+std::array<glm::vec2, 360> MakeTrajectory()
+{
+    std::array<glm::vec2, 360> offsets;
+    for (size_t i = 0; i < offsets.size(); i++)
+        offsets[i] = glm::vec2(std::sin(float(i) * 0.0174533f), -std::cos(float(i) * 0.0174533f)) * 0.05f;
+    return offsets;
+}
+
+// Wheel::UpdateHover on every mouse move: record the sample, resolve its sector and notice a change of hovered element
+void UpdateHover(benchmark::State& state)
+{
+    const auto   offsets = MakeTrajectory();
+    HoverTracker tracker;
+    SectorTable  sectors;
+    sectors.BuildUniform(size_t(state.range(0)));
+
+    std::int64_t time    = 0;
+    size_t       hovered = 0, changes = 0;
+    for (auto _ : state)
+    {
+        time++;
+        tracker.Push(time, offsets[size_t(time) % offsets.size()]);
+        const auto offset = *tracker.latest();
+        const auto sector = glm::dot(offset, offset) <= DeadZoneSq ? sectors.sectorCount() : sectors.Resolve(offset);
+        changes += sector != hovered;
+        hovered = sector;
+    }
+    state.counters["changes"] = double(changes);
+}
+BENCHMARK(UpdateHover)->RangeMultiplier(2)->Range(4, 128);
+
+// Wheel::KeybindEvent opening the wheel: the skip check, whether anything can be shown, and the first hover sample
+void KeybindActivate(benchmark::State& state)
+{
+    const auto            elements = MakeElements(size_t(state.range(0)));
+    const auto            offsets  = MakeTrajectory();
+    const std::uint64_t   word     = 0;
+    ElementPredicateTable table;
+    HoverTracker          tracker;
+    SectorTable           sectors;
+    table.Compile(elements);
+    sectors.BuildUniform(elements.size());
+
+    std::uint32_t c = 0;
+    for (auto _ : state)
+    {
+        const auto conditions = c++ & GameCondition::All;
+        const auto usable     = table.Usable(conditions, word);
+        if (usable.count() == 1)
+            benchmark::DoNotOptimize(ElementPredicateTable::FirstSet(usable));
+        benchmark::DoNotOptimize((usable | table.Visible(conditions, word)).any());
+
+        tracker.Reset();
+        tracker.Push(c, offsets[c % offsets.size()]);
+        benchmark::DoNotOptimize(sectors.Resolve(*tracker.latest()));
+    }
+}
+BENCHMARK(KeybindActivate)->RangeMultiplier(2)->Range(4, 128);
+
+// Wheel::DeactivateWheel into SendKeybindOrDelay: the selection from the release trajectory, the usability check, and the
+// keybind queued and sent through the action queue against the headless platform
+void DeactivateSend(benchmark::State& state)
+{
+    const auto            elements = MakeElements(size_t(state.range(0)));
+    const auto            offsets  = MakeTrajectory();
+    const std::uint64_t   word     = 0;
+    ElementPredicateTable table;
+    HoverTracker          tracker;
+    SectorTable           sectors;
+    ActionQueue           queue;
+    NullPlatform          platform;
+    const Platform        previous = CurrentPlatform();
+    table.Compile(elements);
+    sectors.BuildUniform(elements.size());
+    SetCurrentPlatform(platform.platform());
+
+    std::int64_t now  = 0;
+    size_t       sent = 0;
+    for (auto _ : state)
+    {
+        // A short drag out of the center, released after springing back within the flick window
+        tracker.Reset();
+        tracker.Push(now, {});
+        tracker.Push(now + 10, offsets[size_t(now) % offsets.size()]);
+        tracker.Push(now + 20, {});
+        now += 30;
+
+        const auto offset  = tracker.ReleaseOffset(now, DeadZoneSq, FlickWindow);
+        const auto element = offset ? sectors.Resolve(*offset) : 0;
+        const bool usable  = table.Usable(GameCondition::None, word).test(element);
+
+        ActionQueue::Request request;
+        request.notBefore = now;
+        request.expiry    = now + 5000;
+        request.ready     = [usable] { return usable; };
+        request.send      = [element]
+        {
+            CurrentPlatform().input->SendKeybind({ std::uint32_t(element), 0 }, std::nullopt);
+            return false;
+        };
+        queue.Push(std::move(request), now);
+        queue.Update(now, false);
+
+        sent += platform.sentKeybinds.size();
+        platform.sentKeybinds.clear();
+    }
+    state.counters["sent"] = double(sent);
+
+    if (previous.clock)
+        SetCurrentPlatform(previous);
+}
+BENCHMARK(DeactivateSend)->RangeMultiplier(2)->Range(4, 128);
+} // namespace
+} // namespace GW2Radial
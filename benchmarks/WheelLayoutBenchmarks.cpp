@@ -0,0 +1,52 @@
+#include <WheelLayout.h>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <numbers>
+
+namespace GW2Radial
+{
+namespace
+{
+// Cursor offsets all around the ring, one per degree
+std::array<glm::vec2, 360> MakeDirections()
+{
+    std::array<glm::vec2, 360> directions;
+    for (size_t i = 0; i < directions.size(); i++)
+        directions[i] = glm::vec2(std::cos(float(i) * 0.0174533f), std::sin(float(i) * 0.0174533f)) * 0.2f;
+    return directions;
+}
+
+void SectorTableResolve(benchmark::State& state)
+{
+    const auto  directions = MakeDirections();
+    SectorTable sectors;
+    sectors.BuildUniform(size_t(state.range(0)));
+
+    size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sectors.Resolve(directions[i++ % directions.size()]));
+}
+BENCHMARK(SectorTableResolve)->RangeMultiplier(2)->Range(4, 128);
+
+// The atan2 formulation SectorTable replaced
+void SectorAtan2(benchmark::State& state)
+{
+    const auto     directions = MakeDirections();
+    const uint32_t count      = uint32_t(state.range(0));
+
+    size_t         i          = 0;
+    for (auto _ : state)
+    {
+        const auto& d          = directions[i++ % directions.size()];
+        float       mouseAngle = std::atan2(-d.y, -d.x) - 0.5f * std::numbers::pi_v<float>;
+        if (mouseAngle < 0)
+            mouseAngle += 2 * std::numbers::pi_v<float>;
+
+        const float elementAngle = 2 * std::numbers::pi_v<float> / float(count);
+        benchmark::DoNotOptimize(uint32_t((mouseAngle - elementAngle / 2) / elementAngle + 1) % count);
+    }
+}
+BENCHMARK(SectorAtan2)->RangeMultiplier(2)->Range(4, 128);
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,108 @@
+#pragma once
+#include <SpscQueue.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <condition_variable>
+#endif
+
+namespace GW2Radial
+{
+// Runs action chains on a dedicated thread that sleeps on a high resolution timer until the next step is due, so step delays
+// are kept to the millisecond instead of being rounded up to the next frame. Each step is scheduled relative to the previous
+// step's deadline rather than to when it actually ran, so lateness never accumulates along a chain. Chains are handed over
+// through a lock-free queue to the executor thread. Submit is reached both from input callbacks and from the render thread's
+// action queue, so callers are serialized by a mutex in front of the queue; the executor never takes it.
+class ActionChainExecutor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Keys are held down at least this long between their press and release steps, so the game sees them across a frame
+    static constexpr std::chrono::milliseconds KeyHold{ 20 };
+
+    struct Step
+    {
+        // Runs on the executor thread; empty for a pure delay. Returning false drops the rest of the chain.
+        std::function<bool()>     send;
+        std::chrono::microseconds delayAfter{};
+        // The next step also waits this long after this one actually ran, for gaps that must not shrink when a step runs late
+        std::chrono::microseconds minDelayAfter{};
+        // Still runs, right away, when the chain is cancelled or dropped right after the step before it, so a pressed key is never
+        // left held
+        bool                      always = false;
+    };
+
+    // Shared between the submitting thread and the executor
+    struct ChainState
+    {
+        std::atomic<bool> cancelled = false;
+        std::atomic<bool> finished  = false;
+        // A step failed to send and the rest of the chain was dropped
+        std::atomic<bool> dropped   = false;
+    };
+    using Handle = std::shared_ptr<ChainState>;
+
+    ActionChainExecutor();
+    ~ActionChainExecutor();
+    ActionChainExecutor(const ActionChainExecutor&)            = delete;
+    ActionChainExecutor& operator=(const ActionChainExecutor&) = delete;
+
+    // The first step runs at start; returns null when too many chains are waiting to be picked up
+    Handle             Submit(std::vector<Step> steps, Clock::time_point start = Clock::now());
+
+    // Steps not yet sent are dropped; the step currently being sent, if any, still completes
+    static void        Cancel(const Handle& chain)
+    {
+        if (chain)
+            chain->cancelled = true;
+    }
+
+    [[nodiscard]] static bool IsActive(const Handle& chain)
+    {
+        return chain && !chain->cancelled && !chain->finished;
+    }
+
+    // Appends a keybind as a press step and a release step KeyHold after it. The next step follows delayAfter after the press,
+    // or right after the release if that comes later.
+    static void               AppendKeybind(std::vector<Step>& steps, std::function<bool()> press, std::function<void()> release,
+                                            std::chrono::microseconds delayAfter);
+
+private:
+    struct Pending
+    {
+        Handle            state;
+        std::vector<Step> steps;
+        size_t            next = 0;
+        Clock::time_point due;
+    };
+
+    void                       Run(std::stop_token stopToken);
+    void                       WaitUntil(std::optional<Clock::time_point> due);
+    void                       Wake();
+
+    std::mutex                 submitMutex_; // serializes the producers of submissions_
+    SpscQueue<Pending, 64>     submissions_;
+    std::vector<Pending>       running_; // executor thread only
+
+#ifdef _WIN32
+    void*                      timer_     = nullptr;
+    void*                      wakeEvent_ = nullptr;
+#else
+    std::mutex                 wakeMutex_;
+    std::condition_variable    wakeCondition_;
+    bool                       wakePending_ = false;
+#endif
+
+    // Runs on submissions_, running_ and the timer/wake members above; started at the end of the constructor and joined at the
+    // start of the destructor, before the timer handles are closed
+    std::jthread               thread_;
+};
+} // namespace GW2Radial
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace GW2Radial
+{
+// Inputs waiting for the game to allow them, shared by every wheel. Entries sit in a min-heap keyed on their next deadline
+// (earliest send time, end of the send delay, or expiry), so an update only touches entries whose deadline has passed, plus
+// every entry when the caller reports that the conditions their predicates read have changed. Time is passed in by the
+// caller in milliseconds, so the scheduler runs the same against a scripted clock.
+class ActionQueue
+{
+public:
+    using Id = std::uint64_t;
+
+    enum class Outcome
+    {
+        Sent,
+        Expired,
+        Cancelled,
+    };
+
+    struct Request
+    {
+        const void*                      owner         = nullptr; // entries of one owner can be cancelled together
+        std::int64_t                     notBefore     = 0;
+        std::int64_t                     expiry        = 0;
+        // The predicate must hold continuously for this long before the entry is sent
+        std::int64_t                     sendDelay     = 0;
+        // When send asks to be retried, the entry stays queued and becomes due again this much later
+        std::int64_t                     retryInterval = 0;
+        std::function<bool()>            ready;
+        // Performs the action; returns whether the entry should be retried
+        std::function<bool()>            send;
+        // Called exactly once, when the entry leaves the queue
+        std::function<void(Id, Outcome)> finished;
+    };
+
+    Id                                        Push(Request request, std::int64_t now);
+    bool                                      Cancel(Id id);
+    void                                      CancelOwner(const void* owner);
+
+    // Runs due entries; with conditionsChanged, every entry re-evaluates its predicate
+    void                                      Update(std::int64_t now, bool conditionsChanged);
+
+    [[nodiscard]] bool                        contains(Id id) const
+    {
+        return entries_.contains(id);
+    }
+
+    [[nodiscard]] size_t                      size() const
+    {
+        return entries_.size();
+    }
+
+    [[nodiscard]] std::optional<std::int64_t> nextDeadline() const;
+
+private:
+    struct Entry
+    {
+        Request                     request;
+        std::optional<std::int64_t> passingSince;
+        std::uint64_t               generation = 0;
+    };
+
+    struct Deadline
+    {
+        std::int64_t  time;
+        Id            id;
+        std::uint64_t generation;
+
+        bool          operator>(const Deadline& o) const
+        {
+            return time != o.time ? time > o.time : id > o.id;
+        }
+    };
+
+    using DeadlineHeap = std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>>;
+
+    void                          Schedule(Id id, Entry& entry, std::int64_t time);
+    void                          Wake(Id id, std::int64_t now);
+    void                          Finish(Id id, Outcome outcome);
+
+    std::unordered_map<Id, Entry> entries_;
+    mutable DeadlineHeap          deadlines_;
+    Id                            nextId_ = 1;
+};
+} // namespace GW2Radial
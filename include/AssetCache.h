@@ -0,0 +1,74 @@
+#pragma once
+#include <AtlasPacker.h>
+#include <BlobCache.h>
+#include <ConfigWriteBehind.h>
+#include <Main.h>
+#include <imgui.h>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace GW2Radial
+{
+// Keeps decoded icons and baked labels across sessions in a single memory-mapped file, so startup does not have to decode or rasterize them again.
+// Lookups are thread-safe; readbacks and flushing must happen on the render thread. The file is written behind the render thread,
+// once the cache has been idle for a while.
+class AssetCache
+{
+public:
+    // Changes are written out once the cache has been idle for this long
+    static constexpr std::chrono::milliseconds FlushDelay{ 1000 };
+
+    struct Image
+    {
+        u32             width  = 0;
+        u32             height = 0;
+        std::vector<u8> pixels;
+    };
+
+    // An empty path disables the cache entirely
+    explicit AssetCache(std::filesystem::path path);
+    ~AssetCache();
+
+    std::optional<Image> Find(u64 key);
+    void                 Store(u64 key, u32 width, u32 height, std::vector<u8> pixels);
+
+    // Copies a region of a render target to the CPU and stores it once the GPU is done with it
+    void                 QueueReadback(ID3D11DeviceContext* ctx, ID3D11Texture2D* source, const AtlasRect& rect, u64 key);
+
+    void                 Update(ID3D11DeviceContext* ctx);
+    void                 Flush();
+
+    static u64           LabelKey(ImFont* font, float fontSize, const std::string& text, u32 width, u32 height, u32 style);
+    static u64           ContentKey(std::span<const u8> data);
+
+private:
+    struct Readback
+    {
+        ComPtr<ID3D11Texture2D> staging;
+        u32                     width;
+        u32                     height;
+        u64                     key;
+    };
+
+    void                                 Open();
+    // Called by writer_ with mutex_ held
+    std::optional<std::string>           Serialize();
+
+    std::filesystem::path                path_;
+    std::optional<BlobCache::MappedFile> file_;
+    BlobCache::Reader                    reader_;
+
+    // Only entries looked up or stored this session are kept when the file is rewritten
+    std::set<u64>                        used_;
+    std::map<u64, Image>                 stored_;
+    std::vector<Readback>                readbacks_;
+    // Once written, lookups are served from the serialized contents instead of the mapping
+    std::vector<u8>                      contents_;
+    bool                                 failureLogged_ = false;
+    std::mutex                           mutex_;
+
+    // Last, so it is stopped before anything its serializer uses
+    ConfigWriteBehind                    writer_;
+};
+} // namespace GW2Radial
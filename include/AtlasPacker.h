@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace GW2Radial
+{
+struct AtlasSize
+{
+    uint32_t width  = 0;
+    uint32_t height = 0;
+};
+
+struct AtlasRect
+{
+    uint32_t x      = 0;
+    uint32_t y      = 0;
+    uint32_t width  = 0;
+    uint32_t height = 0;
+};
+
+struct AtlasPlacement
+{
+    uint32_t  page = 0;
+    AtlasRect rect;
+};
+
+// Skyline bottom-left rectangle packer for a single page, independent of any rendering backend. With an alignment, every
+// rectangle gets a cell of its own whose origin and size are multiples of it, so downsampling by up to that factor never mixes
+// two rectangles.
+class AtlasPacker
+{
+public:
+    AtlasPacker(uint32_t width, uint32_t height, uint32_t padding = 0, uint32_t alignment = 1);
+
+    // Reserves a rectangle surrounded by padding on every side, returning the unpadded rectangle on success
+    std::optional<AtlasRect> Insert(uint32_t width, uint32_t height);
+    void                     Reset();
+
+    // The cell reserved for a rectangle Insert returned: the rectangle, its padding and whatever aligning it took
+    [[nodiscard]] AtlasRect  Cell(const AtlasRect& rect) const;
+
+    [[nodiscard]] uint32_t   width() const
+    {
+        return width_;
+    }
+    [[nodiscard]] uint32_t height() const
+    {
+        return height_;
+    }
+    [[nodiscard]] uint64_t usedArea() const
+    {
+        return usedArea_;
+    }
+    [[nodiscard]] float occupancy() const
+    {
+        return float(double(usedArea_) / (double(width_) * double(height_)));
+    }
+
+private:
+    struct SkylineNode
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    std::optional<uint32_t>  Fit(size_t index, uint32_t width, uint32_t height) const;
+
+    [[nodiscard]] uint32_t   Align(uint32_t size) const
+    {
+        return (size + alignment_ - 1) / alignment_ * alignment_;
+    }
+
+    uint32_t                 width_;
+    uint32_t                 height_;
+    uint32_t                 padding_;
+    uint32_t                 alignment_;
+    uint64_t                 usedArea_ = 0;
+    std::vector<SkylineNode> skyline_;
+};
+
+// Packs every size into as few pages as possible, tallest first; sizes which cannot fit an empty page are left unplaced
+std::vector<std::optional<AtlasPlacement>> PackIntoPages(std::span<const AtlasSize> sizes, uint32_t pageWidth, uint32_t pageHeight, uint32_t padding,
+                                                         uint32_t alignment = 1);
+} // namespace GW2Radial
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace GW2Radial
+{
+// Versioned binary container of pixel blobs keyed by 64-bit hashes, independent of any rendering backend.
+// Layout: header, blobs aligned to 16 bytes, then a table of records sorted by key. The table and every blob carry an XXH3 checksum.
+namespace BlobCache
+{
+inline constexpr uint32_t Magic   = 0x43523257; // "W2RC"
+inline constexpr uint32_t Version = 1;
+
+enum class Format : uint32_t
+{
+    RGBA8 = 0,
+};
+
+struct Blob
+{
+    uint64_t                 key    = 0;
+    uint32_t                 width  = 0;
+    uint32_t                 height = 0;
+    Format                   format = Format::RGBA8;
+    std::span<const uint8_t> data;
+};
+
+class Reader
+{
+public:
+    // Returns false, leaving the reader empty, if the header, version or table do not validate
+    bool                                Open(std::span<const uint8_t> file);
+    void                                Close();
+
+    // Blobs failing their checksum are reported as missing
+    [[nodiscard]] std::optional<Blob>   Find(uint64_t key) const;
+    [[nodiscard]] std::vector<uint64_t> keys() const;
+    [[nodiscard]] size_t                size() const
+    {
+        return records_.size();
+    }
+
+private:
+    struct Record
+    {
+        uint64_t key;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t checksum;
+        uint32_t width;
+        uint32_t height;
+        uint32_t format;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Record) == 48);
+
+    std::span<const uint8_t> file_;
+    std::vector<Record>      records_;
+
+    friend class Writer;
+};
+
+class Writer
+{
+public:
+    // Later additions with the same key replace earlier ones
+    void                                        Add(uint64_t key, uint32_t width, uint32_t height, Format format, std::span<const uint8_t> data);
+    [[nodiscard]] std::vector<uint8_t>          Serialize() const;
+
+    // Writes and flushes a temporary file, then renames it over the target, so a crash never leaves a truncated cache behind
+    static bool                                 WriteFile(const std::filesystem::path& path, std::span<const uint8_t> bytes);
+
+    // The two halves of WriteFile, for callers that must decide on the rename separately. Returns the temporary file's path.
+    static std::optional<std::filesystem::path> WriteTemporary(const std::filesystem::path& path, std::span<const uint8_t> bytes);
+    // Renames the temporary file over path, or removes it if that fails
+    static bool                                 ReplaceWithTemporary(const std::filesystem::path& path, const std::filesystem::path& tempPath);
+
+private:
+    struct Pending
+    {
+        uint64_t             key;
+        uint32_t             width;
+        uint32_t             height;
+        Format               format;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Pending> blobs_;
+};
+
+// Read-only view of a whole file, memory-mapped where the platform allows it
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    void        Close();
+
+    [[nodiscard]] std::span<const uint8_t> data() const
+    {
+        return { data_, size_ };
+    }
+
+private:
+    const uint8_t*       data_ = nullptr;
+    size_t               size_ = 0;
+#ifdef _WIN32
+    void*                file_    = nullptr;
+    void*                mapping_ = nullptr;
+#else
+    std::vector<uint8_t> buffer_;
+#endif
+};
+} // namespace BlobCache
+} // namespace GW2Radial
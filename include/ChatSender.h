@@ -0,0 +1,227 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace GW2Radial
+{
+// Types chat messages into the game one at a time: release held movement keys, open chat, type, submit, then press the held
+// keys again. Each stage runs when its deadline passes, and the next message only starts once the previous one is done, so
+// keystrokes from two messages can never interleave. Typing starts as soon as the sink reports the chat box open and held keys
+// are restored as soon as it reports it closed, the timing values only bound how long to wait for that feedback. Time is
+// passed in by the caller and the game is only reached through the sink, so the sequence runs the same against a fake sink,
+// a simulated chat box and a scripted clock.
+class ChatSender
+{
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+
+    struct Message
+    {
+        std::wstring text;
+        bool         broadcast = false; // squad broadcast opens with Shift+Enter
+
+        bool         operator==(const Message&) const = default;
+    };
+
+    // Inputs held down when a message starts, released while typing so the game does not see them stuck
+    struct HeldInputs
+    {
+        bool w = false, a = false, s = false, d = false;
+        bool leftMouse = false, rightMouse = false;
+    };
+
+    class Sink
+    {
+    public:
+        virtual ~Sink()                                                  = default;
+
+        [[nodiscard]] virtual bool       chatOpen()                      = 0;
+        [[nodiscard]] virtual HeldInputs CaptureHeld()                   = 0;
+        virtual void                     Release(const HeldInputs& held) = 0;
+        virtual void                     OpenChat(bool broadcast)        = 0;
+        virtual void                     Type(const std::wstring& text)  = 0;
+        virtual void                     Submit()                        = 0;
+        virtual void                     Restore(const HeldInputs& held) = 0;
+    };
+
+    struct Timing
+    {
+        std::chrono::milliseconds beforeOpen{ 15 };
+        std::chrono::milliseconds beforeSubmit{ 50 };
+        // Upper bounds on waiting for the chat box to open after opening it and to close after submitting
+        std::chrono::milliseconds openChat{ 50 };
+        std::chrono::milliseconds openBroadcast{ 80 };
+        std::chrono::milliseconds restoreChat{ 60 };
+        std::chrono::milliseconds restoreBroadcast{ 40 };
+        // How often the sink is asked for feedback while waiting
+        std::chrono::milliseconds poll{ 1 };
+    };
+
+    // The stages that wait on chat box feedback
+    enum class FeedbackStep
+    {
+        OpenChat,
+        OpenBroadcast,
+        CloseChat,
+        CloseBroadcast,
+        Count
+    };
+
+    // Recent latencies of one feedback step. Once enough are known, the wait bound shrinks to twice the slowest recent one; a
+    // timeout is recorded at the bound it ran into, so missing feedback doubles the bound back up towards the configured one.
+    class StepLatency
+    {
+    public:
+        static constexpr size_t   Window     = 32;
+        static constexpr size_t   MinSamples = 8;
+        static constexpr Duration MinBound   = std::chrono::milliseconds(10);
+
+        void                        Record(Duration latency, bool timedOut);
+        [[nodiscard]] Duration      Bound(Duration configured) const;
+
+        [[nodiscard]] size_t        count() const
+        {
+            return count_;
+        }
+
+        [[nodiscard]] Duration      mean() const;
+        [[nodiscard]] Duration      max() const;
+
+        [[nodiscard]] std::uint32_t timeouts() const
+        {
+            return timeouts_;
+        }
+
+    private:
+        std::array<Duration, Window> samples_{};
+        size_t                       head_     = 0;
+        size_t                       count_    = 0;
+        std::uint32_t                timeouts_ = 0;
+    };
+    using Latencies = std::array<StepLatency, size_t(FeedbackStep::Count)>;
+
+    static constexpr size_t Capacity = 8;
+
+    explicit ChatSender(Sink& sink);
+    ChatSender(Sink& sink, Timing timing);
+
+    // Returns false when the message was dropped, either because the queue is full or because the same message is already waiting
+    bool                             Enqueue(Message message);
+
+    // Drops every waiting message and abandons the current one without restoring held inputs, for when the game loses focus.
+    // Enqueue and Cancel may also be called from within sink calls, the current message then stops at the call it was in.
+    void                             Cancel();
+
+    // Runs every stage due by now; returns when the next stage is due, or nothing once idle. A message whose turn comes while
+    // chat is already open is skipped, typing into it would mangle whatever the player is writing.
+    std::optional<Clock::time_point> Advance(Clock::time_point now);
+
+    [[nodiscard]] bool               idle() const
+    {
+        return stage_ == Stage::Idle && pending_.empty();
+    }
+
+    [[nodiscard]] size_t             pendingCount() const
+    {
+        return pending_.size();
+    }
+
+    [[nodiscard]] const Latencies&   latencies() const
+    {
+        return latencies_;
+    }
+
+private:
+    enum class Stage
+    {
+        Idle,
+        Opening,
+        Typing,
+        Submitting,
+        Restoring,
+    };
+
+    [[nodiscard]] FeedbackStep    CurrentFeedbackStep() const;
+    [[nodiscard]] Duration        FeedbackBound(FeedbackStep step) const;
+
+    Sink&                         sink_;
+    Timing                        timing_;
+    std::deque<Message>           pending_;
+    Message                       current_;
+    HeldInputs                    held_;
+    Stage                         stage_ = Stage::Idle;
+    Clock::time_point             due_;
+    Clock::time_point             waitStart_;
+    Latencies                     latencies_;
+    std::uint64_t                 cancels_ = 0;
+};
+
+// Owns a ChatSender and runs it on one long-lived thread, so callers only hand messages over and never wait on the game.
+// The sender's state is guarded by a mutex that is released around every sink call, so a slow SendInput never blocks them.
+class ChatSendWorker
+{
+public:
+    explicit ChatSendWorker(ChatSender::Sink& sink, ChatSender::Timing timing);
+
+    bool                        Enqueue(ChatSender::Message message);
+    void                        Cancel();
+    ChatSender::Latencies       latencies();
+
+private:
+    // Forwards to the real sink with the worker's mutex released, which the sender's thread holds whenever it calls in
+    class UnlockedSink : public ChatSender::Sink
+    {
+    public:
+        UnlockedSink(ChatSender::Sink& sink, std::mutex& mutex);
+
+        [[nodiscard]] bool                   chatOpen() override;
+        [[nodiscard]] ChatSender::HeldInputs CaptureHeld() override;
+        void                                 Release(const ChatSender::HeldInputs& held) override;
+        void                                 OpenChat(bool broadcast) override;
+        void                                 Type(const std::wstring& text) override;
+        void                                 Submit() override;
+        void                                 Restore(const ChatSender::HeldInputs& held) override;
+
+    private:
+        template <typename F>
+        auto Unlocked(F&& f)
+        {
+            struct Relock
+            {
+                std::mutex& mutex;
+                ~Relock()
+                {
+                    mutex.lock();
+                }
+            };
+
+            mutex_.unlock();
+            Relock relock{ mutex_ };
+            return f();
+        }
+
+        ChatSender::Sink& sink_;
+        std::mutex&       mutex_;
+    };
+
+    void                        Run(std::stop_token stopToken);
+
+    std::mutex                  mutex_;
+    std::condition_variable_any wake_;
+    bool                        woken_ = false;
+    UnlockedSink                unlockedSink_;
+    ChatSender                  sender_;
+
+    // Waits on wake_ and advances sender_, which calls into the game through unlockedSink_, all under mutex_. Declared after
+    // them so it starts once they are constructed and is joined before they are destroyed.
+    std::jthread                thread_;
+};
+} // namespace GW2Radial
@@ -1,4 +1,5 @@
 #pragma once
+#include <ChatSender.h>
 #include <Main.h>
 #include <Wheel.h>
 
@@ -52,6 +53,7 @@ protected:
     void DrawMenu(Keybind** currentHover) override;
     void OnUpdate() override;
     Keybind* GetKeybindFromOpt(OptKeybindWheelElement& o) override;
+    u64 PackStateWord() const override;
 
 private:
     static constexpr int NUM_COMMANDS = 8; // Number of configurable commands
@@ -62,19 +64,28 @@ private:
     // Dynamic mode fallback channel: 0=squad (/d), 2=say (/s)
     ConfigurationOption<int> dynamicFallbackChannel_;
 
-    // Text rendering for labels
-    struct LabelTexture {
-        RenderTarget rt;
+    // Long-lived worker typing queued messages into chat; the sink must outlive it
+    std::unique_ptr<ChatSender::Sink> chatSink_;
+    std::unique_ptr<ChatSendWorker> chatSender_;
+
+    // Label text as distance fields, one cell per command in a single 8-bit texture; the element shader decodes them into outlined text.
+    // Labels are rasterized on the CPU at LabelRasterScale times the cell size and downsampled into the field.
+    static constexpr u32 LabelCellSize = 128;
+    static constexpr u32 LabelColumns = 4;
+    static constexpr u32 LabelRasterScale = 2;
+    struct LabelCell {
         std::wstring text;
-        bool needsRedraw = true;
+        bool needsRedraw = true;   // stays set until the label has been uploaded, so a failed draw is retried
+        bool warnedMissingPixels = false;
     };
-    std::vector<LabelTexture> labelTextures_;
-    ComPtr<ID3D11BlendState> textBlendState_;
+    std::vector<LabelCell> labelCells_;
+    Texture2D labelAtlas_;
 
     void SendChatMessage(const std::string& message, int channel);
     void SendTextToChat(const std::string& text, bool broadcast = false);
     void UpdateElementLabel(size_t index);
     void RegenerateTexture(size_t index, ID3D11DeviceContext* ctx);
+    AtlasRect LabelCellRect(size_t index) const;
     int DetermineActualChannel(int configuredChannel) const;
 
     static glm::vec4 GetCommandColor(int index);
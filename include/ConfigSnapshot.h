@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GW2Radial
+{
+// Versioned binary copy of every value in the configuration INI, so startup can look values up in a memory-mapped file
+// instead of parsing text. Layout: header, string pool, then a table of records sorted by the hash of section and key.
+// The header records the size of the INI it was taken from, and the pool and table are covered by one XXH3 checksum.
+namespace ConfigSnapshot
+{
+inline constexpr uint32_t Magic   = 0x53523257; // "W2RS"
+inline constexpr uint32_t Version = 1;
+
+// Where the snapshot of a given INI lives
+std::filesystem::path     PathFor(const std::filesystem::path& ini);
+
+// Whether the snapshot was written no earlier than the INI; an INI edited by hand or saved by anything else is newer and wins
+bool                      IsCurrent(const std::filesystem::path& ini);
+
+class Reader
+{
+public:
+    // Returns false, leaving the reader empty, if the header, version or checksum do not validate, or if the snapshot was taken
+    // from an INI of a different size than sourceSize
+    bool                                     Open(std::span<const uint8_t> file, uint64_t sourceSize);
+    void                                     Close();
+
+    [[nodiscard]] std::optional<std::string_view> Find(std::string_view section, std::string_view key) const;
+
+    [[nodiscard]] size_t                     size() const
+    {
+        return records_.size();
+    }
+
+private:
+    struct Record
+    {
+        uint64_t hash;
+        uint32_t keyOffset; // section, a null separator, then the key
+        uint32_t keyLength;
+        uint32_t valueOffset;
+        uint32_t valueLength;
+    };
+    static_assert(sizeof(Record) == 24);
+
+    std::span<const uint8_t> file_;
+    std::vector<Record>      records_;
+
+    friend class Writer;
+};
+
+class Writer
+{
+public:
+    // Later additions with the same section and key replace earlier ones
+    void                               Add(std::string_view section, std::string_view key, std::string_view value);
+    [[nodiscard]] std::vector<uint8_t> Serialize(uint64_t sourceSize) const;
+
+private:
+    struct Pending
+    {
+        uint64_t    hash;
+        std::string key;
+        std::string value;
+    };
+    std::vector<Pending> entries_;
+};
+
+// Adds every value of a CSimpleIni instance, templated so this header does not depend on SimpleIni
+template<typename Ini>
+void AddAll(Writer& writer, const Ini& ini)
+{
+    typename Ini::TNamesDepend sections, keys;
+    ini.GetAllSections(sections);
+    for (const auto& section : sections)
+    {
+        ini.GetAllKeys(section.pItem, keys);
+        for (const auto& key : keys)
+            writer.Add(section.pItem, key.pItem, ini.GetValue(section.pItem, key.pItem, ""));
+    }
+}
+} // namespace ConfigSnapshot
+} // namespace GW2Radial
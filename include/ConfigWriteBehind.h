@@ -0,0 +1,139 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace GW2Radial
+{
+// Writes a configuration file behind the render thread. Changes only mark their section dirty; once no change has come in for
+// the idle interval, the file is serialized on the owning thread and handed to a background thread to write, so a burst of
+// changes such as typing into a text field costs a single write. Newer contents replace any still waiting to be written.
+// Files go through a temporary next to them and a rename, so a crash mid-write leaves the previous file intact.
+//
+// Others may save the same file synchronously on the owning thread, as GW2Common's INIConfigurationFile::Save does. Only the
+// temporary is written in the background; the rename happens on the owning thread, so it never interleaves with such a save.
+// Anyone else writing the file is assumed to save the same in-memory configuration, so once the file has changed since the
+// contents were taken, they are stale and dropped instead of replacing newer ones.
+//
+// A snapshotter, if given, turns the same contents into a binary snapshot (see ConfigSnapshot) that is written and put in place
+// right after the file, so it is never older than the file it was taken from.
+class ConfigWriteBehind
+{
+public:
+    using Clock       = std::chrono::steady_clock;
+    // Returns the whole file, or nothing if it could not be serialized; only ever called on the owning thread
+    using Serializer  = std::function<std::optional<std::string>()>;
+    // Returns the snapshot of a serialized file, or an empty one to skip it; only ever called on the owning thread
+    using Snapshotter = std::function<std::vector<std::uint8_t>(const std::string& contents)>;
+
+    static constexpr std::chrono::milliseconds DefaultIdle{ 500 };
+
+    // An empty path disables writing, changes then stay in memory only
+    ConfigWriteBehind(std::filesystem::path path, Serializer serialize, Snapshotter snapshot = {});
+    ConfigWriteBehind(std::filesystem::path path, Serializer serialize, std::chrono::milliseconds idle, Snapshotter snapshot = {});
+    // Writes whatever is still dirty before returning
+    ~ConfigWriteBehind();
+    ConfigWriteBehind(const ConfigWriteBehind&)            = delete;
+    ConfigWriteBehind& operator=(const ConfigWriteBehind&) = delete;
+
+    void                    MarkDirty(std::string_view section, Clock::time_point now = Clock::now());
+
+    // Puts written contents in place and hands the file over once the idle interval has passed since the last change; call once
+    // per frame. A failed write marks the file dirty again, so it is retried after another idle interval.
+    void                    Update(Clock::time_point now = Clock::now());
+
+    // Hands over anything dirty right away and waits until it is on disk; returns false if the last write failed
+    bool                    Flush();
+
+    [[nodiscard]] bool      dirty() const
+    {
+        return !dirtySections_.empty();
+    }
+
+    [[nodiscard]] const std::set<std::string, std::less<>>& dirtySections() const
+    {
+        return dirtySections_;
+    }
+
+    // Files put in place; stale contents that were dropped do not count
+    [[nodiscard]] std::uint64_t writeCount() const
+    {
+        return writeCount_;
+    }
+
+    [[nodiscard]] std::uint64_t staleCount() const
+    {
+        return staleCount_;
+    }
+
+    [[nodiscard]] bool      lastWriteFailed() const
+    {
+        return lastWriteFailed_;
+    }
+
+private:
+    // One version of the file on disk, to notice when someone else replaced it
+    struct FileStamp
+    {
+        std::filesystem::file_time_type time;
+        std::uintmax_t                  size = 0;
+
+        bool                            operator==(const FileStamp&) const = default;
+    };
+
+    struct Contents
+    {
+        std::string               bytes;
+        std::vector<std::uint8_t> snapshot; // empty to skip it
+        std::optional<FileStamp>  base;     // the file as it was when the contents were taken
+        std::uint64_t             generation = 0;
+    };
+
+    struct Written
+    {
+        std::optional<std::filesystem::path> tempPath;         // nothing if writing failed
+        std::optional<std::filesystem::path> snapshotTempPath; // nothing if skipped or writing it failed
+        std::optional<FileStamp>             base;
+        std::uint64_t                        generation = 0;
+    };
+
+    [[nodiscard]] std::optional<FileStamp> Stamp() const;
+    void                                   Submit();
+    void                                   Commit(Clock::time_point now);
+    void                                   Run(std::stop_token stopToken);
+
+    std::filesystem::path                  path_;
+    Serializer                             serialize_;
+    Snapshotter                            snapshot_;
+    std::chrono::milliseconds              idle_;
+
+    // Owning thread only
+    std::set<std::string, std::less<>>     dirtySections_;
+    Clock::time_point                      lastChange_;
+    std::uint64_t                          writeCount_      = 0;
+    std::uint64_t                          staleCount_      = 0;
+    bool                                   lastWriteFailed_ = false;
+
+    std::mutex                             mutex_;
+    std::condition_variable_any            wake_;
+    std::condition_variable_any            writtenChanged_;
+    std::optional<Contents>                pending_;
+    // Waiting for the owning thread to put it in place; the next contents are only written after that
+    std::optional<Written>                 written_;
+    std::uint64_t                          submitted_ = 0;
+    std::uint64_t                          completed_ = 0;
+
+    // Writes pending_ next to path_ and hands the result back through written_, signalling writtenChanged_; declared after the
+    // members it touches so the destructor joins it before any of them go away
+    std::jthread                           thread_;
+};
+} // namespace GW2Radial
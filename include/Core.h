@@ -1,11 +1,22 @@
 #pragma once
 
+#include <ActionChainExecutor.h>
+#include <ActionQueue.h>
+#include <AssetCache.h>
+#include <BlobCache.h>
+#include <ConfigSnapshot.h>
+#include <ConfigWriteBehind.h>
 #include <CustomWheel.h>
 #include <Defs.h>
+#include <FrameProfiler.h>
+#include <GameStateMonitor.h>
+#include <IconAtlas.h>
 #include <Main.h>
 #include <Singleton.h>
+#include <StartupProfile.h>
 #include <Wheel.h>
 #include <Win.h>
+#include <Win32Platform.h>
 #include <d3d11_1.h>
 #include <dxgi.h>
 
@@ -54,6 +65,49 @@ public:
         return vertexCB_;
     }
 
+    IconAtlas& iconAtlas()
+    {
+        return *iconAtlas_;
+    }
+
+    AssetCache& assetCache()
+    {
+        return *assetCache_;
+    }
+
+    StartupProfile& startupProfile()
+    {
+        return startupProfile_;
+    }
+
+    FrameProfiler& frameProfiler()
+    {
+        return *frameProfiler_;
+    }
+
+    ActionQueue& actionQueue()
+    {
+        return actionQueue_;
+    }
+
+    GameStateMonitor& gameStateMonitor()
+    {
+        return gameStateMonitor_;
+    }
+
+    ActionChainExecutor& actionChainExecutor()
+    {
+        return *actionChainExecutor_;
+    }
+
+    ConfigWriteBehind& configWriteBehind()
+    {
+        return *configWriteBehind_;
+    }
+
+    // Reads from the configuration snapshot while it is mapped during startup, from the INI otherwise
+    std::string ReadConfigValue(std::string_view section, std::string_view key) const;
+
 protected:
     void InnerDraw() override;
     void InnerUpdate() override;
@@ -78,16 +132,30 @@ protected:
         return L"BlueElliott/Elliotts-Radial-Menu";
     }
 
-    bool                                       forceReloadWheels_ = false;
-    u32                                        mapId_             = 0;
-    std::wstring                               characterName_;
+    bool                                       forceReloadWheels_      = false;
+    // Set when game state read by queued input predicates changes, waking every queued input instead of only those due
+    bool                                       queueConditionsChanged_ = true;
 
+    // Declared before the wheels so they outlive them, wheels unsubscribe and cancel their queued inputs on destruction
+    GameStateMonitor                           gameStateMonitor_;
+    ActionQueue                                actionQueue_;
+    Win32Platform                              platform_;
     std::vector<std::unique_ptr<Wheel>>        wheels_;
     std::unique_ptr<CustomWheelsManager>       customWheels_;
 
     std::unique_ptr<ConfigurationOption<bool>> firstMessageShown_;
 
+    StartupProfile                             startupProfile_;
+
     std::shared_ptr<Texture2D>                 bgTex_;
+    std::unique_ptr<IconAtlas>                 iconAtlas_;
+    std::unique_ptr<AssetCache>                assetCache_;
+    std::unique_ptr<FrameProfiler>             frameProfiler_;
+    std::unique_ptr<ActionChainExecutor>       actionChainExecutor_;
+    std::unique_ptr<ConfigWriteBehind>         configWriteBehind_;
+    // Only mapped until the wheels are constructed, so the writer can replace the file afterwards
+    std::unique_ptr<BlobCache::MappedFile>     configSnapshotFile_;
+    ConfigSnapshot::Reader                     configSnapshot_;
     ConstantBufferSPtr<VertexCB>               vertexCB_;
 
     std::unique_ptr<std::jthread>              comThread_;
@@ -1,6 +1,9 @@
 ﻿#pragma once
 
+#include <CustomWheelLoader.h>
+#include <LabelBaker.h>
 #include <Main.h>
+#include <StartupProfile.h>
 #include <Wheel.h>
 #include <filesystem>
 
@@ -8,28 +11,32 @@ namespace GW2Radial
 {
 class CustomWheelsManager
 {
+    struct LoadedWheel
+    {
+        std::filesystem::path                configPath;
+        u64                                  contentHash;
+        u32                                  baseId;
+        Wheel*                               wheel;
+        std::vector<LabelBaker::LabelHandle> labels;
+    };
+
     std::vector<std::unique_ptr<Wheel>>& wheels_;
-    std::vector<Wheel*>                  customWheels_;
+    std::vector<LoadedWheel>             customWheels_;
     std::vector<std::wstring>            failedLoads_;
     static constexpr u32                 CustomWheelStartId = 10000;
     static constexpr u32                 CustomWheelIdStep  = 1000;
-    u32                                  customWheelNextId_ = CustomWheelStartId;
+    static constexpr u32                 LabelWidth         = 1020;
     ImFont*                              font_              = nullptr;
     bool                                 loaded_            = false;
     ComPtr<ID3D11BlendState>             textBlendState_;
     std::shared_ptr<Texture2D>           backgroundTexture_;
+    std::unique_ptr<LabelBaker>          labelBaker_;
+    CustomWheelLoader                    loader_;
+    std::optional<StartupProfile::Scope> startupLoad_;
 
-    std::unique_ptr<Wheel>               BuildWheel(const std::filesystem::path& configPath);
-
-    struct QueuedTextDraw
-    {
-        float        size;
-        std::wstring text;
-        RenderTarget rt;
-    };
-    std::list<QueuedTextDraw> textDraws_;
-
-    void                      Reload();
+    std::unique_ptr<Wheel>               BuildWheel(CustomWheelSettings& settings, u32 baseId, std::vector<LabelBaker::LabelHandle>& labels);
+    void                                 Reload();
+    void                                 ApplyReload(std::vector<CustomWheelSettings> wheels);
 
 public:
     CustomWheelsManager(std::shared_ptr<Texture2D> bgTexture, std::vector<std::unique_ptr<Wheel>>& wheels, ImFont* font);
@@ -42,21 +49,6 @@ public:
     }
 };
 
-struct CustomElementSettings
-{
-    u32                   id;
-    std::string           nickname;
-    std::string           category;
-    std::string           name;
-    glm::vec4             color;
-    float                 shadow;
-    float                 colorize;
-    ConditionalProperties props;
-
-    RenderTarget          rt;
-    bool                  premultiply;
-};
-
 class CustomWheel : public Wheel
 {
 public:
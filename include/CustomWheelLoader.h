@@ -0,0 +1,105 @@
+#pragma once
+#include <ElementConditions.h>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <glm/vec4.hpp>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GW2Radial
+{
+// Icon decoded off the render thread, only the upload is left to do
+struct CustomIconData
+{
+    std::uint32_t             width  = 0;
+    std::uint32_t             height = 0;
+    std::vector<std::uint8_t> pixels; // Tightly packed RGBA8
+    std::vector<std::uint8_t> dds;    // DDS files are already in a GPU format and are uploaded as-is
+
+    [[nodiscard]] bool empty() const
+    {
+        return pixels.empty() && dds.empty();
+    }
+};
+
+struct CustomElementSettings
+{
+    std::string           nickname;
+    std::string           category;
+    std::string           name;
+    glm::vec4             color;
+    float                 shadow;
+    float                 colorize;
+    ConditionalProperties props;
+    bool                  premultiply;
+
+    std::filesystem::path iconPath;
+    CustomIconData        icon;
+};
+
+struct CustomWheelSettings
+{
+    std::filesystem::path              configPath;
+    std::string                        nickname;
+    std::string                        displayName;
+    std::vector<CustomElementSettings> elements;
+
+    // Hash of the config file and every icon it references; when it matches the previous load, icons are not decoded
+    std::uint64_t                      contentHash = 0;
+    bool                               unchanged   = false;
+
+    // A fatal error discards the whole wheel, warnings only affect individual icons
+    std::wstring                       error;
+    std::vector<std::wstring>          warnings;
+};
+
+using CustomIconDecoder = std::function<CustomIconData(const std::filesystem::path& path, std::span<const std::uint8_t> data, std::wstring& error)>;
+
+// How the loader reaches files. The add-on goes through GW2Common's FileSystem, which also sees into zip archives; every
+// function is called from worker threads.
+struct CustomWheelFiles
+{
+    std::function<bool(const std::filesystem::path& path)>                                  exists;
+    // Empty if the file is missing, unreadable or empty
+    std::function<std::vector<std::uint8_t>(const std::filesystem::path& path)>            read;
+    // The folders within a zip archive, empty for anything else
+    std::function<std::vector<std::filesystem::path>(const std::filesystem::path& archive)> zipFolders;
+};
+
+// Parses a wheel's config.ini, leaving icons undecoded
+CustomWheelSettings ParseCustomWheel(const std::filesystem::path& configPath, std::span<const std::uint8_t> source);
+
+// Finds, parses and decodes every custom wheel on a pool of worker threads; results are picked up by the render thread once complete
+class CustomWheelLoader
+{
+public:
+    using ContentHashes = std::map<std::filesystem::path, std::uint64_t>;
+
+    CustomWheelLoader(CustomWheelFiles files, CustomIconDecoder decoder)
+        : files_(std::move(files))
+        , decoder_(std::move(decoder))
+    {
+    }
+
+    // Cancels any load in progress; wheels whose content hash matches knownHashes are flagged unchanged instead of decoded
+    void                                            Start(std::filesystem::path folder, ContentHashes knownHashes = {});
+
+    std::optional<std::vector<CustomWheelSettings>> TakeResults();
+
+private:
+    void                                            Run(const std::stop_token& stopToken, const std::filesystem::path& folder, const ContentHashes& knownHashes);
+    void LoadIcons(const std::stop_token& stopToken, CustomWheelSettings& settings, const ContentHashes& knownHashes, std::span<const std::uint8_t> configSource) const;
+
+    CustomWheelFiles                                files_;
+    CustomIconDecoder                               decoder_;
+    std::mutex                                      resultsMutex_;
+    std::optional<std::vector<CustomWheelSettings>> results_;
+    std::jthread                                    thread_;
+};
+} // namespace GW2Radial
@@ -0,0 +1,51 @@
+#pragma once
+#include <FrameProfiler.h>
+#include <Main.h>
+#include <array>
+#include <d3d11.h>
+#include <vector>
+
+namespace GW2Radial
+{
+// Timestamp query based GPU timing. Queries are recycled across a small ring of frames and read back without stalling;
+// a frame is skipped when the GPU is too far behind for its queries to be free yet.
+class D3D11GpuTimer : public GpuTimerBackend
+{
+public:
+    static constexpr u32 FrameLatency = 4;
+
+    D3D11GpuTimer(ComPtr<ID3D11Device> device, ComPtr<ID3D11DeviceContext> context);
+
+    void BeginFrame() override;
+    void EndFrame() override;
+    void Begin(u32 section) override;
+    void End() override;
+    void Collect(std::vector<GpuFrameTimes>& frames) override;
+
+private:
+    struct Interval
+    {
+        u32                 section = 0;
+        ComPtr<ID3D11Query> begin;
+        ComPtr<ID3D11Query> end;
+    };
+
+    struct Frame
+    {
+        ComPtr<ID3D11Query>   disjoint;
+        std::vector<Interval> intervals;
+        u32                   used    = 0;
+        bool                  pending = false;
+    };
+
+    ComPtr<ID3D11Query>             MakeQuery(D3D11_QUERY type) const;
+
+    ComPtr<ID3D11Device>            device_;
+    ComPtr<ID3D11DeviceContext>     context_;
+    std::array<Frame, FrameLatency> frames_;
+    std::vector<u32>                open_;
+    u32                             current_   = 0;
+    u32                             oldest_    = 0;
+    bool                            recording_ = false;
+};
+} // namespace GW2Radial
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GW2Radial
+{
+// Signed distance fields of 8-bit coverage masks, independent of any rendering backend.
+// Encoding: 128 lies on the edge (coverage 50%), texels inside are brighter, and a distance of spread source pixels saturates.
+namespace DistanceField
+{
+// Distances are exact Euclidean distances between pixel centres, refined along antialiased edges by the partial coverage.
+// Each output texel averages a factor x factor block of the source, so the output is width / factor by height / factor.
+std::vector<uint8_t> Generate(std::span<const uint8_t> coverage, uint32_t width, uint32_t height, float spread, uint32_t factor = 1);
+
+// Encoded value at a signed distance in source pixels, negative inside
+[[nodiscard]] uint8_t Encode(float distance, float spread);
+} // namespace DistanceField
+} // namespace GW2Radial
@@ -0,0 +1,139 @@
+#pragma once
+#include <PlatformTypes.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace GW2Radial
+{
+enum class ConditionalProperties : std::uint32_t
+{
+    None              = 0,
+
+    VisibleDefault    = 1,
+    UsableDefault     = 2,
+
+    VisibleUnderwater = 4,
+    UsableUnderwater  = 8,
+
+    VisibleOnWater    = 16,
+    UsableOnWater     = 32,
+
+    VisibleInCombat   = 64,
+    UsableInCombat    = 128,
+
+    VisibleWvW        = 256,
+    UsableWvW         = 512,
+
+    VisibleAll        = VisibleDefault | VisibleUnderwater | VisibleOnWater | VisibleInCombat | VisibleWvW,
+    UsableAll         = UsableDefault | UsableUnderwater | UsableOnWater | UsableInCombat | UsableWvW,
+
+    IsFlag
+};
+
+// Conditions are compiled to plain masks: a game state becomes a key with one bit per condition props can restrict (or a
+// dedicated bit for the default, condition-free state), and props become the set of such bits they allow. An element is then
+// usable or visible when its allowed set covers the key. Game states are GameCondition flags, so none of this needs GW2Common.
+constexpr std::uint32_t DefaultStateKey = 1u << 31;
+
+inline std::uint32_t    StateKey(std::uint32_t conditions)
+{
+    if ((conditions & GameCondition::All) == GameCondition::None)
+        return DefaultStateKey;
+
+    return conditions & GameCondition::All;
+}
+
+inline std::uint32_t AllowedStates(ConditionalProperties cp, ConditionalProperties def, ConditionalProperties wvw, ConditionalProperties combat,
+                                   ConditionalProperties underwater, ConditionalProperties onWater)
+{
+    const auto    has     = [cp](ConditionalProperties p) { return (static_cast<std::uint32_t>(cp) & static_cast<std::uint32_t>(p)) != 0; };
+
+    std::uint32_t allowed = 0;
+    if (has(def))
+        allowed |= DefaultStateKey;
+    if (has(wvw))
+        allowed |= GameCondition::InWvW;
+    if (has(combat))
+        allowed |= GameCondition::InCombat;
+    if (has(underwater))
+        allowed |= GameCondition::Underwater;
+    if (has(onWater))
+        allowed |= GameCondition::OnWater;
+    return allowed;
+}
+
+inline std::uint32_t UsableStates(ConditionalProperties cp)
+{
+    return AllowedStates(cp, ConditionalProperties::UsableDefault, ConditionalProperties::UsableWvW, ConditionalProperties::UsableInCombat,
+                         ConditionalProperties::UsableUnderwater, ConditionalProperties::UsableOnWater);
+}
+
+inline std::uint32_t VisibleStates(ConditionalProperties cp)
+{
+    return AllowedStates(cp, ConditionalProperties::VisibleDefault, ConditionalProperties::VisibleWvW, ConditionalProperties::VisibleInCombat,
+                         ConditionalProperties::VisibleUnderwater, ConditionalProperties::VisibleOnWater);
+}
+
+// Some elements also depend on wheel state outside the game's conditions (options, queued input, configured keybinds...).
+// Each wheel packs those facts into one 64-bit word per query (Wheel::PackStateWord), and an element's gate is the set of bits
+// it requires, so evaluating it never calls back into the wheel.
+enum class GateMode : std::uint8_t
+{
+    None,     // props alone decide
+    Override, // a passing gate makes the element available regardless of props
+    Precheck, // the gate must pass in addition to props
+};
+
+struct ElementGate
+{
+    GateMode      mode     = GateMode::None;
+    std::uint64_t required = 0;
+
+    [[nodiscard]] bool passes(std::uint64_t stateWord) const
+    {
+        return (stateWord & required) == required;
+    }
+};
+
+inline bool EvaluateElement(std::uint32_t allowedStates, std::uint32_t stateKey, bool bound, GateMode mode, bool gatePasses)
+{
+    const bool byProps = bound && (stateKey & ~allowedStates) == 0;
+    switch (mode)
+    {
+        case GateMode::Override:
+            return gatePasses || byProps;
+        case GateMode::Precheck:
+            return gatePasses && byProps;
+        default:
+            return byProps;
+    }
+}
+
+// Everything about one element that visibility and usability depend on, as ElementPredicateTable compiles it
+struct ElementConditions
+{
+    std::uint32_t visibleStates = 0;
+    std::uint32_t usableStates  = 0;
+    bool          bound         = false;
+    ElementGate   gate;
+};
+
+// State word bits of the mount wheel, gating its special cancel and force elements
+namespace MountGate
+{
+inline constexpr std::uint64_t QueuingEnabledBit       = 1 << 0;
+inline constexpr std::uint64_t ShowCancelBit           = 1 << 1;
+inline constexpr std::uint64_t ShowForceBit            = 1 << 2;
+inline constexpr std::uint64_t InputQueuedBit          = 1 << 3;
+inline constexpr std::uint64_t ForceableMountQueuedBit = 1 << 4;
+
+inline constexpr ElementGate   Cancel{ GateMode::Override, QueuingEnabledBit | ShowCancelBit | InputQueuedBit };
+inline constexpr ElementGate   Force{ GateMode::Override, QueuingEnabledBit | ShowForceBit | ForceableMountQueuedBit };
+} // namespace MountGate
+
+// Template combos and chat commands gate each element, as a precheck, on a bit of their own set when its slot can act at all
+inline std::uint64_t SlotBit(std::size_t slot)
+{
+    return std::uint64_t(1) << slot;
+}
+} // namespace GW2Radial
@@ -0,0 +1,120 @@
+#pragma once
+#include <ElementConditions.h>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GW2Radial
+{
+// A wheel's element conditions precomputed as bitsets: for every combination of game conditions, which elements props and
+// keybinds make visible or usable. Element gates depend on the wheel's packed state word and are folded in per query with a
+// few bitset operations, so no query ever walks the elements. Bit i of a result refers to the i-th element passed to Compile().
+// Anything that feeds the compiled data (props, keybinds, gates, element list) must invalidate the table.
+class ElementPredicateTable
+{
+public:
+    static constexpr size_t Capacity   = 128;
+    static constexpr size_t StateCount = 32;
+    using Mask                         = std::bitset<Capacity>;
+
+    // The four GameCondition flags in the low bits, plus whether any condition is set at all, so that the default state stays
+    // distinct from states props do not restrict
+    [[nodiscard]] static size_t StateIndex(std::uint32_t conditions);
+    [[nodiscard]] static size_t FirstSet(const Mask& mask);
+
+    void                        Compile(std::span<const ElementConditions> elements);
+
+    void                        Invalidate()
+    {
+        valid_ = false;
+    }
+
+    [[nodiscard]] bool          valid() const
+    {
+        return valid_;
+    }
+
+    [[nodiscard]] const Mask&   bound() const
+    {
+        return bound_;
+    }
+
+    [[nodiscard]] Mask          Visible(std::uint32_t conditions, std::uint64_t stateWord) const
+    {
+        return ApplyGates(visible_[StateIndex(conditions)], stateWord);
+    }
+
+    [[nodiscard]] Mask          Usable(std::uint32_t conditions, std::uint64_t stateWord) const
+    {
+        return ApplyGates(usable_[StateIndex(conditions)], stateWord);
+    }
+
+private:
+    [[nodiscard]] Mask            ApplyGates(const Mask& byProps, std::uint64_t stateWord) const;
+    [[nodiscard]] const Mask&     GatePasses(std::uint64_t stateWord) const;
+
+    std::array<Mask, StateCount>  visible_{}, usable_{};
+    Mask                          bound_, overrides_, prechecks_;
+    std::vector<std::uint64_t>    gateRequired_;
+
+    // Gate results for the last state word seen; the word rarely changes between queries
+    mutable Mask                  gatePasses_;
+    mutable std::uint64_t         gateStateWord_ = 0;
+    mutable bool                  gateValid_     = false;
+    bool                          valid_         = false;
+};
+
+// The elements one query selects, in display order, for the last conditions and state word asked for. It is only refilled when
+// those change or it is invalidated, and capacity is reserved whenever the element list changes, so the render and hover paths
+// never allocate.
+template<typename Element>
+class ElementSetCache
+{
+public:
+    void Reserve(size_t count)
+    {
+        elements_.reserve(count);
+    }
+
+    void Invalidate()
+    {
+        valid_ = false;
+    }
+
+    // order lists element indices in display order; select returns the query's mask and elementAt the element at an index
+    template<typename Select, typename ElementAt>
+    const std::vector<Element*>& Get(std::uint32_t conditions, std::uint64_t stateWord, std::span<const std::uint32_t> order, Select&& select, ElementAt&& elementAt)
+    {
+        if (!valid_ || conditions_ != conditions || stateWord_ != stateWord)
+        {
+            const ElementPredicateTable::Mask mask = select();
+
+            elements_.clear();
+            for (std::uint32_t index : order)
+                if (mask.test(index))
+                    elements_.push_back(elementAt(index));
+
+            conditions_ = conditions;
+            stateWord_  = stateWord;
+            valid_      = true;
+            fillCount_++;
+        }
+
+        return elements_;
+    }
+
+    [[nodiscard]] std::uint64_t fillCount() const
+    {
+        return fillCount_;
+    }
+
+private:
+    std::vector<Element*> elements_;
+    std::uint32_t         conditions_ = 0;
+    std::uint64_t         stateWord_  = 0;
+    std::uint64_t         fillCount_  = 0;
+    bool                  valid_      = false;
+};
+} // namespace GW2Radial
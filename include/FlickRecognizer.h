@@ -0,0 +1,51 @@
+#pragma once
+#include <HoverTracker.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <optional>
+#include <span>
+
+namespace GW2Radial
+{
+// Recognizes a committed flick in the stream of cursor offsets of an open wheel, so a selection can fire without waiting for
+// the key release or the pop-up delay. The recognizer only reacts to Reset() and Feed(), so a recorded trace always replays
+// to the same decision.
+class FlickRecognizer
+{
+public:
+    struct Thresholds
+    {
+        // Offsets are in the same units as HoverTracker; times are in milliseconds
+        float        deadZone    = 0.f;
+        float        distance    = 0.f;
+        float        minSpeed    = 0.f;
+        std::int64_t maxDuration = 0;
+    };
+
+    enum class State
+    {
+        Armed,     // cursor in the dead zone, waiting for it to leave
+        Tracking,  // cursor left the dead zone, waiting for it to reach the commit distance
+        Rejected,  // too slow to be a flick; re-arms once the cursor returns to the dead zone
+        Committed, // terminal until the next Reset()
+    };
+
+    void                                   Reset(std::int64_t time, const Thresholds& thresholds);
+
+    // Returns the committing offset on the one sample that commits the flick
+    [[nodiscard]] std::optional<glm::vec2> Feed(std::int64_t time, glm::vec2 offset);
+
+    [[nodiscard]] State                    state() const
+    {
+        return state_;
+    }
+
+    [[nodiscard]] static std::optional<glm::vec2> Replay(std::span<const HoverTracker::Sample> samples, const Thresholds& thresholds);
+
+private:
+    Thresholds   thresholds_;
+    State        state_          = State::Armed;
+    std::int64_t lastSampleTime_ = 0;
+    std::int64_t startTime_      = 0;
+};
+} // namespace GW2Radial
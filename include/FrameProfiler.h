@@ -0,0 +1,158 @@
+#pragma once
+#include <Main.h>
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace GW2Radial
+{
+inline constexpr u32 MaxProfilerSections = 32;
+
+struct GpuFrameTimes
+{
+    std::array<float, MaxProfilerSections> ms{};
+    std::bitset<MaxProfilerSections>       used;
+};
+
+// Measures how long the GPU spends between balanced Begin/End pairs. Results become available a few frames later.
+class GpuTimerBackend
+{
+public:
+    virtual ~GpuTimerBackend() = default;
+
+    virtual void BeginFrame()                                = 0;
+    virtual void EndFrame()                                  = 0;
+    virtual void Begin(u32 section)                          = 0;
+    virtual void End()                                       = 0;
+
+    // Appends the times of every frame whose results have arrived since the last call
+    virtual void Collect(std::vector<GpuFrameTimes>& frames) = 0;
+};
+
+// For platforms and tests without GPU timing, every section reports no GPU time
+class NullGpuTimerBackend : public GpuTimerBackend
+{
+public:
+    void BeginFrame() override {}
+    void EndFrame() override {}
+    void Begin(u32) override {}
+    void End() override {}
+    void Collect(std::vector<GpuFrameTimes>&) override {}
+};
+
+// Fixed window of the most recent samples of a single measurement
+class RollingHistogram
+{
+public:
+    static constexpr u32 Capacity = 240;
+
+    struct Stats
+    {
+        float p50   = 0.f;
+        float p99   = 0.f;
+        float max   = 0.f;
+        u32   count = 0;
+    };
+
+    void                Add(float value);
+    [[nodiscard]] Stats stats() const;
+
+private:
+    std::array<float, Capacity> samples_{};
+    u32                         next_  = 0;
+    u32                         count_ = 0;
+};
+
+// Per-frame CPU and GPU timing of named sections of the draw path. While disabled, a scope costs a single branch.
+class FrameProfiler
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    class Scope
+    {
+    public:
+        Scope() = default;
+        Scope(Scope&& other) noexcept
+            : profiler_(std::exchange(other.profiler_, nullptr))
+            , section_(other.section_)
+            , start_(other.start_)
+        {
+        }
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&)      = delete;
+        ~Scope()
+        {
+            if (profiler_)
+                profiler_->End(section_, start_);
+        }
+
+    private:
+        Scope(FrameProfiler* profiler, u32 section)
+            : profiler_(profiler)
+            , section_(section)
+            , start_(Clock::now())
+        {
+        }
+
+        FrameProfiler*    profiler_ = nullptr;
+        u32               section_  = 0;
+        Clock::time_point start_;
+
+        friend class FrameProfiler;
+    };
+
+    explicit FrameProfiler(std::unique_ptr<GpuTimerBackend> gpu);
+
+    [[nodiscard]] Scope Measure(std::string_view name)
+    {
+        if (!active_)
+            return {};
+
+        return Begin(name);
+    }
+
+    // Enabling or disabling takes effect on the next frame
+    void               BeginFrame();
+    void               EndFrame();
+
+    [[nodiscard]] bool enabled() const
+    {
+        return enabled_;
+    }
+    void enabled(bool enabled)
+    {
+        enabled_ = enabled;
+    }
+
+    [[nodiscard]] std::string ToCsv() const;
+    void                      DrawOverlay();
+
+private:
+    struct Section
+    {
+        std::string      name;
+        float            cpuMs     = 0.f;
+        bool             cpuActive = false;
+        RollingHistogram cpu;
+        RollingHistogram gpu;
+    };
+
+    Scope                            Begin(std::string_view name);
+    void                             End(u32 section, Clock::time_point start);
+
+    std::unique_ptr<GpuTimerBackend> gpu_;
+    std::vector<Section>             sections_;
+    std::vector<GpuFrameTimes>       gpuFrames_;
+    RollingHistogram                 frameCpu_;
+    Clock::time_point                frameStart_;
+    bool                             enabled_ = false;
+    bool                             active_  = false;
+};
+} // namespace GW2Radial
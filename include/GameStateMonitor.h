@@ -0,0 +1,71 @@
+#pragma once
+#include <PlatformTypes.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GW2Radial
+{
+// The parts of the MumbleLink state wheel logic reacts to, captured once per update
+struct GameSnapshot
+{
+    std::uint32_t state           = GameCondition::None; // GameCondition flags
+    bool          mounted         = false;
+    bool          mapOpen         = false;
+    bool          gameHasFocus    = false;
+    bool          textboxHasFocus = false;
+    std::uint32_t mapId           = 0;
+    std::wstring  characterName;
+};
+
+// Diffs successive game snapshots and notifies listeners only of the fields they subscribed to, so wheels and queued inputs
+// react to changes instead of polling the game every frame. The first published snapshot reports every field as changed.
+// Snapshots are passed in by the caller, so the diffing runs the same against synthetic snapshots.
+class GameStateMonitor
+{
+public:
+    // Bits of a field mask
+    static constexpr std::uint32_t StateField        = 1 << 0;
+    static constexpr std::uint32_t MountedField      = 1 << 1;
+    static constexpr std::uint32_t MapOpenField      = 1 << 2;
+    static constexpr std::uint32_t FocusField        = 1 << 3;
+    static constexpr std::uint32_t TextboxFocusField = 1 << 4;
+    static constexpr std::uint32_t MapField          = 1 << 5;
+    static constexpr std::uint32_t CharacterField    = 1 << 6;
+    static constexpr std::uint32_t AllFields         = (1 << 7) - 1;
+
+    using ListenerId                                 = std::uint32_t;
+    using Listener                                   = std::function<void(const GameSnapshot& previous, const GameSnapshot& current, std::uint32_t changedFields)>;
+
+    [[nodiscard]] static std::uint32_t  Diff(const GameSnapshot& a, const GameSnapshot& b);
+
+    // Listeners may subscribe or unsubscribe from within a notification; new listeners first hear of the next change
+    ListenerId                          Subscribe(std::uint32_t fields, Listener listener);
+    void                                Unsubscribe(ListenerId id);
+
+    // Returns the fields that changed since the previous snapshot
+    std::uint32_t                       Publish(GameSnapshot snapshot);
+
+    [[nodiscard]] const GameSnapshot&   current() const
+    {
+        return current_;
+    }
+
+    [[nodiscard]] size_t                listenerCount() const;
+
+private:
+    struct Subscription
+    {
+        ListenerId    id;
+        std::uint32_t fields;
+        Listener      listener; // empty once unsubscribed during a notification
+    };
+
+    std::vector<Subscription> subscriptions_;
+    GameSnapshot              current_;
+    ListenerId                nextId_     = 1;
+    bool                      published_  = false;
+    bool                      publishing_ = false;
+};
+} // namespace GW2Radial
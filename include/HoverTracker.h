@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <optional>
+#include <span>
+
+namespace GW2Radial
+{
+// Recent cursor trajectory of an open wheel, sampled on every mouse move rather than once per frame. Offsets are relative to
+// the wheel center in the same units as SectorTable. Classification only reads the samples, so a recorded trajectory can be
+// replayed through Push() and checked deterministically.
+class HoverTracker
+{
+public:
+    struct Sample
+    {
+        std::int64_t time = 0;
+        glm::vec2    offset{};
+    };
+
+    static constexpr size_t Capacity = 64;
+
+    void                                   Reset()
+    {
+        count_ = 0;
+        head_  = 0;
+    }
+
+    // Consecutive samples at the same offset are merged, keeping the earliest time the cursor arrived there
+    void                                   Push(std::int64_t time, glm::vec2 offset);
+
+    [[nodiscard]] size_t                   size() const
+    {
+        return count_;
+    }
+
+    // age 0 is the newest sample
+    [[nodiscard]] const Sample&            sample(size_t age) const;
+    [[nodiscard]] std::optional<glm::vec2> latest() const;
+
+    // Offset that should decide the selection when the wheel is released at time now. This is the newest sample outside the
+    // dead zone, provided the cursor came back inside no earlier than flickWindow before now; a flick that reached a sector
+    // and sprang back toward the center still selects that sector. nullopt means the center.
+    [[nodiscard]] std::optional<glm::vec2> ReleaseOffset(std::int64_t now, float deadZoneSq, std::int64_t flickWindow) const;
+
+    // Convenience for replaying a recorded trajectory through a fresh tracker
+    [[nodiscard]] static std::optional<glm::vec2> Replay(std::span<const Sample> samples, std::int64_t now, float deadZoneSq, std::int64_t flickWindow);
+
+private:
+    std::array<Sample, Capacity> samples_{};
+    size_t                       head_  = 0;
+    size_t                       count_ = 0;
+};
+} // namespace GW2Radial
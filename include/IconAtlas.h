@@ -0,0 +1,83 @@
+#pragma once
+#include <AtlasPacker.h>
+#include <Graphics.h>
+#include <Main.h>
+#include <ShaderManager.h>
+#include <memory>
+#include <vector>
+
+namespace GW2Radial
+{
+// Copies every wheel element icon into a shared array of texture pages so a whole wheel can be drawn without rebinding textures.
+// Entries are owned by their elements; space held by released entries is reclaimed the next time the atlas runs out of room.
+// Single channel sources are distance fields (see DistanceField): they are copied at their own size, the field replicated into
+// every channel, and WheelElement.hlsl decodes them into white shapes with a black outline when drawing.
+class IconAtlas
+{
+public:
+    static constexpr u32 PageSize    = 2048;
+    static constexpr u32 MaxIconEdge = 512;
+    static constexpr u32 MipLevels   = 5;
+    // Icons sit in cells aligned to what one texel of the smallest mip covers, padded by as much, so no mip mixes two icons and
+    // filtering the smallest one only reaches into the icon's own extended edges
+    static constexpr u32 Padding     = 1u << (MipLevels - 1);
+
+    struct Entry
+    {
+        // Not owned, whoever holds the handle keeps the source alive for as long
+        ID3D11Resource*           source    = nullptr;
+        ID3D11ShaderResourceView* sourceSrv = nullptr;
+        glm::vec4                 sourceUvRect{ 0.f, 0.f, 1.f, 1.f };
+        glm::vec2                 sourceTexelSize{ 0.f, 0.f };
+        AtlasSize                 size;
+        AtlasRect                 rect;
+        u32                       page  = 0;
+        glm::vec4                 uvRect{ 0.f, 0.f, 1.f, 1.f };
+        bool                      distanceField = false;
+        bool                      dirty         = true;
+    };
+    using EntryHandle = std::shared_ptr<Entry>;
+
+    IconAtlas();
+
+    // The optional region restricts the icon to part of the source texture, in texels. The source must outlive the handle, it
+    // is copied again whenever the atlas is repacked or marked dirty.
+    EntryHandle Add(const Texture2D& source, const std::optional<AtlasRect>& region = std::nullopt);
+
+    // Sources which are render targets must be marked dirty whenever their contents change
+    void        MarkDirty(ID3D11Resource* source);
+
+    // Copies dirty entries into their pages, must run before any wheel is drawn
+    void        Update(ID3D11DeviceContext* ctx);
+
+    [[nodiscard]] const ComPtr<ID3D11ShaderResourceView>& srv() const
+    {
+        return srv_;
+    }
+
+private:
+    struct BlitCB
+    {
+        glm::vec4 sourceUvTransform;
+        glm::vec4 sourceUvClamp;
+        glm::vec4 distanceField; // x: source is a distance field
+    };
+
+    bool                                        Place(Entry& entry);
+    void                                        Repack();
+    void                                        CreatePages(u32 count);
+    void                                        Blit(ID3D11DeviceContext* ctx, const Entry& entry);
+
+    std::vector<std::weak_ptr<Entry>>           entries_;
+    std::vector<AtlasPacker>                    packers_;
+
+    ComPtr<ID3D11Texture2D>                     texture_;
+    ComPtr<ID3D11ShaderResourceView>            srv_;
+    std::vector<ComPtr<ID3D11RenderTargetView>> rtvs_;
+    u32                                         pageCount_ = 0;
+
+    ShaderId                                    vs_, ps_;
+    ComPtr<ID3D11SamplerState>                  sampler_;
+    ConstantBufferSPtr<BlitCB>                  cb_;
+};
+} // namespace GW2Radial
@@ -0,0 +1,57 @@
+#pragma once
+#include <AtlasPacker.h>
+#include <Graphics.h>
+#include <LabelLayout.h>
+#include <Main.h>
+#include <imgui.h>
+#include <memory>
+#include <vector>
+
+namespace GW2Radial
+{
+// Lays out text labels in shared render target pages and draws every pending label in a single ImGui submission per page.
+// Pages are never compacted: a page is released once all of its labels are.
+class LabelBaker
+{
+public:
+    static constexpr u32 PageWidth  = 2048;
+    static constexpr u32 PageHeight = 1024;
+    static constexpr u32 Padding    = 2;
+
+    struct Page
+    {
+        RenderTarget rt;
+        AtlasPacker  packer{ PageWidth, PageHeight, Padding };
+        bool         cleared = false;
+    };
+
+    struct Label
+    {
+        std::shared_ptr<Page> page;
+        AtlasRect             rect;
+        std::string           text;
+        float                 fontSize;
+        u64                   cacheKey = 0;
+        std::vector<u8>       cachedPixels;
+    };
+    using LabelHandle = std::shared_ptr<Label>;
+
+    LabelBaker(ImFont* font, ComPtr<ID3D11BlendState> blendState);
+
+    // The label's pixels are undefined until the next Bake, which copies them from the asset cache when possible
+    LabelHandle Add(const std::wstring& text, float fontSize, u32 width, u32 height);
+
+    void        Bake(ID3D11DeviceContext* ctx);
+
+    [[nodiscard]] bool hasPending() const
+    {
+        return !pending_.empty();
+    }
+
+private:
+    std::vector<std::weak_ptr<Page>>  pages_;
+    std::vector<std::weak_ptr<Label>> pending_;
+    ImFont*                           font_ = nullptr;
+    ComPtr<ID3D11BlendState>          blendState_;
+};
+} // namespace GW2Radial
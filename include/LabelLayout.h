@@ -0,0 +1,17 @@
+#pragma once
+#include <AtlasPacker.h>
+#include <cfloat>
+#include <string>
+
+namespace GW2Radial
+{
+// Horizontally centers a label's text within its rectangle. Only depends on the font's metrics, so anything measuring text the
+// way ImFont::CalcTextSizeA does can stand in for ImFont; text too wide for the rectangle overhangs it equally on both sides.
+template<typename Font>
+auto LayoutLabel(const Font* font, float fontSize, const std::string& text, const AtlasRect& rect)
+{
+    const auto sz = font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, text.c_str());
+
+    return decltype(sz){ float(rect.x) + (float(rect.width) - sz.x) * 0.5f, float(rect.y) };
+}
+} // namespace GW2Radial
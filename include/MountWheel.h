@@ -10,8 +10,6 @@ class MountWheel : public Wheel
 public:
     MountWheel(std::shared_ptr<Texture2D> bgTexture);
 
-    void OnUpdate() override;
-
 protected:
     static const char* GetMountNameFromType(MountType m)
     {
@@ -116,8 +114,11 @@ protected:
     bool                      BypassCheck(WheelElement*&, Keybind*&) override;
     bool                      CustomDelayCheck(OptKeybindWheelElement&) override;
     bool                      ResetMouseCheck(WheelElement*) override;
-    Keybind*                  GetKeybindFromOpt(OptKeybindWheelElement& o) override;
+    bool                      HandleQueueCommand(const OptKeybindWheelElement& o) override;
+    bool                      ReplacesQueuedInput() const override;
+    bool                      KeepsQueuedInputAfterSend() const override;
     bool                      SpecialBehaviorBeforeDelay() override;
+    u64                       PackStateWord() const override;
 
     ConfigurationOption<int>  dismountDelayOption_;
     ConfigurationOption<bool> quickDismountOption_;
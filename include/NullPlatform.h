@@ -0,0 +1,91 @@
+#pragma once
+#include <Platform.h>
+#include <map>
+#include <vector>
+
+namespace GW2Radial
+{
+// Headless platform for tests and benchmarks: game state, time and cursor are set directly by the harness,
+// and every keybind and cursor move the wheels request is recorded instead of performed. Mouse events only
+// reach subscribers when the harness raises them.
+class NullPlatform : public Clock, public InputSink, public InputEvents, public GameStateSource, public Cursor, public Renderer
+{
+public:
+    struct SentKeybind
+    {
+        KeyChord                  keys;
+        std::optional<glm::ivec2> cursorPos;
+        PlatformTime              time = 0;
+    };
+
+    // Scripted inputs
+    PlatformTime             time           = 0;
+    std::uint32_t            state          = GameCondition::None;
+    bool                     hasFocus       = true;
+    bool                     mapOpen        = false;
+    bool                     mounted        = false;
+    bool                     inWvW          = false;
+    std::uint32_t            scale          = 1;
+    glm::vec2                cursorPosition = { 960.f, 540.f };
+    glm::ivec2               screen         = { 1920, 1080 };
+    float                    dpi            = 1.f;
+
+    // Recorded outputs
+    std::vector<SentKeybind> sentKeybinds;
+    std::vector<SentKeybind> releasedKeybinds;
+    std::uint32_t            keyUpActiveCount = 0;
+    std::uint32_t            centerCount      = 0;
+
+    // The monitor is optional, wheels need one to subscribe to game state changes
+    [[nodiscard]] Platform   platform(GameStateMonitor* monitor = nullptr)
+    {
+        return { this, this, this, this, this, this, monitor };
+    }
+
+    void Advance(PlatformTime dt)
+    {
+        time += dt;
+    }
+
+    void Reset();
+
+    // Moves the cursor and notifies mouse move subscribers; returns whether the event would reach the game
+    bool                           RaiseMouseMove(glm::vec2 position);
+    bool                           RaiseMouseButton(std::uint32_t scanCode, bool down);
+
+    [[nodiscard]] size_t           subscriptionCount() const
+    {
+        return mouseMoveHandlers_.size() + mouseButtonHandlers_.size();
+    }
+
+    [[nodiscard]] PlatformTime     now() const override;
+
+    void                           SendKeybind(const KeyChord& keys, std::optional<glm::ivec2> cursorPos) override;
+    void                           KeyUpActive() override;
+    bool                           PressKeybindNow(const KeyChord& keys) override;
+    void                           ReleaseKeybindNow(const KeyChord& keys) override;
+
+    SubscriptionId                 SubscribeMouseMove(MouseMoveHandler handler) override;
+    SubscriptionId                 SubscribeMouseButton(MouseButtonHandler handler) override;
+    void                           Unsubscribe(SubscriptionId id) override;
+
+    [[nodiscard]] std::uint32_t    currentState() const override;
+    [[nodiscard]] bool             gameHasFocus() const override;
+    [[nodiscard]] bool             isMapOpen() const override;
+    [[nodiscard]] bool             isMounted() const override;
+    [[nodiscard]] bool             isInWvW() const override;
+    [[nodiscard]] std::uint32_t    uiScale() const override;
+
+    [[nodiscard]] glm::vec2        position() const override;
+    [[nodiscard]] glm::vec2        livePosition() const override;
+    bool                           CenterInWindow() override;
+
+    [[nodiscard]] glm::ivec2       screenSize() const override;
+    [[nodiscard]] float            dpiScale() const override;
+
+private:
+    std::map<SubscriptionId, MouseMoveHandler>   mouseMoveHandlers_;
+    std::map<SubscriptionId, MouseButtonHandler> mouseButtonHandlers_;
+    SubscriptionId                               nextSubscription_ = 1;
+};
+} // namespace GW2Radial
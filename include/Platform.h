@@ -0,0 +1,104 @@
+#pragma once
+#include <PlatformTypes.h>
+#include <cstdint>
+#include <functional>
+#include <glm/vec2.hpp>
+#include <optional>
+
+namespace GW2Radial
+{
+class GameStateMonitor;
+
+// Services wheel logic needs from the game and the OS. Wheels only reach them through CurrentPlatform(),
+// so the same logic runs against the game (Win32Platform) or against a scripted, recording harness (NullPlatform).
+// Only the standard library and glm are used here so the harness builds on any OS; GW2Common's time, key and game state
+// types cross these interfaces as the plain values of PlatformTypes.h.
+class Clock
+{
+public:
+    virtual ~Clock()                               = default;
+
+    [[nodiscard]] virtual PlatformTime now() const = 0;
+};
+
+class InputSink
+{
+public:
+    virtual ~InputSink()                                                                = default;
+
+    virtual void SendKeybind(const KeyChord& keys, std::optional<glm::ivec2> cursorPos) = 0;
+    virtual void KeyUpActive()                                                          = 0;
+
+    // Press and release right away on the calling thread instead of through the per-frame input queue, for the action chain
+    // executor to hold keys between its steps. Modifiers the player holds that are not part of the chord are released while it is
+    // down and restored with it. Press returns false when the game cannot receive input; Release must follow every Press.
+    virtual bool PressKeybindNow(const KeyChord& keys)                                  = 0;
+    virtual void ReleaseKeybindNow(const KeyChord& keys)                                = 0;
+};
+
+// Mouse input as it arrives between frames. Handlers set passToGame to false to swallow the event.
+class InputEvents
+{
+public:
+    using SubscriptionId     = std::uint64_t;
+    using MouseMoveHandler   = std::function<void(bool& passToGame)>;
+    using MouseButtonHandler = std::function<void(std::uint32_t scanCode, bool down, bool& passToGame)>;
+
+    virtual ~InputEvents()                                                  = default;
+
+    virtual SubscriptionId SubscribeMouseMove(MouseMoveHandler handler)     = 0;
+    virtual SubscriptionId SubscribeMouseButton(MouseButtonHandler handler) = 0;
+    virtual void           Unsubscribe(SubscriptionId id)                   = 0;
+};
+
+class GameStateSource
+{
+public:
+    virtual ~GameStateSource()                               = default;
+
+    // GameCondition flags
+    [[nodiscard]] virtual std::uint32_t currentState() const = 0;
+    [[nodiscard]] virtual bool          gameHasFocus() const = 0;
+    [[nodiscard]] virtual bool          isMapOpen() const    = 0;
+    [[nodiscard]] virtual bool          isMounted() const    = 0;
+    [[nodiscard]] virtual bool          isInWvW() const      = 0;
+    [[nodiscard]] virtual std::uint32_t uiScale() const      = 0;
+};
+
+// Cursor positions are in game window client coordinates. position() is the per-frame snapshot the UI sees, while
+// livePosition() is read at call time so input callbacks between frames observe the cursor where it actually is.
+class Cursor
+{
+public:
+    virtual ~Cursor()                                    = default;
+
+    [[nodiscard]] virtual glm::vec2 position() const     = 0;
+    [[nodiscard]] virtual glm::vec2 livePosition() const = 0;
+    virtual bool                    CenterInWindow()     = 0;
+};
+
+class Renderer
+{
+public:
+    virtual ~Renderer()                                 = default;
+
+    [[nodiscard]] virtual glm::ivec2 screenSize() const = 0;
+    [[nodiscard]] virtual float      dpiScale() const   = 0;
+};
+
+struct Platform
+{
+    Clock*            clock     = nullptr;
+    InputSink*        input     = nullptr;
+    InputEvents*      events    = nullptr;
+    GameStateSource*  gameState = nullptr;
+    Cursor*           cursor    = nullptr;
+    Renderer*         renderer  = nullptr;
+    // Where wheels subscribe to game state changes; owned by whoever installs the platform
+    GameStateMonitor* monitor   = nullptr;
+};
+
+// The platform must be installed before any wheel is created and outlive all of them
+const Platform& CurrentPlatform();
+void            SetCurrentPlatform(const Platform& platform);
+} // namespace GW2Radial
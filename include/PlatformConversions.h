@@ -0,0 +1,67 @@
+#pragma once
+#include <Input.h>
+#include <Main.h>
+#include <MumbleLink.h>
+#include <PlatformTypes.h>
+#include <glm/vec2.hpp>
+#include <optional>
+
+namespace GW2Radial
+{
+// Converts between GW2Common's types and the plain values of PlatformTypes.h, on the game side of the platform interfaces
+
+inline KeyChord ToKeyChord(const KeyCombo& kc)
+{
+    return { std::uint32_t(ToUnderlying(kc.key())), std::uint32_t(ToUnderlying(kc.mod())) };
+}
+
+inline KeyCombo ToKeyCombo(const KeyChord& keys)
+{
+    return { ScanCode(std::underlying_type_t<ScanCode>(keys.scanCode)), Modifier(std::underlying_type_t<Modifier>(keys.modifiers)) };
+}
+
+inline std::optional<glm::ivec2> ToCursorPos(const std::optional<Point>& p)
+{
+    if (!p)
+        return std::nullopt;
+
+    return glm::ivec2(p->x, p->y);
+}
+
+inline std::optional<Point> ToPoint(const std::optional<glm::ivec2>& p)
+{
+    if (!p)
+        return std::nullopt;
+
+    return Point{ p->x, p->y };
+}
+
+// Flag by flag, so the two sides never have to agree on bit values
+inline std::uint32_t ToGameConditions(ConditionalState cs)
+{
+    std::uint32_t conditions = GameCondition::None;
+    if (NotNone(cs & ConditionalState::InCombat))
+        conditions |= GameCondition::InCombat;
+    if (NotNone(cs & ConditionalState::Underwater))
+        conditions |= GameCondition::Underwater;
+    if (NotNone(cs & ConditionalState::OnWater))
+        conditions |= GameCondition::OnWater;
+    if (NotNone(cs & ConditionalState::InWvW))
+        conditions |= GameCondition::InWvW;
+    return conditions;
+}
+
+inline ConditionalState ToConditionalState(std::uint32_t conditions)
+{
+    ConditionalState cs = ConditionalState::None;
+    if (conditions & GameCondition::InCombat)
+        cs = cs | ConditionalState::InCombat;
+    if (conditions & GameCondition::Underwater)
+        cs = cs | ConditionalState::Underwater;
+    if (conditions & GameCondition::OnWater)
+        cs = cs | ConditionalState::OnWater;
+    if (conditions & GameCondition::InWvW)
+        cs = cs | ConditionalState::InWvW;
+    return cs;
+}
+} // namespace GW2Radial
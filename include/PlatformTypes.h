@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+namespace GW2Radial
+{
+// Plain-value counterparts of GW2Common's time, key and game state types, for code that has to build without GW2Common:
+// the platform interfaces, the modules behind them and their tests. PlatformConversions.h converts on the game side.
+
+// Milliseconds, like mstime
+using PlatformTime = std::uint64_t;
+
+// A KeyCombo as its ScanCode and Modifier values
+struct KeyChord
+{
+    std::uint32_t scanCode  = 0;
+    std::uint32_t modifiers = 0;
+
+    bool          operator==(const KeyChord&) const = default;
+};
+
+// Modifier changes around a keybind injected while the player physically holds some modifiers, so the game sees exactly the chord.
+// Works on the bits as they are, whatever modifier each stands for.
+struct ModifierChanges
+{
+    std::uint32_t press   = 0; // part of the chord, not held: pressed with the key, released after it
+    std::uint32_t release = 0; // held, not part of the chord: released with the key, pressed again after it
+
+    static ModifierChanges For(std::uint32_t chord, std::uint32_t held)
+    {
+        return { chord & ~held, held & ~chord };
+    }
+};
+
+// ConditionalState flags, with bit values of their own
+namespace GameCondition
+{
+inline constexpr std::uint32_t None       = 0;
+inline constexpr std::uint32_t InCombat   = 1 << 0;
+inline constexpr std::uint32_t Underwater = 1 << 1;
+inline constexpr std::uint32_t OnWater    = 1 << 2;
+inline constexpr std::uint32_t InWvW      = 1 << 3;
+inline constexpr std::uint32_t All        = InCombat | Underwater | OnWater | InWvW;
+} // namespace GameCondition
+} // namespace GW2Radial
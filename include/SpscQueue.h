@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace GW2Radial
+{
+// Bounded lock-free queue for exactly one producer thread and one consumer thread. Head and tail live on separate cache lines
+// so the two sides never contend on the same line; one slot is kept free to tell a full queue from an empty one.
+template<typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side; returns false and leaves value untouched when the queue is full
+    bool TryPush(T& value)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = (tail + 1) & (Capacity - 1);
+        if (next == head_.load(std::memory_order_acquire))
+            return false;
+
+        slots_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    std::optional<T> TryPop()
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> value = std::move(slots_[head]);
+        slots_[head]           = T{};
+        head_.store((head + 1) & (Capacity - 1), std::memory_order_release);
+        return value;
+    }
+
+private:
+    static constexpr size_t          CacheLine = 64;
+
+    alignas(CacheLine) std::atomic<size_t> head_ = 0;
+    alignas(CacheLine) std::atomic<size_t> tail_ = 0;
+    std::array<T, Capacity>          slots_;
+};
+} // namespace GW2Radial
@@ -0,0 +1,82 @@
+#pragma once
+#include <Main.h>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GW2Radial
+{
+// Times the phases of addon startup, up to the first custom wheel reload. Scopes nest, so a texture load is listed under the wheel which caused it.
+// Only meant to be used from the render thread.
+class StartupProfile
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase
+    {
+        std::string name;
+        u32         depth      = 0;
+        double      startMs    = 0.0;
+        double      durationMs = 0.0;
+    };
+
+    class Scope
+    {
+    public:
+        Scope(Scope&& other) noexcept
+            : profile_(std::exchange(other.profile_, nullptr))
+            , index_(other.index_)
+        {
+        }
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&)      = delete;
+        ~Scope();
+
+    private:
+        Scope(StartupProfile* profile, size_t index)
+            : profile_(profile)
+            , index_(index)
+        {
+        }
+
+        StartupProfile* profile_;
+        size_t          index_;
+
+        friend class StartupProfile;
+    };
+
+    // Does nothing once startup has finished
+    [[nodiscard]] Scope Measure(std::string name);
+
+    // Reports the collected phases to the log and to startup_profile.json in the configuration folder
+    void                Finish();
+
+    [[nodiscard]] bool  finished() const
+    {
+        return finished_;
+    }
+    [[nodiscard]] double totalMs() const
+    {
+        return totalMs_;
+    }
+    [[nodiscard]] const std::vector<Phase>& phases() const
+    {
+        return phases_;
+    }
+
+    [[nodiscard]] std::string ToJson() const;
+    void                      DrawGUI() const;
+
+private:
+    double             ElapsedMs() const;
+
+    Clock::time_point  start_ = Clock::now();
+    std::vector<Phase> phases_;
+    u32                depth_    = 0;
+    double             totalMs_  = 0.0;
+    bool               finished_ = false;
+};
+} // namespace GW2Radial
@@ -27,6 +27,8 @@ protected:
     void OnUpdate() override;
     void DrawMenu(Keybind** currentHover) override;
     void MenuSectionKeybinds(Keybind** keybindInEdit) override;
+    u64  PackStateWord() const override;
+    bool ReplacesQueuedInput() const override;
 
 private:
     void UpdateActionChain(size_t elementIndex);
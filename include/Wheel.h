@@ -1,13 +1,23 @@
 #pragma once
 
+#include <ActionChainExecutor.h>
+#include <ActionQueue.h>
 #include <ConfigurationOption.h>
+#include <ElementPredicateTable.h>
+#include <FlickRecognizer.h>
+#include <GameStateMonitor.h>
 #include <Graphics.h>
+#include <HoverTracker.h>
 #include <Input.h>
 #include <Main.h>
+#include <Platform.h>
+#include <PlatformConversions.h>
 #include <SettingsMenu.h>
 #include <ShaderManager.h>
 #include <Utility.h>
 #include <WheelElement.h>
+#include <WheelFavorite.h>
+#include <WheelLayout.h>
 
 namespace GW2Radial
 {
@@ -31,17 +41,33 @@ public:
         PassToGame = 4
     };
 
+    // Reaches input and game state through CurrentPlatform() only. Whoever creates a wheel adds it to SettingsMenu, the wheel
+    // removes itself when destroyed.
     Wheel(std::shared_ptr<Texture2D> bgTexture, std::string nickname, std::string displayName);
     virtual ~Wheel();
 
     void UpdateHover();
 
+    // Upper bound on the number of elements in a single wheel, sizes the per-element shader data. Favorites only reach the first
+    // WheelFavorite::MaxIndex + 1 of them.
+    static inline const u32 MaxElementCount = 128;
+    static_assert(WheelFavorite::MaxIndex < int(MaxElementCount));
+
     void AddElement(std::unique_ptr<WheelElement>&& we)
     {
+        GW2_ASSERT(wheelElements_.size() < MaxElementCount);
         wheelElements_.push_back(std::move(we));
         Sort();
     }
 
+    // Must be called whenever anything feeding into element visibility or usability changes (props, keybinds, ordering or custom behavior inputs)
+    void InvalidateElementCache() const
+    {
+        visibleCache_.Invalidate();
+        usableCache_.Invalidate();
+        predicates_.Invalidate();
+    }
+
     void               Draw(ID3D11DeviceContext* ctx);
     void               OnFocusLost();
     virtual void       OnUpdate();
@@ -90,7 +116,7 @@ public:
         return ((enableSkipWvWOption_.value() ? ConditionalState::InWvW : ConditionalState::None) |
                 (enableSkipUWOption_.value() ? ConditionalState::Underwater : ConditionalState::None) |
                 (enableSkipOWOption_.value() ? ConditionalState::OnWater : ConditionalState::None)) &
-               MumbleLink::i().currentState();
+               ToConditionalState(CurrentPlatform().gameState->currentState());
     }
 
     // Determine whether displaying the wheel should be skipped (in favor of just immediately triggering an element)
@@ -100,9 +126,9 @@ public:
         if (!enableSkipOWOption_.value() && !enableSkipUWOption_.value() && !enableSkipWvWOption_.value())
             return false;
 
-        if (auto elems = GetUsableElements(GetSkipState()); elems.size() == 1)
+        if (const auto usable = Predicates().Usable(ToGameConditions(GetSkipState()), PackStateWord()); usable.count() == 1)
         {
-            we = elems.front();
+            we = wheelElements_[ElementPredicateTable::FirstSet(usable)].get();
             return true;
         }
 
@@ -119,6 +145,9 @@ protected:
         return o.index() != 0;
     }
 
+    // Listens to Core's game state changes for this wheel's lifetime, only fields in the mask wake the listener
+    void             SubscribeGameState(u32 fields, GameStateMonitor::Listener listener);
+
     virtual Keybind* GetKeybindFromOpt(OptKeybindWheelElement& o)
     {
         if (std::holds_alternative<Keybind*>(o))
@@ -164,41 +193,69 @@ protected:
         return false;
     }
 
-    union Favorite
+    // Lets an element act on this wheel's queued inputs (e.g. cancel or force them) instead of being queued itself
+    virtual bool HandleQueueCommand(const OptKeybindWheelElement&)
     {
-        u32 value;
-        struct Bitmask
-        {
-            int baseline : 6;
-
-            int inCombat : 6;
-            int onWater : 6;
-            int underwater : 6;
-            int inWvW : 6;
-        } bits;
-        static_assert(sizeof(Bitmask) == sizeof(u32));
-    };
+        return false;
+    }
+
+    // Whether a new input replaces this wheel's pending ones rather than queuing up behind them
+    [[nodiscard]] virtual bool ReplacesQueuedInput() const
+    {
+        return false;
+    }
+
+    // Whether a queued input stays queued (and is sent again later) once it has been sent
+    [[nodiscard]] virtual bool KeepsQueuedInputAfterSend() const
+    {
+        return !clearConditionalDelayOnSend_;
+    }
+
+    // Packs the wheel state element gates depend on (see ElementGate) into one word; evaluated once per query, never per element
+    [[nodiscard]] virtual u64 PackStateWord() const
+    {
+        return 0;
+    }
+
+    using Favorite = WheelFavorite;
     static Favorite MakeDefaultFavorite();
 
     void            Sort();
-    void UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spriteDimensions, float fadeIn, float animationTimer, const std::vector<WheelElement*>& activeElements,
-                              const std::span<float>& hoveredFadeIns, float timeLeft, bool showIcon, bool tilt);
+    // Shaders and device states are only created on the first draw, so a wheel can be driven without a device
+    void            CreateDeviceResources(ID3D11DeviceContext* ctx);
+    void UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spriteDimensions, float fadeIn, float animationTimer, u32 elementCount, float timeLeft, bool showIcon,
+                              bool tilt);
     void UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& baseSpriteDimensions);
+    void UpdateElementData(ID3D11DeviceContext* ctx, const std::vector<WheelElement*>& activeElements, float centerHoverFadeIn, mstime currentTime);
+    void DrawElements(ID3D11DeviceContext* ctx, const std::vector<WheelElement*>& activeElements, const glm::vec4& baseSpriteDimensions, mstime currentTime);
 
     WheelElement*                              GetCenterHoveredElement();
+    glm::vec2                                  CursorOffset(glm::vec2 cursor) const;
+    float                                      HoverDeadZoneSq() const;
+    WheelElement*                              ElementAtOffset(glm::vec2 offset);
     WheelElement*                              GetFavorite(Favorite fav) const;
     std::vector<WheelElement*>                 GetVisibleElements(ConditionalState cs, bool sorted = true) const;
+    const ElementPredicateTable&               Predicates() const;
+    const std::vector<WheelElement*>&          GetCachedVisibleElements(ConditionalState cs) const;
     bool                                       HasVisibleElements(ConditionalState cs) const;
     std::vector<WheelElement*>                 GetUsableElements(ConditionalState cs, bool sorted = true) const;
+    const std::vector<WheelElement*>&          GetCachedUsableElements(ConditionalState cs) const;
     bool                                       HasUsableElements(ConditionalState cs) const;
     bool                                       HasVisibleOrUsableElements(ConditionalState cs) const;
     PassToGame                                 KeybindEvent(bool center, Activated activated);
     void                                       OnMouseMove(bool& rv);
     void                                       OnMouseButton(ScanCode sc, bool down, bool& rv);
     void                                       ActivateWheel(bool isMountOverlayLocked);
-    void                                       DeactivateWheel();
+    void                                       DeactivateWheel(bool flicked = false);
+    FlickRecognizer::Thresholds                FlickThresholds() const;
     void                                       SendKeybindOrDelay(OptKeybindWheelElement kbwe, std::optional<Point> mousePos);
-    void                                       ResetConditionallyDelayed(bool withFadeOut, mstime currentTime = TimeInMilliseconds());
+    void                                       StartActionChain(WheelElement* element);
+    void                                       QueueInput(const OptKeybindWheelElement& kbwe, bool immediate);
+    bool                                       SendQueuedInput(OptKeybindWheelElement kbwe);
+    void                                       OnQueuedInputFinished(ActionQueue::Id id, ActionQueue::Outcome outcome);
+    void                                       CancelQueuedInputs();
+    void                                       ResetConditionallyDelayed(bool withFadeOut, mstime currentTime = CurrentPlatform().clock->now());
+    void                                       ClearDelayIndicator(bool withFadeOut, mstime currentTime);
     void                                       PassToGame();
 
     std::string                                nickname_, displayName_;
@@ -207,6 +264,16 @@ protected:
 
     std::vector<std::unique_ptr<WheelElement>> wheelElements_;
     std::vector<WheelElement*>                 sortedWheelElements_;
+    std::vector<u32>                           sortedOrder_; // Indices into wheelElements_, matching sortedWheelElements_
+
+    // Sorted visible/usable elements for the last queried state, reused across frames so the render and hover paths never allocate
+    mutable ElementSetCache<WheelElement>      visibleCache_, usableCache_;
+    mutable ElementPredicateTable              predicates_;
+    SectorTable                                sectorTable_;
+    // Releasing within this long of springing back from a sector into the center still selects the sector
+    static constexpr mstime                    FlickReleaseWindow = 120;
+    HoverTracker                               hoverTracker_;
+    FlickRecognizer                            flickRecognizer_;
     bool                                       isVisible_                 = false;
     u32                                        minElementSortingPriority_ = 0;
     ConditionSetPtr                            conditions_;
@@ -214,45 +281,32 @@ protected:
     bool                                       waitingForBypassComplete_    = false;
     bool                                       clearConditionalDelayOnSend_ = true;
 
-    struct ConditionalDelay
+    // Inputs this wheel has waiting in Core's action queue, oldest first
+    struct QueuedInput
     {
-        static constexpr mstime FadeOutTime    = 500;
+        ActionQueue::Id        id;
+        OptKeybindWheelElement element;
+        mstime                 time;
+        bool                   hidden;
+    };
+    std::vector<QueuedInput>      queuedInputs_;
+    bool                          cancellingQueuedInputs_ = false;
 
-        OptKeybindWheelElement  element        = {};
-        mstime                  time           = TimeInMilliseconds();
-        bool                    hidden         = false;
-        bool                    immediate      = false;
+    // Mirrors the newest queued input for the delay indicator and custom behaviors; element is empty when nothing is queued
+    struct ConditionalDelay
+    {
+        static constexpr mstime FadeOutTime = 500;
 
-        bool                    testPasses     = false;
-        mstime                  testPassesTime = 0;
+        OptKeybindWheelElement  element     = {};
+        mstime                  time        = CurrentPlatform().clock->now();
+        bool                    hidden      = false;
     };
 
     ConditionalDelay              conditionalDelay_;
     WheelElement*                 conditionalDelayDisplay_ = nullptr;
 
-    // Action chain execution state
-    struct ActionChainState
-    {
-        std::vector<WheelElement::KeybindStep> steps;
-        size_t                                 currentStep      = 0;
-        mstime                                 nextStepTime     = 0;
-        WheelElement*                          sourceElement    = nullptr;
-
-        [[nodiscard]] bool isActive() const
-        {
-            return !steps.empty() && currentStep < steps.size();
-        }
-
-        void reset()
-        {
-            steps.clear();
-            currentStep  = 0;
-            nextStepTime = 0;
-            sourceElement = nullptr;
-        }
-    };
-
-    ActionChainState              actionChain_;
+    // The chain this wheel last started on Core's executor, if any
+    ActionChainExecutor::Handle   actionChain_;
 
     ConfigurationOption<int>      centerBehaviorOption_;
     ConfigurationOption<Favorite> centerFavoriteOption_;
@@ -270,6 +324,7 @@ protected:
     ConfigurationOption<bool>     showOverGameUIOption_;
     ConfigurationOption<bool>     noHoldOption_;
     ConfigurationOption<bool>     clickSelectOption_;
+    ConfigurationOption<bool>     flickSelectOption_;
     ConfigurationOption<int>      behaviorOnReleaseBeforeDelay_;
     ConfigurationOption<bool>     resetCursorAfterKeybindOption_;
 
@@ -295,13 +350,14 @@ protected:
     WheelElement*                 previousUsed_       = nullptr;
 
     std::shared_ptr<Texture2D>    backgroundTexture_;
-    ShaderId                      psWheel_, psWheelElement_, psCursor_, psDelayIndicator_, vs_;
+    ShaderId                      psWheel_, psWheelElement_, psCursor_, psDelayIndicator_, vs_, vsElements_;
     ComPtr<ID3D11BlendState>      blendState_;
     ComPtr<ID3D11SamplerState>    borderSampler_;
     ComPtr<ID3D11SamplerState>    baseSampler_;
 
-    EventCallbackHandle           mouseMoveCallbackID_;
-    EventCallbackHandle           mouseButtonCallbackID_;
+    InputEvents::SubscriptionId               mouseMoveCallbackID_   = 0;
+    InputEvents::SubscriptionId               mouseButtonCallbackID_ = 0;
+    std::vector<GameStateMonitor::ListenerId> gameStateListeners_;
 
     glm::vec3                     wipeMaskData_;
     bool                          showEmptyPopup_ = false;
@@ -316,8 +372,6 @@ protected:
     friend class WheelElement;
     friend class CustomWheelsManager;
 
-    static inline const u32 MaxHoverFadeIns = 20;
-
     struct WheelCB
     {
         glm::vec3 wipeMaskData;
@@ -326,12 +380,27 @@ protected:
         float     centerScale;
         int       elementCount;
         float     globalOpacity;
-        float     hoverFadeIns[MaxHoverFadeIns];
         float     timeLeft;
         bool      showIcon;
     };
 
+    // Matches WheelElementData in common.hlsli, one entry per visible element followed by one for the center region
+    struct ElementData
+    {
+        float     hoverFadeIn;
+        glm::vec3 padding; // keeps the stride at 16 bytes
+    };
+    static_assert(sizeof(ElementData) == 16);
+
     ConstantBufferSPtr<WheelCB>        cb_;
     static ConstantBufferWPtr<WheelCB> cb_s;
+
+    ComPtr<ID3D11Buffer>               elementDataBuffer_;
+    ComPtr<ID3D11ShaderResourceView>   elementDataSrv_;
+    u32                                elementDataCapacity_ = 0;
+
+    ComPtr<ID3D11Buffer>               instanceBuffer_;
+    ComPtr<ID3D11ShaderResourceView>   instanceSrv_;
+    u32                                instanceCapacity_ = 0;
 };
 } // namespace GW2Radial
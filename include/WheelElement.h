@@ -1,84 +1,65 @@
 #pragma once
+#include <ElementConditions.h>
 #include <Graphics.h>
+#include <IconAtlas.h>
 #include <ImGuiExtensions.h>
 #include <Main.h>
+#include <PlatformConversions.h>
 #include <SettingsMenu.h>
 #include <ShaderManager.h>
 
 namespace GW2Radial
 {
-enum class ConditionalProperties : u32
+// Game-side forms of the condition masks in ElementConditions.h
+inline u32 StateKey(ConditionalState cs)
 {
-    None              = 0,
-
-    VisibleDefault    = 1,
-    UsableDefault     = 2,
-
-    VisibleUnderwater = 4,
-    UsableUnderwater  = 8,
-
-    VisibleOnWater    = 16,
-    UsableOnWater     = 32,
-
-    VisibleInCombat   = 64,
-    UsableInCombat    = 128,
-
-    VisibleWvW        = 256,
-    UsableWvW         = 512,
-
-    VisibleAll        = VisibleDefault | VisibleUnderwater | VisibleOnWater | VisibleInCombat | VisibleWvW,
-    UsableAll         = UsableDefault | UsableUnderwater | UsableOnWater | UsableInCombat | UsableWvW,
-
-    IsFlag
-};
+    return StateKey(ToGameConditions(cs));
+}
 
 inline bool IsUsable(ConditionalState cs, ConditionalProperties cp)
 {
-    if (IsNone(cs) && IsNone(cp & ConditionalProperties::UsableDefault))
-        return false;
-    if (NotNone(cs & ConditionalState::InWvW) && IsNone(cp & ConditionalProperties::UsableWvW))
-        return false;
-
-    if (NotNone(cs & ConditionalState::InCombat) && IsNone(cp & ConditionalProperties::UsableInCombat))
-        return false;
-    if (NotNone(cs & ConditionalState::Underwater) && IsNone(cp & ConditionalProperties::UsableUnderwater))
-        return false;
-    if (NotNone(cs & ConditionalState::OnWater) && IsNone(cp & ConditionalProperties::UsableOnWater))
-        return false;
-
-    return true;
+    return (StateKey(cs) & ~UsableStates(cp)) == 0;
 }
 
 inline bool IsVisible(ConditionalState cs, ConditionalProperties cp)
 {
-    if (IsNone(cs) && IsNone(cp & ConditionalProperties::VisibleDefault))
-        return false;
-    if (NotNone(cs & ConditionalState::InWvW) && IsNone(cp & ConditionalProperties::VisibleWvW))
-        return false;
-
-    if (NotNone(cs & ConditionalState::InCombat) && IsNone(cp & ConditionalProperties::VisibleInCombat))
-        return false;
-    if (NotNone(cs & ConditionalState::Underwater) && IsNone(cp & ConditionalProperties::VisibleUnderwater))
-        return false;
-    if (NotNone(cs & ConditionalState::OnWater) && IsNone(cp & ConditionalProperties::VisibleOnWater))
-        return false;
-
-    return true;
+    return (StateKey(cs) & ~VisibleStates(cp)) == 0;
 }
 
 class WheelElement
 {
 public:
     WheelElement(u32 id, const std::string& nickname, const std::string& category, const std::string& displayName, const glm::vec4& color, ConditionalProperties defaultProps,
-                 Texture2D tex = {});
+                 Texture2D tex = {}, const std::optional<AtlasRect>& texRegion = std::nullopt);
     virtual ~WheelElement() = default;
 
     int  DrawPriority(int extremumIndicator);
 
+    // Matches WheelElementInstance in ScreenQuad.hlsl
+    struct Instance
+    {
+        glm::vec4 spriteDimensions;
+        glm::vec4 color;
+        glm::vec4 uvRect;
+        float     hoverFadeIn;
+        float     spriteZ;
+        u32       flags; // InstanceFlags
+        u32       slice;
+    };
+    static_assert(sizeof(Instance) % 16 == 0);
+
+    // Match the ELEMENT_* defines in common.hlsli
+    enum InstanceFlags : u32
+    {
+        PremultiplyAlphaFlag = 1,
+        DistanceFieldFlag    = 2,
+    };
+
+    // Shadow and icon
+    static constexpr u32 MaxInstancesPerElement = 2;
+
     void SetShaderState(ID3D11DeviceContext* ctx) const;
-    void SetShaderState(ID3D11DeviceContext* ctx, const vec4& spriteDimensions, const ComPtr<ID3D11Buffer>& wheelCb, bool shadow, float hoverRatio) const;
-    void Draw(ID3D11DeviceContext* ctx, int n, vec4 spriteDimensions, size_t activeElementsCount, const mstime& currentTime, const WheelElement* elementHovered,
-              const class Wheel* parent);
+    u32  FillInstances(Instance* instances, int n, size_t activeElementsCount, const glm::vec4& spriteDimensions, const mstime& currentTime, const class Wheel* parent) const;
 
     u32  elementId() const
     {
@@ -167,6 +148,8 @@ public:
         return color_;
     }
 
+    glm::vec4 adjustedColor() const;
+
     void color(const glm::vec4& c)
     {
         color_ = c;
@@ -197,24 +180,25 @@ public:
         props_.value(p);
     }
 
-    [[nodiscard]] bool isUsable(ConditionalState cs) const
+    [[nodiscard]] const ElementGate& gate() const
+    {
+        return gate_;
+    }
+
+    [[nodiscard]] ElementConditions conditions() const
+    {
+        return { VisibleStates(props_.value()), UsableStates(props_.value()), isBound(), gate_ };
+    }
+
+    // stateWord is the owning wheel's Wheel::PackStateWord(); whole wheels are evaluated at once through ElementPredicateTable
+    [[nodiscard]] bool isUsable(ConditionalState cs, u64 stateWord) const
     {
-        // If customBehaviorIsPrecheck is true, behavior acts as AND (pre-check before props)
-        // Otherwise it acts as OR (override that bypasses props)
-        if (customBehaviorIsPrecheck_)
-            return customBehavior_(false) && isBound() && IsUsable(cs, props_.value());
-        else
-            return customBehavior_(false) || isBound() && IsUsable(cs, props_.value());
+        return EvaluateElement(UsableStates(props_.value()), StateKey(cs), isBound(), gate_.mode, gate_.passes(stateWord));
     }
 
-    [[nodiscard]] bool isVisible(ConditionalState cs) const
+    [[nodiscard]] bool isVisible(ConditionalState cs, u64 stateWord) const
     {
-        // If customBehaviorIsPrecheck is true, behavior acts as AND (pre-check before props)
-        // Otherwise it acts as OR (override that bypasses props)
-        if (customBehaviorIsPrecheck_)
-            return customBehavior_(true) && isBound() && IsVisible(cs, props_.value());
-        else
-            return customBehavior_(true) || isBound() && IsVisible(cs, props_.value());
+        return EvaluateElement(VisibleStates(props_.value()), StateKey(cs), isBound(), gate_.mode, gate_.passes(stateWord));
     }
 
     // Action chain support - multiple keybinds triggered in sequence
@@ -268,19 +252,19 @@ public:
         return appearance_;
     }
 
-    void customBehavior(std::function<bool(bool)> behavior)
+    // The element is available whenever all required state word bits are set, regardless of props, which are cleared
+    void customBehavior(u64 requiredStateBits)
     {
-        customBehavior_ = behavior;
+        gate_ = { GateMode::Override, requiredStateBits };
         props_.value(ConditionalProperties::None);
         disableBehaviorControls_ = true;
     }
 
     // Set custom behavior as a pre-check (AND) instead of override (OR)
     // This allows combining custom logic with props evaluation
-    void customBehaviorKeepProps(std::function<bool(bool)> behavior)
+    void customBehaviorKeepProps(u64 requiredStateBits)
     {
-        customBehavior_ = behavior;
-        customBehaviorIsPrecheck_ = true;
+        gate_ = { GateMode::Precheck, requiredStateBits };
         // Don't modify props or disableBehaviorControls - keep them as-is
     }
 
@@ -292,6 +276,8 @@ protected:
     u32                                        elementId_;
     Keybind                                    keybind_;
     Texture2D                                  appearance_;
+    glm::vec4                                  appearanceUvRect_{ 0.f, 0.f, 1.f, 1.f };
+    IconAtlas::EntryHandle                     atlasEntry_; // after appearance_, which it points into
     mstime                                     currentHoverTime_        = 0;
     mstime                                     currentExitTime_         = 0;
 
@@ -303,15 +289,14 @@ protected:
     float                                      colorizeAmount_          = 1.f;
     float                                      texWidth_                = 0.f;
     bool                                       premultiplyAlpha_        = false;
-    std::function<bool(bool)>                  customBehavior_          = [](bool) { return false; };
-    bool                                       customBehaviorIsPrecheck_ = false;
+    ElementGate                                gate_;
     bool                                       disableBehaviorControls_ = false;
     glm::vec4                                  color_{};
 
     struct WheelElementCB
     {
         glm::vec4 adjustedColor;
-        float     elementHoverFadeIn;
+        glm::vec4 iconUvRect;
         bool      premultiplyAlpha;
     };
 
@@ -0,0 +1,41 @@
+#pragma once
+#include <PlatformTypes.h>
+#include <cstdint>
+
+namespace GW2Radial
+{
+// A wheel's favorite element for each game state, packed into the one word the configuration stores. Each field is an index
+// into the wheel's elements, or -1 to fall back to the baseline. The fields are six bits wide and their layout is what existing
+// configurations hold, so only the first MaxIndex + 1 elements of a wheel can be picked as favorites, however many it has.
+union WheelFavorite
+{
+    std::uint32_t value;
+    struct Bitmask
+    {
+        int baseline : 6;
+
+        int inCombat : 6;
+        int onWater : 6;
+        int underwater : 6;
+        int inWvW : 6;
+    } bits;
+    static_assert(sizeof(Bitmask) == sizeof(std::uint32_t));
+
+    // Largest element index a 6-bit signed field can store
+    static constexpr int MaxIndex = 31;
+
+    // The index chosen for the given GameCondition flags; WvW takes precedence, then combat, water surface and underwater
+    [[nodiscard]] int Pick(std::uint32_t conditions) const
+    {
+        if ((conditions & GameCondition::InWvW) && bits.inWvW != -1)
+            return bits.inWvW;
+        if ((conditions & GameCondition::InCombat) && bits.inCombat != -1)
+            return bits.inCombat;
+        if ((conditions & GameCondition::OnWater) && bits.onWater != -1)
+            return bits.onWater;
+        if ((conditions & GameCondition::Underwater) && bits.underwater != -1)
+            return bits.underwater;
+        return bits.baseline;
+    }
+};
+} // namespace GW2Radial
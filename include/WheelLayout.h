@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+namespace GW2Radial
+{
+// Screen-space placement of a single element within the ring, independent of any rendering backend
+struct ElementLayout
+{
+    glm::vec4 spriteDimensions;
+    glm::vec4 shadowSpriteDimensions;
+    float     spriteZ;
+    float     shadowSpriteZ;
+};
+
+// Computes where element n of activeElementsCount is drawn, given the wheel's sprite dimensions (center xy, half-extents zw),
+// the element's smoothed hover ratio and its texture aspect ratio (height / width)
+ElementLayout ComputeElementLayout(int n, size_t activeElementsCount, glm::vec4 spriteDimensions, float hoverTimer, float aspectRatio);
+
+// Resolves which sector of the ring a cursor offset falls in without any trigonometry. Sector 0 is centered straight up and
+// sectors proceed clockwise on screen, matching ComputeElementLayout. Boundaries are stored as direction vectors bucketed by
+// octant, so a lookup is three sign/magnitude comparisons followed by a short search of cross products within one octant.
+class SectorTable
+{
+public:
+    // Equal-width sectors, identical to splitting the circle into count slices centered on each element
+    void                 BuildUniform(size_t count);
+    // Sector widths proportional to weights; non-positive weights produce empty sectors which are never resolved
+    void                 Build(std::span<const float> weights);
+
+    [[nodiscard]] size_t sectorCount() const
+    {
+        return sectorCount_;
+    }
+
+    // offset is relative to the wheel center in screen orientation (y down); must not be called on an empty table
+    [[nodiscard]] size_t Resolve(glm::vec2 offset) const;
+
+private:
+    struct Boundary
+    {
+        glm::vec2     direction;
+        std::uint32_t sector;
+    };
+    struct Octant
+    {
+        std::uint32_t firstSector = 0;
+        std::uint32_t begin = 0, end = 0;
+    };
+
+    std::vector<Boundary>  boundaries_;
+    std::array<Octant, 8>  octants_{};
+    size_t                 sectorCount_ = 0;
+};
+} // namespace GW2Radial
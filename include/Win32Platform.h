@@ -0,0 +1,67 @@
+#pragma once
+#include <Input.h>
+#include <Platform.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace GW2Radial
+{
+// The in-game platform: MumbleLink for game state, the shared Input instance for keybinds, ImGui and Win32 for the cursor
+class Win32Platform : public Clock, public InputSink, public InputEvents, public GameStateSource, public Cursor, public Renderer
+{
+public:
+    [[nodiscard]] Platform         platform(GameStateMonitor& monitor)
+    {
+        return { this, this, this, this, this, this, &monitor };
+    }
+
+    [[nodiscard]] PlatformTime     now() const override;
+
+    void                           SendKeybind(const KeyChord& keys, std::optional<glm::ivec2> cursorPos) override;
+    void                           KeyUpActive() override;
+    bool                           PressKeybindNow(const KeyChord& keys) override;
+    void                           ReleaseKeybindNow(const KeyChord& keys) override;
+
+    SubscriptionId                 SubscribeMouseMove(MouseMoveHandler handler) override;
+    SubscriptionId                 SubscribeMouseButton(MouseButtonHandler handler) override;
+    void                           Unsubscribe(SubscriptionId id) override;
+
+    [[nodiscard]] std::uint32_t    currentState() const override;
+    [[nodiscard]] bool             gameHasFocus() const override;
+    [[nodiscard]] bool             isMapOpen() const override;
+    [[nodiscard]] bool             isMounted() const override;
+    [[nodiscard]] bool             isInWvW() const override;
+    [[nodiscard]] std::uint32_t    uiScale() const override;
+
+    [[nodiscard]] glm::vec2        position() const override;
+    [[nodiscard]] glm::vec2        livePosition() const override;
+    bool                           CenterInWindow() override;
+
+    [[nodiscard]] glm::ivec2       screenSize() const override;
+    [[nodiscard]] float            dpiScale() const override;
+
+    // Sends the keybinds PressKeybindNow could not inject itself; called once per update from the main thread
+    void                           FlushDeferredKeybinds();
+
+private:
+    struct Subscription
+    {
+        bool                button;
+        EventCallbackHandle handle;
+    };
+
+    struct PressedKeybind
+    {
+        KeyChord        keys;
+        ModifierChanges modifiers;
+    };
+
+    std::mutex                                       deferredMutex_;
+    std::vector<KeyCombo>                            deferredKeybinds_;
+    // Executor thread only
+    std::vector<PressedKeybind>                      pressedKeybinds_;
+    std::unordered_map<SubscriptionId, Subscription> subscriptions_;
+    SubscriptionId                                   nextSubscription_ = 1;
+};
+} // namespace GW2Radial
@@ -0,0 +1,23 @@
+cbuffer AtlasBlit : register(b0)
+{
+	float4 sourceUvTransform;
+	float4 sourceUvClamp;
+	float4 distanceField; // x: source is a distance field
+};
+
+SamplerState BlitSampler : register(s0);
+Texture2D<float4> SourceTexture : register(t0);
+
+struct PS_INPUT
+{
+	float4 pos : SV_Position;
+	float2 UV : TEXCOORD0;
+};
+
+float4 AtlasBlit(PS_INPUT In) : SV_Target
+{
+	float2 uv = clamp(sourceUvTransform.xy + In.UV * sourceUvTransform.zw, sourceUvClamp.xy, sourceUvClamp.zw);
+	float4 color = SourceTexture.Sample(BlitSampler, uv);
+	// Distance fields are kept as they are, WheelElement.hlsl decodes them
+	return distanceField.x == 0 ? color : color.rrrr;
+}
\ No newline at end of file
@@ -11,18 +11,67 @@ struct VS_SCREEN
 	float2 UV : TEXCOORD0;
 };
 
+// Must match WheelElement::Instance
+struct WheelElementInstance
+{
+	float4 spriteDimensions;
+	float4 color;
+	float4 uvRect;
+	float hoverFadeIn;
+	float spriteZ;
+	uint flags;
+	uint slice;
+};
+
+StructuredBuffer<WheelElementInstance> ElementInstances : register(t0);
+
+struct VS_ELEMENT
+{
+	float4 Position : SV_Position;
+	float2 UV : TEXCOORD0;
+	nointerpolation float4 color : COLOR0;
+	nointerpolation float hoverFadeIn : TEXCOORD1;
+	nointerpolation uint flags : TEXCOORD2;
+	nointerpolation uint slice : TEXCOORD3;
+};
+
+float4 ProjectSprite(float2 UV, float4 dimensions, float z)
+{
+	float2 dims = (UV * 2 - 1) * dimensions.zw;
+
+	float4 Position = mul(float4(dims + dimensions.xy * 2 - 1, z, 1.f), tiltMatrix);
+	Position.z += saturate(0.5f - z);
+	Position.y *= -1;
+
+	return Position;
+}
+
 VS_SCREEN ScreenQuad(in uint  id : SV_VertexID)
 {
     VS_SCREEN Out = (VS_SCREEN)0;
 
 	float2 UV = float2(id & 1, id >> 1);
 
-	float2 dims = (UV * 2 - 1) * spriteDimensions.zw;
-
     Out.UV = UV;
-    Out.Position = mul(float4(dims + spriteDimensions.xy * 2 - 1, spriteZ, 1.f), tiltMatrix);
-	Out.Position.z += saturate(0.5f - spriteZ);
-	Out.Position.y *= -1;
+    Out.Position = ProjectSprite(UV, spriteDimensions, spriteZ);
+
+    return Out;
+}
+
+VS_ELEMENT WheelElementInstanced(in uint id : SV_VertexID, in uint instanceId : SV_InstanceID)
+{
+    VS_ELEMENT Out = (VS_ELEMENT)0;
+
+	WheelElementInstance inst = ElementInstances[instanceId];
+
+	float2 UV = float2(id & 1, id >> 1);
+
+    Out.UV = inst.uvRect.xy + UV * inst.uvRect.zw;
+    Out.Position = ProjectSprite(UV, inst.spriteDimensions, inst.spriteZ);
+    Out.color = inst.color;
+    Out.hoverFadeIn = inst.hoverFadeIn;
+    Out.flags = inst.flags;
+    Out.slice = inst.slice;
 
     return Out;
 }
\ No newline at end of file
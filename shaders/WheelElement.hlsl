@@ -1,14 +1,25 @@
 #include "common.hlsli"
 
-float4 WheelElement(PS_INPUT In) : SV_Target
+float4 WheelElement(PS_ELEMENT_INPUT In) : SV_Target
 {
-	float shadow;
-	float4 color = BaseMountImage(In.UV, IconTexture, MainSampler, shadow);
+	float4 color = IconAtlas.Sample(MainSampler, float3(In.UV, In.slice));
+	if (In.flags & ELEMENT_DISTANCE_FIELD)
+	{
+		// White fill inside the 0.5 edge, black outline out to the outline edge, both antialiased over about one screen pixel
+		float d = color.r;
+		float aa = max(fwidth(d) * 0.5, 1e-4);
+		float fill = smoothstep(0.5 - aa, 0.5 + aa, d);
+		float outline = smoothstep(DISTANCE_FIELD_OUTLINE_EDGE - aa, DISTANCE_FIELD_OUTLINE_EDGE + aa, d);
+		color = float4(fill.xxx, outline);
+	}
+	if (In.flags & ELEMENT_PREMULTIPLY_ALPHA)
+		color.rgb *= color.a;
+	color *= In.color;
 	
 	const float3 lumaDot = float3(0.2126, 0.7152, 0.0722);
 	float luma = dot(color.rgb, lumaDot);
 	float3 fadedColor = lerp(color.rgb, luma, 0.4f);
-	float3 finalColor = lerp(fadedColor, color.rgb, elementHoverFadeIn);
+	float3 finalColor = lerp(fadedColor, color.rgb, In.hoverFadeIn);
 
 	return float4(finalColor.rgb, color.a) * wheelFadeIn.x * globalOpacity;
 }
\ No newline at end of file
@@ -1,7 +1,6 @@
 #define PI 3.14159f
 #define SQRT2 1.4142136f
 #define ONE_OVER_SQRT2 0.707107f
-#define WHEEL_MAX_ELEMENT_COUNT 20
 #include "noise.hlsl"
 
 cbuffer Wheel : register(b0)
@@ -12,20 +11,28 @@ cbuffer Wheel : register(b0)
 	float centerScale;
 	int elementCount;
 	float globalOpacity;
-	float4 hoverFadeIns_[WHEEL_MAX_ELEMENT_COUNT/4];
 	float timeLeft;
 	bool showIcon;
 };
 
+// One entry per visible element, followed by one for the center region (index elementCount)
+struct WheelElementData
+{
+	float hoverFadeIn;
+	float3 padding; // keeps the stride at 16 bytes
+};
+
+StructuredBuffer<WheelElementData> ElementData : register(t2);
+
 float GetHoverFadeIn(int i)
 {
-	return hoverFadeIns_[i >> 2][i & 3];
+	return ElementData[i].hoverFadeIn;
 }
 
 cbuffer WheelElement : register(b1)
 {
 	float4 adjustedColor;
-	float elementHoverFadeIn;
+	float4 iconUvRect;
 	bool premultiplyAlpha;
 };
 
@@ -35,6 +42,7 @@ SamplerState SecondarySampler : register(s1);
 Texture2D<float4> BackgroundTexture : register(t0);
 Texture2D<float4> WipeMaskTexture : register(t1);
 Texture2D<float4> IconTexture : register(t1);
+Texture2DArray<float4> IconAtlas : register(t3);
 
 struct PS_INPUT
 {
@@ -42,6 +50,24 @@ struct PS_INPUT
 	float2 UV : TEXCOORD0;
 };
 
+// WheelElement::InstanceFlags
+#define ELEMENT_PREMULTIPLY_ALPHA 1
+#define ELEMENT_DISTANCE_FIELD 2
+
+// Distance field value the outline of distance field icons reaches out to, the shape's edge being at 0.5
+#define DISTANCE_FIELD_OUTLINE_EDGE 0.35f
+
+// Output of WheelElementInstanced in ScreenQuad.hlsl
+struct PS_ELEMENT_INPUT
+{
+	float4 pos : SV_Position;
+	float2 UV : TEXCOORD0;
+	nointerpolation float4 color : COLOR0;
+	nointerpolation float hoverFadeIn : TEXCOORD1;
+	nointerpolation uint flags : TEXCOORD2;
+	nointerpolation uint slice : TEXCOORD3;
+};
+
 float2 makeSmoothRandom(float2 uv, float4 scales, float4 timeScales)
 {
 	float smoothrandom1 = sin(scales.x * uv.x + animationTimer * timeScales.x) + sin(scales.y * uv.y + animationTimer * timeScales.y);
@@ -63,7 +89,9 @@ float rescale(float value, float2 bounds)
 
 float4 BaseMountImage(float2 uv, texture2D tex, SamplerState samp, out float shadow) {
 	shadow = 0;
-	float4 color = tex.Sample(samp, uv);
+	// The icon may only cover part of the texture, treat anything outside of it like the border color
+	float4 color = tex.Sample(samp, iconUvRect.xy + saturate(uv) * iconUvRect.zw);
+	color *= all(uv == saturate(uv));
 	if (premultiplyAlpha)
 		color.rgb *= color.a;
 	color *= adjustedColor;
@@ -0,0 +1,146 @@
+#include <ActionChainExecutor.h>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace GW2Radial
+{
+ActionChainExecutor::ActionChainExecutor()
+{
+#ifdef _WIN32
+    // High resolution timers need Windows 10 1803; older systems get the regular timer and its coarser resolution
+    timer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer_)
+        timer_ = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    wakeEvent_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+#endif
+
+    thread_ = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+}
+
+ActionChainExecutor::~ActionChainExecutor()
+{
+    thread_.request_stop();
+    Wake();
+    thread_.join();
+
+#ifdef _WIN32
+    if (timer_)
+        CloseHandle(timer_);
+    if (wakeEvent_)
+        CloseHandle(wakeEvent_);
+#endif
+}
+
+ActionChainExecutor::Handle ActionChainExecutor::Submit(std::vector<Step> steps, Clock::time_point start)
+{
+    auto    state = std::make_shared<ChainState>();
+
+    Pending pending{ state, std::move(steps), 0, start };
+    {
+        std::lock_guard lock(submitMutex_);
+        if (!submissions_.TryPush(pending))
+            return nullptr;
+    }
+
+    Wake();
+    return state;
+}
+
+void ActionChainExecutor::AppendKeybind(std::vector<Step>& steps, std::function<bool()> press, std::function<void()> release,
+                                        std::chrono::microseconds delayAfter)
+{
+    const std::chrono::microseconds hold = KeyHold;
+    steps.push_back({ std::move(press), hold, hold });
+    steps.push_back({ [release = std::move(release)]
+                      {
+                          release();
+                          return true;
+                      },
+                      std::max(delayAfter - hold, std::chrono::microseconds::zero()), {}, true });
+}
+
+void ActionChainExecutor::Run(std::stop_token stopToken)
+{
+    while (!stopToken.stop_requested())
+    {
+        while (auto pending = submissions_.TryPop())
+            running_.push_back(std::move(*pending));
+
+        std::optional<Clock::time_point> next;
+        for (size_t i = 0; i < running_.size();)
+        {
+            auto& chain = running_[i];
+            while (!chain.state->cancelled && chain.next < chain.steps.size() && chain.due <= Clock::now())
+            {
+                const auto& step = chain.steps[chain.next++];
+                if (step.send && !step.send())
+                {
+                    chain.state->dropped   = true;
+                    chain.state->cancelled = true;
+                }
+                chain.due = std::max(chain.due + step.delayAfter, Clock::now() + step.minDelayAfter);
+            }
+
+            if (chain.state->cancelled || chain.next >= chain.steps.size())
+            {
+                for (; chain.next < chain.steps.size() && chain.steps[chain.next].always; chain.next++)
+                    if (const auto& step = chain.steps[chain.next]; step.send)
+                        step.send();
+
+                chain.state->finished = true;
+                std::swap(chain, running_.back());
+                running_.pop_back();
+                continue;
+            }
+
+            next = next ? std::min(*next, chain.due) : chain.due;
+            i++;
+        }
+
+        WaitUntil(next);
+    }
+}
+
+void ActionChainExecutor::WaitUntil(std::optional<Clock::time_point> due)
+{
+#ifdef _WIN32
+    if (!due || !timer_)
+    {
+        WaitForSingleObject(wakeEvent_, due ? 1 : INFINITE);
+        return;
+    }
+
+    // Relative due time, in 100ns units
+    const auto    wait = std::chrono::duration_cast<std::chrono::nanoseconds>(*due - Clock::now()).count();
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -std::max<LONGLONG>(wait / 100, 1);
+    if (!SetWaitableTimerEx(timer_, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+        return;
+
+    HANDLE handles[] = { timer_, wakeEvent_ };
+    WaitForMultipleObjects(DWORD(std::size(handles)), handles, FALSE, INFINITE);
+    CancelWaitableTimer(timer_);
+#else
+    // With nothing due, the loop simply comes around again after a while
+    std::unique_lock lock(wakeMutex_);
+    wakeCondition_.wait_until(lock, due.value_or(Clock::now() + std::chrono::seconds(1)), [&] { return wakePending_; });
+    wakePending_ = false;
+#endif
+}
+
+void ActionChainExecutor::Wake()
+{
+#ifdef _WIN32
+    SetEvent(wakeEvent_);
+#else
+    {
+        std::lock_guard lock(wakeMutex_);
+        wakePending_ = true;
+    }
+    wakeCondition_.notify_one();
+#endif
+}
+} // namespace GW2Radial
@@ -0,0 +1,156 @@
+#include <ActionQueue.h>
+#include <algorithm>
+#include <utility>
+
+namespace GW2Radial
+{
+ActionQueue::Id ActionQueue::Push(Request request, std::int64_t now)
+{
+    const Id id    = nextId_++;
+    auto&    entry = entries_[id];
+    entry.request  = std::move(request);
+
+    // Evaluated on the next update rather than here, so callbacks never run from inside the caller's Push
+    Schedule(id, entry, std::max(now, entry.request.notBefore));
+    return id;
+}
+
+bool ActionQueue::Cancel(Id id)
+{
+    if (!entries_.contains(id))
+        return false;
+
+    Finish(id, Outcome::Cancelled);
+    return true;
+}
+
+void ActionQueue::CancelOwner(const void* owner)
+{
+    std::vector<Id> ids;
+    for (const auto& [id, entry] : entries_)
+        if (entry.request.owner == owner)
+            ids.push_back(id);
+
+    // Oldest first, so owners observe cancellations in queuing order
+    std::ranges::sort(ids);
+    for (Id id : ids)
+        Cancel(id);
+}
+
+void ActionQueue::Update(std::int64_t now, bool conditionsChanged)
+{
+    if (conditionsChanged)
+    {
+        std::vector<Id> ids;
+        ids.reserve(entries_.size());
+        for (const auto& [id, entry] : entries_)
+            ids.push_back(id);
+
+        std::ranges::sort(ids);
+        for (Id id : ids)
+            Wake(id, now);
+    }
+
+    while (!deadlines_.empty() && deadlines_.top().time <= now)
+    {
+        const auto deadline = deadlines_.top();
+        deadlines_.pop();
+
+        // Rescheduling leaves the old heap node behind; only the latest generation counts
+        auto it = entries_.find(deadline.id);
+        if (it == entries_.end() || it->second.generation != deadline.generation)
+            continue;
+
+        Wake(deadline.id, now);
+    }
+}
+
+std::optional<std::int64_t> ActionQueue::nextDeadline() const
+{
+    while (!deadlines_.empty())
+    {
+        const auto& top = deadlines_.top();
+        auto        it  = entries_.find(top.id);
+        if (it != entries_.end() && it->second.generation == top.generation)
+            return top.time;
+
+        deadlines_.pop();
+    }
+
+    return std::nullopt;
+}
+
+void ActionQueue::Schedule(Id id, Entry& entry, std::int64_t time)
+{
+    entry.generation++;
+    deadlines_.push({ std::min(time, entry.request.expiry), id, entry.generation });
+}
+
+void ActionQueue::Wake(Id id, std::int64_t now)
+{
+    auto it = entries_.find(id);
+    if (it == entries_.end())
+        return;
+
+    auto& entry = it->second;
+    auto& req   = entry.request;
+
+    if (now >= req.expiry)
+    {
+        Finish(id, Outcome::Expired);
+        return;
+    }
+
+    if (now < req.notBefore)
+    {
+        Schedule(id, entry, req.notBefore);
+        return;
+    }
+
+    if (!req.ready())
+    {
+        // Nothing to do until the conditions change or the entry expires
+        entry.passingSince.reset();
+        Schedule(id, entry, req.expiry);
+        return;
+    }
+
+    if (!entry.passingSince)
+        entry.passingSince = now;
+
+    if (const auto sendAt = *entry.passingSince + req.sendDelay; now < sendAt)
+    {
+        Schedule(id, entry, sendAt);
+        return;
+    }
+
+    // The callback may push or cancel entries, including this one, which would destroy it while it runs; call it from a local
+    // and look the entry up again afterwards
+    auto       send  = std::move(req.send);
+    const bool retry = send();
+
+    it               = entries_.find(id);
+    if (it == entries_.end())
+        return;
+
+    if (retry && it->second.request.retryInterval > 0)
+    {
+        it->second.request.send      = std::move(send);
+        it->second.request.notBefore = now + it->second.request.retryInterval;
+        it->second.passingSince.reset();
+        Schedule(id, it->second, it->second.request.notBefore);
+    }
+    else
+        Finish(id, Outcome::Sent);
+}
+
+void ActionQueue::Finish(Id id, Outcome outcome)
+{
+    auto node = entries_.extract(id);
+    if (node.empty())
+        return;
+
+    if (node.mapped().request.finished)
+        node.mapped().request.finished(id, outcome);
+}
+} // namespace GW2Radial
@@ -0,0 +1,173 @@
+#include <AssetCache.h>
+#include <Core.h>
+#include <Log.h>
+#include <cstring>
+#include <xxhash.h>
+
+namespace GW2Radial
+{
+AssetCache::AssetCache(std::filesystem::path path)
+    : path_(std::move(path))
+    , writer_(path_, [this] { return Serialize(); }, FlushDelay)
+{
+    Open();
+}
+
+AssetCache::~AssetCache()
+{
+    Flush();
+}
+
+void AssetCache::Open()
+{
+    reader_.Close();
+    file_.reset();
+
+    if (path_.empty() || !std::filesystem::exists(path_))
+        return;
+
+    file_.emplace(path_);
+    if (!reader_.Open(file_->data()))
+    {
+        LogInfo("Asset cache '{}' is missing or out of date, it will be rebuilt.", utf8_encode(path_.wstring()));
+        reader_.Close();
+        file_.reset();
+    }
+}
+
+std::optional<AssetCache::Image> AssetCache::Find(u64 key)
+{
+    if (path_.empty())
+        return std::nullopt;
+
+    std::lock_guard lk(mutex_);
+
+    if (auto it = stored_.find(key); it != stored_.end())
+        return it->second;
+
+    auto blob = reader_.Find(key);
+    if (!blob || blob->format != BlobCache::Format::RGBA8 || blob->data.size() != size_t(blob->width) * blob->height * 4)
+        return std::nullopt;
+
+    used_.insert(key);
+
+    return Image{ blob->width, blob->height, std::vector<u8>(blob->data.begin(), blob->data.end()) };
+}
+
+void AssetCache::Store(u64 key, u32 width, u32 height, std::vector<u8> pixels)
+{
+    if (path_.empty())
+        return;
+
+    GW2_ASSERT(pixels.size() == size_t(width) * height * 4);
+
+    std::lock_guard lk(mutex_);
+    stored_[key] = Image{ width, height, std::move(pixels) };
+    writer_.MarkDirty({});
+}
+
+void AssetCache::QueueReadback(ID3D11DeviceContext* ctx, ID3D11Texture2D* source, const AtlasRect& rect, u64 key)
+{
+    if (path_.empty())
+        return;
+
+    Readback rb{ nullptr, rect.width, rect.height, key };
+
+    CD3D11_TEXTURE2D_DESC desc(DXGI_FORMAT_R8G8B8A8_UNORM, rect.width, rect.height, 1, 1, 0, D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
+    if (FAILED(Core::i().device()->CreateTexture2D(&desc, nullptr, rb.staging.GetAddressOf())))
+        return;
+
+    const D3D11_BOX box{ rect.x, rect.y, 0, rect.x + rect.width, rect.y + rect.height, 1 };
+    ctx->CopySubresourceRegion(rb.staging.Get(), 0, 0, 0, 0, source, 0, &box);
+
+    readbacks_.push_back(std::move(rb));
+}
+
+void AssetCache::Update(ID3D11DeviceContext* ctx)
+{
+    // Readbacks are only collected once the GPU has caught up, so the render thread never stalls on them
+    std::erase_if(readbacks_,
+                  [&](const Readback& rb)
+                  {
+                      D3D11_MAPPED_SUBRESOURCE mapped;
+                      HRESULT                  hr = ctx->Map(rb.staging.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+                      if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+                          return false;
+                      if (FAILED(hr))
+                          return true;
+
+                      std::vector<u8> pixels(size_t(rb.width) * rb.height * 4);
+                      for (u32 y = 0; y < rb.height; y++)
+                          std::memcpy(pixels.data() + size_t(y) * rb.width * 4, static_cast<const u8*>(mapped.pData) + size_t(y) * mapped.RowPitch, rb.width * 4);
+                      ctx->Unmap(rb.staging.Get(), 0);
+
+                      Store(rb.key, rb.width, rb.height, std::move(pixels));
+                      return true;
+                  });
+
+    std::lock_guard lk(mutex_);
+    // Readbacks still in flight are about to be stored, so writing waits for them
+    if (readbacks_.empty())
+        writer_.Update();
+
+    // A failed write is retried after another idle interval; warn once until one goes through
+    if (writer_.lastWriteFailed() && !failureLogged_)
+        Log::i().Print(Severity::Warn, "Could not write asset cache '{}', retrying.", utf8_encode(path_.wstring()));
+    failureLogged_ = writer_.lastWriteFailed();
+}
+
+void AssetCache::Flush()
+{
+    std::lock_guard lk(mutex_);
+    if (!writer_.Flush())
+        Log::i().Print(Severity::Warn, "Could not write asset cache '{}'.", utf8_encode(path_.wstring()));
+}
+
+std::optional<std::string> AssetCache::Serialize()
+{
+    BlobCache::Writer writer;
+    for (u64 key : used_)
+        if (auto blob = reader_.Find(key))
+            writer.Add(key, blob->width, blob->height, blob->format, blob->data);
+    for (const auto& [key, image] : stored_)
+        writer.Add(key, image.width, image.height, BlobCache::Format::RGBA8, image.pixels);
+
+    // Serving lookups from the new contents releases the mapping, which must happen before the file can be replaced, and keeps
+    // every entry around whether or not the write goes through
+    reader_.Close();
+    file_.reset();
+    contents_ = writer.Serialize();
+    if (!reader_.Open(contents_))
+        return std::nullopt;
+
+    for (const auto& [key, image] : stored_)
+        used_.insert(key);
+    stored_.clear();
+
+    std::error_code ec;
+    std::filesystem::create_directories(path_.parent_path(), ec);
+
+    return std::string(reinterpret_cast<const char*>(contents_.data()), contents_.size());
+}
+
+u64 AssetCache::LabelKey(ImFont* font, float fontSize, const std::string& text, u32 width, u32 height, u32 style)
+{
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+
+    const std::string_view fontName = font->GetDebugName();
+    XXH3_64bits_update(&state, fontName.data(), fontName.size());
+    XXH3_64bits_update(&state, &fontSize, sizeof(fontSize));
+    XXH3_64bits_update(&state, &width, sizeof(width));
+    XXH3_64bits_update(&state, &height, sizeof(height));
+    XXH3_64bits_update(&state, &style, sizeof(style));
+    XXH3_64bits_update(&state, text.data(), text.size());
+
+    return XXH3_64bits_digest(&state);
+}
+
+u64 AssetCache::ContentKey(std::span<const u8> data)
+{
+    return XXH3_64bits(data.data(), data.size());
+}
+} // namespace GW2Radial
@@ -0,0 +1,150 @@
+#include <AtlasPacker.h>
+#include <algorithm>
+#include <numeric>
+
+namespace GW2Radial
+{
+AtlasPacker::AtlasPacker(uint32_t width, uint32_t height, uint32_t padding, uint32_t alignment)
+    : width_(width)
+    , height_(height)
+    , padding_(padding)
+    , alignment_(std::max(alignment, 1u))
+{
+    Reset();
+}
+
+void AtlasPacker::Reset()
+{
+    skyline_.clear();
+    skyline_.push_back({ 0, 0, width_ });
+    usedArea_ = 0;
+}
+
+std::optional<uint32_t> AtlasPacker::Fit(size_t index, uint32_t width, uint32_t height) const
+{
+    const auto& first = skyline_[index];
+    if (first.x + width > width_)
+        return std::nullopt;
+
+    uint32_t y         = first.y;
+    uint32_t widthLeft = width;
+    for (size_t i = index; widthLeft > 0; i++)
+    {
+        y = std::max(y, skyline_[i].y);
+        if (y + height > height_)
+            return std::nullopt;
+
+        widthLeft -= std::min(widthLeft, skyline_[i].width);
+    }
+
+    return y;
+}
+
+std::optional<AtlasRect> AtlasPacker::Insert(uint32_t width, uint32_t height)
+{
+    const uint32_t paddedWidth  = Align(width + padding_ * 2);
+    const uint32_t paddedHeight = Align(height + padding_ * 2);
+    if (width == 0 || height == 0 || paddedWidth > width_ || paddedHeight > height_)
+        return std::nullopt;
+
+    size_t   bestIndex  = skyline_.size();
+    uint32_t bestBottom = UINT32_MAX;
+    uint32_t bestWidth  = UINT32_MAX;
+    uint32_t bestY      = 0;
+    for (size_t i = 0; i < skyline_.size(); i++)
+    {
+        auto y = Fit(i, paddedWidth, paddedHeight);
+        if (!y)
+            continue;
+
+        const uint32_t bottom = *y + paddedHeight;
+        if (bottom < bestBottom || (bottom == bestBottom && skyline_[i].width < bestWidth))
+        {
+            bestIndex  = i;
+            bestBottom = bottom;
+            bestWidth  = skyline_[i].width;
+            bestY      = *y;
+        }
+    }
+
+    if (bestIndex == skyline_.size())
+        return std::nullopt;
+
+    const SkylineNode node{ skyline_[bestIndex].x, bestBottom, paddedWidth };
+    skyline_.insert(skyline_.begin() + bestIndex, node);
+
+    // Trim the nodes now covered by the new one
+    const uint32_t right = node.x + node.width;
+    for (size_t i = bestIndex + 1; i < skyline_.size();)
+    {
+        auto& n = skyline_[i];
+        if (n.x >= right)
+            break;
+
+        const uint32_t overlap = std::min(right - n.x, n.width);
+        n.x += overlap;
+        n.width -= overlap;
+        if (n.width == 0)
+            skyline_.erase(skyline_.begin() + i);
+        else
+            break;
+    }
+
+    // Merge neighbors at the same height
+    for (size_t i = 0; i + 1 < skyline_.size();)
+    {
+        if (skyline_[i].y == skyline_[i + 1].y)
+        {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + i + 1);
+        }
+        else
+            i++;
+    }
+
+    usedArea_ += uint64_t(paddedWidth) * paddedHeight;
+
+    return AtlasRect{ node.x + padding_, bestY + padding_, width, height };
+}
+
+AtlasRect AtlasPacker::Cell(const AtlasRect& rect) const
+{
+    return { rect.x - padding_, rect.y - padding_, Align(rect.width + padding_ * 2), Align(rect.height + padding_ * 2) };
+}
+
+std::vector<std::optional<AtlasPlacement>> PackIntoPages(std::span<const AtlasSize> sizes, uint32_t pageWidth, uint32_t pageHeight, uint32_t padding,
+                                                         uint32_t alignment)
+{
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return sizes[a].height != sizes[b].height ? sizes[a].height > sizes[b].height : sizes[a].width > sizes[b].width; });
+
+    std::vector<std::optional<AtlasPlacement>> placements(sizes.size());
+    std::vector<AtlasPacker>                   pages;
+    for (size_t i : order)
+    {
+        const auto& sz = sizes[i];
+        for (uint32_t page = 0;; page++)
+        {
+            if (page == pages.size())
+                pages.emplace_back(pageWidth, pageHeight, padding, alignment);
+
+            if (auto rect = pages[page].Insert(sz.width, sz.height))
+            {
+                placements[i] = AtlasPlacement{ page, *rect };
+                break;
+            }
+
+            // Does not even fit an empty page
+            if (pages[page].usedArea() == 0)
+            {
+                pages.pop_back();
+                break;
+            }
+        }
+    }
+
+    return placements;
+}
+} // namespace GW2Radial
@@ -0,0 +1,297 @@
+#include <BlobCache.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <xxhash.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace GW2Radial::BlobCache
+{
+namespace
+{
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t tableOffset;
+    uint64_t tableChecksum;
+};
+static_assert(sizeof(Header) == 32);
+
+constexpr uint64_t BlobAlignment = 16;
+
+uint64_t           AlignUp(uint64_t v)
+{
+    return (v + BlobAlignment - 1) & ~(BlobAlignment - 1);
+}
+
+// The contents must reach the disk before the rename does, or a crash can leave the renamed file empty or truncated
+bool WriteDurably(const std::filesystem::path& path, std::span<const uint8_t> bytes)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    bool ok = true;
+    for (size_t written = 0; ok && written < bytes.size();)
+    {
+        DWORD chunk = DWORD(std::min<size_t>(bytes.size() - written, 1u << 30)), done = 0;
+        ok          = ::WriteFile(file, bytes.data() + written, chunk, &done, nullptr) && done == chunk;
+        written += done;
+    }
+    ok = ok && FlushFileBuffers(file);
+    CloseHandle(file);
+    return ok;
+#else
+    int file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file < 0)
+        return false;
+
+    bool ok = true;
+    for (size_t written = 0; ok && written < bytes.size();)
+    {
+        const ssize_t done = write(file, bytes.data() + written, bytes.size() - written);
+        if (done < 0 && errno == EINTR)
+            continue;
+        ok = done > 0;
+        written += ok ? size_t(done) : 0;
+    }
+    ok = ok && fsync(file) == 0;
+    ok = close(file) == 0 && ok;
+    return ok;
+#endif
+}
+} // namespace
+
+bool Reader::Open(std::span<const uint8_t> file)
+{
+    Close();
+
+    Header header;
+    if (file.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != Magic || header.version != Version)
+        return false;
+
+    const uint64_t tableSize = uint64_t(header.count) * sizeof(Record);
+    if (header.tableOffset < sizeof(header) || header.tableOffset > file.size() || file.size() - header.tableOffset < tableSize)
+        return false;
+
+    const auto* table = file.data() + header.tableOffset;
+    if (XXH3_64bits(table, tableSize) != header.tableChecksum)
+        return false;
+
+    // An empty table leaves records without storage, and memcpy must not be handed a null pointer even for zero bytes
+    std::vector<Record> records(header.count);
+    if (tableSize > 0)
+        std::memcpy(records.data(), table, tableSize);
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const auto& r = records[i];
+        if (r.offset < sizeof(header) || r.offset > header.tableOffset || header.tableOffset - r.offset < r.size)
+            return false;
+        if (i > 0 && records[i - 1].key >= r.key)
+            return false;
+    }
+
+    file_    = file;
+    records_ = std::move(records);
+
+    return true;
+}
+
+void Reader::Close()
+{
+    file_ = {};
+    records_.clear();
+}
+
+std::optional<Blob> Reader::Find(uint64_t key) const
+{
+    auto it = std::lower_bound(records_.begin(), records_.end(), key, [](const Record& r, uint64_t k) { return r.key < k; });
+    if (it == records_.end() || it->key != key)
+        return std::nullopt;
+
+    const auto data = file_.subspan(size_t(it->offset), size_t(it->size));
+    if (XXH3_64bits(data.data(), data.size()) != it->checksum)
+        return std::nullopt;
+
+    return Blob{ it->key, it->width, it->height, Format(it->format), data };
+}
+
+std::vector<uint64_t> Reader::keys() const
+{
+    std::vector<uint64_t> keys;
+    keys.reserve(records_.size());
+    for (const auto& r : records_)
+        keys.push_back(r.key);
+
+    return keys;
+}
+
+void Writer::Add(uint64_t key, uint32_t width, uint32_t height, Format format, std::span<const uint8_t> data)
+{
+    std::erase_if(blobs_, [&](const auto& b) { return b.key == key; });
+    blobs_.push_back({ key, width, height, format, std::vector<uint8_t>(data.begin(), data.end()) });
+}
+
+std::vector<uint8_t> Writer::Serialize() const
+{
+    std::vector<const Pending*> sorted;
+    sorted.reserve(blobs_.size());
+    for (const auto& b : blobs_)
+        sorted.push_back(&b);
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->key < b->key; });
+
+    std::vector<Reader::Record> records;
+    records.reserve(sorted.size());
+
+    uint64_t offset = AlignUp(sizeof(Header));
+    for (const auto* b : sorted)
+    {
+        records.push_back({ b->key, offset, b->data.size(), XXH3_64bits(b->data.data(), b->data.size()), b->width, b->height, uint32_t(b->format), 0 });
+        offset = AlignUp(offset + b->data.size());
+    }
+
+    const uint64_t       tableSize = records.size() * sizeof(Reader::Record);
+
+    std::vector<uint8_t> bytes(size_t(offset + tableSize), 0);
+    for (size_t i = 0; i < sorted.size(); i++)
+        if (!sorted[i]->data.empty())
+            std::memcpy(bytes.data() + records[i].offset, sorted[i]->data.data(), sorted[i]->data.size());
+    if (tableSize > 0)
+        std::memcpy(bytes.data() + offset, records.data(), size_t(tableSize));
+
+    const Header header{ Magic, Version, uint32_t(records.size()), 0, offset, XXH3_64bits(bytes.data() + offset, size_t(tableSize)) };
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    return bytes;
+}
+
+bool Writer::WriteFile(const std::filesystem::path& path, std::span<const uint8_t> bytes)
+{
+    const auto tempPath = WriteTemporary(path, bytes);
+    return tempPath && ReplaceWithTemporary(path, *tempPath);
+}
+
+std::optional<std::filesystem::path> Writer::WriteTemporary(const std::filesystem::path& path, std::span<const uint8_t> bytes)
+{
+    auto tempPath = path;
+    tempPath += L".tmp";
+
+    if (!WriteDurably(tempPath, bytes))
+    {
+        std::error_code ec;
+        std::filesystem::remove(tempPath, ec);
+        return std::nullopt;
+    }
+
+    return tempPath;
+}
+
+bool Writer::ReplaceWithTemporary(const std::filesystem::path& path, const std::filesystem::path& tempPath)
+{
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+#ifndef _WIN32
+    // The rename itself only survives a crash once the directory entry is on disk too
+    if (int dir = open(path.has_parent_path() ? path.parent_path().c_str() : ".", O_RDONLY | O_DIRECTORY); dir >= 0)
+    {
+        fsync(dir);
+        close(dir);
+    }
+#endif
+
+    return true;
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        file_ = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return;
+    }
+
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_)
+    {
+        Close();
+        return;
+    }
+
+    data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_)
+    {
+        Close();
+        return;
+    }
+    size_ = size_t(size.QuadPart);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+        return;
+
+    buffer_.resize(size_t(in.tellg()));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(buffer_.data()), std::streamsize(buffer_.size())))
+    {
+        buffer_.clear();
+        return;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(mapping_);
+    if (file_)
+        CloseHandle(file_);
+    file_    = nullptr;
+    mapping_ = nullptr;
+#else
+    buffer_.clear();
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+} // namespace GW2Radial::BlobCache
@@ -0,0 +1,262 @@
+#include <ChatSender.h>
+#include <algorithm>
+
+namespace GW2Radial
+{
+ChatSender::ChatSender(Sink& sink)
+    : ChatSender(sink, Timing{})
+{
+}
+
+ChatSender::ChatSender(Sink& sink, Timing timing)
+    : sink_(sink)
+    , timing_(timing)
+{
+}
+
+void ChatSender::StepLatency::Record(Duration latency, bool timedOut)
+{
+    samples_[head_] = latency;
+    head_           = (head_ + 1) % Window;
+    count_          = std::min(count_ + 1, Window);
+    if (timedOut)
+        timeouts_++;
+}
+
+ChatSender::Duration ChatSender::StepLatency::Bound(Duration configured) const
+{
+    if (count_ < MinSamples)
+        return configured;
+
+    return std::clamp(2 * max(), std::min(MinBound, configured), configured);
+}
+
+ChatSender::Duration ChatSender::StepLatency::mean() const
+{
+    if (count_ == 0)
+        return {};
+
+    Duration sum{};
+    for (size_t i = 0; i < count_; i++)
+        sum += samples_[i];
+    return sum / count_;
+}
+
+ChatSender::Duration ChatSender::StepLatency::max() const
+{
+    return count_ == 0 ? Duration{} : *std::max_element(samples_.begin(), samples_.begin() + count_);
+}
+
+bool ChatSender::Enqueue(Message message)
+{
+    if (pending_.size() >= Capacity || std::ranges::find(pending_, message) != pending_.end())
+        return false;
+
+    pending_.push_back(std::move(message));
+    return true;
+}
+
+void ChatSender::Cancel()
+{
+    pending_.clear();
+    stage_ = Stage::Idle;
+    cancels_++;
+}
+
+std::optional<ChatSender::Clock::time_point> ChatSender::Advance(Clock::time_point now)
+{
+    for (;;)
+    {
+        // Cancel may come in during any sink call when the caller unlocks around them, as ChatSendWorker does. Once it has, the
+        // message it abandoned goes no further.
+        const auto cancels   = cancels_;
+        const auto cancelled = [&] { return cancels != cancels_; };
+
+        if (stage_ == Stage::Idle)
+        {
+            if (pending_.empty())
+                return std::nullopt;
+
+            current_ = std::move(pending_.front());
+            pending_.pop_front();
+            if (sink_.chatOpen() || cancelled())
+                continue;
+
+            held_ = sink_.CaptureHeld();
+            if (cancelled())
+                continue;
+            sink_.Release(held_);
+            if (cancelled())
+                continue;
+            stage_ = Stage::Opening;
+            due_   = now + timing_.beforeOpen;
+        }
+
+        if (stage_ == Stage::Typing || stage_ == Stage::Restoring)
+        {
+            // Waiting for the chat box to open or close: go on as soon as it has, or once the bound runs out
+            const bool arrived = sink_.chatOpen() == (stage_ == Stage::Typing);
+            if (cancelled())
+                continue;
+            if (!arrived && now < due_)
+                return std::min(now + Duration(timing_.poll), due_);
+
+            latencies_[size_t(CurrentFeedbackStep())].Record(now - waitStart_, !arrived);
+        }
+        else if (now < due_)
+            return due_;
+
+        // Gaps are measured from when a stage actually ran, so a late wake-up never shortens the time the game gets to react
+        switch (stage_)
+        {
+            case Stage::Opening:
+                sink_.OpenChat(current_.broadcast);
+                if (cancelled())
+                    continue;
+                stage_     = Stage::Typing;
+                waitStart_ = now;
+                due_       = now + FeedbackBound(CurrentFeedbackStep());
+                break;
+            case Stage::Typing:
+                sink_.Type(current_.text);
+                if (cancelled())
+                    continue;
+                stage_ = Stage::Submitting;
+                due_   = now + timing_.beforeSubmit;
+                break;
+            case Stage::Submitting:
+                sink_.Submit();
+                if (cancelled())
+                    continue;
+                stage_     = Stage::Restoring;
+                waitStart_ = now;
+                due_       = now + FeedbackBound(CurrentFeedbackStep());
+                break;
+            case Stage::Restoring:
+                sink_.Restore(held_);
+                if (cancelled())
+                    continue;
+                stage_ = Stage::Idle;
+                break;
+            case Stage::Idle:
+                break;
+        }
+    }
+}
+
+ChatSender::FeedbackStep ChatSender::CurrentFeedbackStep() const
+{
+    if (stage_ == Stage::Typing)
+        return current_.broadcast ? FeedbackStep::OpenBroadcast : FeedbackStep::OpenChat;
+    else
+        return current_.broadcast ? FeedbackStep::CloseBroadcast : FeedbackStep::CloseChat;
+}
+
+ChatSender::Duration ChatSender::FeedbackBound(FeedbackStep step) const
+{
+    std::chrono::milliseconds configured;
+    switch (step)
+    {
+        case FeedbackStep::OpenChat:
+            configured = timing_.openChat;
+            break;
+        case FeedbackStep::OpenBroadcast:
+            configured = timing_.openBroadcast;
+            break;
+        case FeedbackStep::CloseChat:
+            configured = timing_.restoreChat;
+            break;
+        default:
+            configured = timing_.restoreBroadcast;
+            break;
+    }
+    return latencies_[size_t(step)].Bound(configured);
+}
+
+ChatSendWorker::UnlockedSink::UnlockedSink(ChatSender::Sink& sink, std::mutex& mutex)
+    : sink_(sink)
+    , mutex_(mutex)
+{
+}
+
+bool ChatSendWorker::UnlockedSink::chatOpen()
+{
+    return Unlocked([&] { return sink_.chatOpen(); });
+}
+
+ChatSender::HeldInputs ChatSendWorker::UnlockedSink::CaptureHeld()
+{
+    return Unlocked([&] { return sink_.CaptureHeld(); });
+}
+
+void ChatSendWorker::UnlockedSink::Release(const ChatSender::HeldInputs& held)
+{
+    Unlocked([&] { sink_.Release(held); });
+}
+
+void ChatSendWorker::UnlockedSink::OpenChat(bool broadcast)
+{
+    Unlocked([&] { sink_.OpenChat(broadcast); });
+}
+
+void ChatSendWorker::UnlockedSink::Type(const std::wstring& text)
+{
+    Unlocked([&] { sink_.Type(text); });
+}
+
+void ChatSendWorker::UnlockedSink::Submit()
+{
+    Unlocked([&] { sink_.Submit(); });
+}
+
+void ChatSendWorker::UnlockedSink::Restore(const ChatSender::HeldInputs& held)
+{
+    Unlocked([&] { sink_.Restore(held); });
+}
+
+ChatSendWorker::ChatSendWorker(ChatSender::Sink& sink, ChatSender::Timing timing)
+    : unlockedSink_(sink, mutex_)
+    , sender_(unlockedSink_, timing)
+    , thread_([this](std::stop_token stopToken) { Run(stopToken); })
+{
+}
+
+bool ChatSendWorker::Enqueue(ChatSender::Message message)
+{
+    bool queued;
+    {
+        std::lock_guard lock(mutex_);
+        queued = sender_.Enqueue(std::move(message));
+        woken_ = true;
+    }
+    wake_.notify_one();
+    return queued;
+}
+
+void ChatSendWorker::Cancel()
+{
+    {
+        std::lock_guard lock(mutex_);
+        sender_.Cancel();
+        woken_ = true;
+    }
+    wake_.notify_one();
+}
+
+ChatSender::Latencies ChatSendWorker::latencies()
+{
+    std::lock_guard lock(mutex_);
+    return sender_.latencies();
+}
+
+void ChatSendWorker::Run(std::stop_token stopToken)
+{
+    std::unique_lock lock(mutex_);
+    while (!stopToken.stop_requested())
+    {
+        const auto next = sender_.Advance(ChatSender::Clock::now());
+        wake_.wait_until(lock, stopToken, next.value_or(ChatSender::Clock::now() + std::chrono::seconds(1)), [&] { return woken_; });
+        woken_ = false;
+    }
+}
+} // namespace GW2Radial
@@ -7,28 +7,220 @@
 #include <Utility.h>
 #include <Core.h>
 #include <ConfigurationFile.h>
-#include <backends/imgui_impl_dx11.h>
+#include <DistanceField.h>
+#include <imgui_internal.h>
+#include <cmath>
 
 namespace GW2Radial
 {
+namespace
+{
+INPUT MakeScanCodeInput(WORD scanCode, bool down)
+{
+    INPUT input = {};
+    input.type = INPUT_KEYBOARD;
+    input.ki.wScan = scanCode;
+    input.ki.dwFlags = KEYEVENTF_SCANCODE | (down ? 0 : KEYEVENTF_KEYUP);
+    return input;
+}
+
+INPUT MakeMouseInput(DWORD flags)
+{
+    INPUT input = {};
+    input.type = INPUT_MOUSE;
+    input.mi.dwFlags = flags;
+    return input;
+}
+
+// Types into the game with SendInput using scan codes, so the game sees them as hardware input. Runs on the chat worker.
+class Win32ChatSink : public ChatSender::Sink
+{
+    // W, A, S, D
+    static constexpr WORD MovementScanCodes[] = { 0x11, 0x1E, 0x1F, 0x20 };
+    static constexpr WORD EnterScanCode = 0x1C;
+    static constexpr WORD ShiftScanCode = 0x2A;
+
+    static void Send(std::vector<INPUT>& inputs)
+    {
+        if (!inputs.empty())
+            SendInput(static_cast<UINT>(inputs.size()), inputs.data(), sizeof(INPUT));
+    }
+
+    static void PressHeld(const ChatSender::HeldInputs& held, bool down)
+    {
+        const bool keys[] = { held.w, held.a, held.s, held.d };
+
+        std::vector<INPUT> inputs;
+        for (size_t i = 0; i < std::size(keys); i++)
+            if (keys[i])
+                inputs.push_back(MakeScanCodeInput(MovementScanCodes[i], down));
+        if (held.leftMouse)
+            inputs.push_back(MakeMouseInput(down ? MOUSEEVENTF_LEFTDOWN : MOUSEEVENTF_LEFTUP));
+        if (held.rightMouse)
+            inputs.push_back(MakeMouseInput(down ? MOUSEEVENTF_RIGHTDOWN : MOUSEEVENTF_RIGHTUP));
+        Send(inputs);
+    }
+
+public:
+    bool chatOpen() override
+    {
+        return MumbleLink::i().textboxHasFocus();
+    }
+
+    ChatSender::HeldInputs CaptureHeld() override
+    {
+        const auto isDown = [](int vk) { return (GetAsyncKeyState(vk) & 0x8000) != 0; };
+
+        ChatSender::HeldInputs held;
+        held.w = isDown('W');
+        held.a = isDown('A');
+        held.s = isDown('S');
+        held.d = isDown('D');
+        held.leftMouse = isDown(VK_LBUTTON);
+        held.rightMouse = isDown(VK_RBUTTON);
+        return held;
+    }
+
+    // Released before opening chat so the game accepts the presses again once chat closes
+    void Release(const ChatSender::HeldInputs& held) override
+    {
+        PressHeld(held, false);
+    }
+
+    void OpenChat(bool broadcast) override
+    {
+        // Squad broadcast opens with Shift+Enter
+        std::vector<INPUT> inputs;
+        if (broadcast)
+            inputs.push_back(MakeScanCodeInput(ShiftScanCode, true));
+        inputs.push_back(MakeScanCodeInput(EnterScanCode, true));
+        inputs.push_back(MakeScanCodeInput(EnterScanCode, false));
+        if (broadcast)
+            inputs.push_back(MakeScanCodeInput(ShiftScanCode, false));
+        Send(inputs);
+    }
+
+    void Type(const std::wstring& text) override
+    {
+        // Unicode input types the characters themselves, whatever the keyboard layout
+        std::vector<INPUT> inputs;
+        inputs.reserve(text.length() * 2);
+        for (wchar_t wc : text)
+        {
+            INPUT input = {};
+            input.type = INPUT_KEYBOARD;
+            input.ki.wScan = wc;
+            input.ki.dwFlags = KEYEVENTF_UNICODE;
+            inputs.push_back(input);
+            input.ki.dwFlags |= KEYEVENTF_KEYUP;
+            inputs.push_back(input);
+        }
+        Send(inputs);
+    }
+
+    void Submit() override
+    {
+        std::vector<INPUT> inputs = { MakeScanCodeInput(EnterScanCode, true), MakeScanCodeInput(EnterScanCode, false) };
+        Send(inputs);
+    }
+
+    void Restore(const ChatSender::HeldInputs& held) override
+    {
+        PressHeld(held, true);
+    }
+};
+
+// Draws text into an 8-bit coverage mask straight from the font atlas glyphs, laid out like ImDrawList::AddText with wrapping.
+// Returns nothing if the font atlas no longer holds its pixels on the CPU.
+std::vector<u8> RasterizeText(ImFont* font, float fontSize, const std::string& text, float wrapWidth, u32 width, u32 height, ImVec2 pos)
+{
+    const ImFontAtlas* atlas = font->ContainerAtlas;
+    if (!atlas->TexPixelsAlpha8 && !atlas->TexPixelsRGBA32)
+        return {};
+
+    const int atlasW = atlas->TexWidth, atlasH = atlas->TexHeight;
+    auto atlasAlpha = [&](int x, int y) -> float {
+        x = std::clamp(x, 0, atlasW - 1);
+        y = std::clamp(y, 0, atlasH - 1);
+        const size_t i = size_t(y) * atlasW + x;
+        return atlas->TexPixelsAlpha8 ? atlas->TexPixelsAlpha8[i] : float(atlas->TexPixelsRGBA32[i] >> 24);
+    };
+    auto sampleAtlas = [&](float u, float v) {
+        const float x = u * atlasW - 0.5f, y = v * atlasH - 0.5f;
+        const int x0 = int(std::floor(x)), y0 = int(std::floor(y));
+        const float fx = x - float(x0), fy = y - float(y0);
+        const float top = std::lerp(atlasAlpha(x0, y0), atlasAlpha(x0 + 1, y0), fx);
+        const float bottom = std::lerp(atlasAlpha(x0, y0 + 1), atlasAlpha(x0 + 1, y0 + 1), fx);
+        return std::lerp(top, bottom, fy);
+    };
+
+    std::vector<u8> coverage(size_t(width) * height, 0);
+    auto drawGlyph = [&](const ImFontGlyph& g, float x, float y, float scale) {
+        const float x0 = x + g.X0 * scale, y0 = y + g.Y0 * scale, x1 = x + g.X1 * scale, y1 = y + g.Y1 * scale;
+        const int px0 = std::max(0, int(std::floor(x0))), px1 = std::min(int(width), int(std::ceil(x1)));
+        const int py0 = std::max(0, int(std::floor(y0))), py1 = std::min(int(height), int(std::ceil(y1)));
+        for (int py = py0; py < py1; py++)
+            for (int px = px0; px < px1; px++) {
+                const float tx = (float(px) + 0.5f - x0) / (x1 - x0), ty = (float(py) + 0.5f - y0) / (y1 - y0);
+                if (tx < 0.f || tx > 1.f || ty < 0.f || ty > 1.f)
+                    continue;
+                auto& c = coverage[size_t(py) * width + px];
+                c = std::max(c, u8(sampleAtlas(std::lerp(g.U0, g.U1, tx), std::lerp(g.V0, g.V1, ty)) + 0.5f));
+            }
+    };
+
+    const float scale = fontSize / font->FontSize;
+    const char* s = text.c_str();
+    const char* end = s + text.size();
+    float y = std::floor(pos.y);
+    while (s < end) {
+        const char* lineEnd = font->CalcWordWrapPositionA(scale, s, end, wrapWidth);
+        if (lineEnd == s)
+            lineEnd++;
+
+        float x = std::floor(pos.x);
+        while (s < lineEnd) {
+            unsigned int c = 0;
+            s += ImTextCharFromUtf8(&c, s, end);
+            if (c == '\n') {
+                x = std::floor(pos.x);
+                y += fontSize;
+                continue;
+            }
+            const ImFontGlyph* g = font->FindGlyph(ImWchar(c));
+            if (!g)
+                continue;
+            if (g->Visible)
+                drawGlyph(*g, x, y, scale);
+            x += g->AdvanceX * scale;
+        }
+        y += fontSize;
+
+        // Like ImGui, blanks at the start of a wrapped line are skipped
+        while (s < end && (*s == ' ' || *s == '\t'))
+            s++;
+    }
+
+    return coverage;
+}
+} // namespace
 
 void ChatCommand::LoadMessage()
 {
-    const char* value = INIConfigurationFile::i().ini().GetValue("Chat Commands", (nickname_ + "_message").c_str(), "");
-    message = value ? value : "";
+    message = Core::i().ReadConfigValue("Chat Commands", nickname_ + "_message");
 }
 
 void ChatCommand::SaveMessage() const
 {
     INIConfigurationFile::i().ini().SetValue("Chat Commands", (nickname_ + "_message").c_str(), message.c_str());
-    INIConfigurationFile::i().Save();
+    Core::i().configWriteBehind().MarkDirty("Chat Commands");
 }
 
 void ChatCommand::LoadLabel()
 {
-    const char* value = INIConfigurationFile::i().ini().GetValue("Chat Commands", (nickname_ + "_label").c_str(), "");
-    if (value && strlen(value) > 0) {
-        label = value;
+    auto value = Core::i().ReadConfigValue("Chat Commands", nickname_ + "_label");
+    if (!value.empty()) {
+        label = std::move(value);
     }
     // If no label in config, keep the default from constructor
 }
@@ -36,35 +228,32 @@ void ChatCommand::LoadLabel()
 void ChatCommand::SaveLabel() const
 {
     INIConfigurationFile::i().ini().SetValue("Chat Commands", (nickname_ + "_label").c_str(), label.c_str());
-    INIConfigurationFile::i().Save();
+    Core::i().configWriteBehind().MarkDirty("Chat Commands");
 }
 
 ChatWheel::ChatWheel(std::shared_ptr<Texture2D> bgTexture)
     : Wheel(std::move(bgTexture), "chat_commands", "Chat Commands")
     , placeholderTexture_(CreatePlaceholderTexture())
     , dynamicFallbackChannel_("chat_dynamic_fallback", "Dynamic Mode Default Channel", "Chat Commands", 0) // Default to squad (/d)
+    , chatSink_(std::make_unique<Win32ChatSink>())
+    , chatSender_(std::make_unique<ChatSendWorker>(*chatSink_, ChatSender::Timing{}))
 {
-    // Create blend state for text rendering
+    // Typing into whatever window took focus would be worse than losing the message
+    SubscribeGameState(GameStateMonitor::FocusField, [this](const GameSnapshot&, const GameSnapshot& current, u32) {
+        if (!current.gameHasFocus)
+            chatSender_->Cancel();
+    });
+
+    // Create the label atlas, cells are filled in as labels are regenerated
     auto dev = Core::i().device();
-    D3D11_BLEND_DESC blendDesc = {};
-    blendDesc.RenderTarget[0].BlendEnable = TRUE;
-    blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-    blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-    blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-    blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-    blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-    dev->CreateBlendState(&blendDesc, textBlendState_.GetAddressOf());
-
-    // Initialize label textures
-    labelTextures_.resize(NUM_COMMANDS);
-    for (int i = 0; i < NUM_COMMANDS; i++)
-    {
-        // Create render target for text (larger texture for better visibility)
-        labelTextures_[i].rt = MakeRenderTarget(dev, 512, 512, DXGI_FORMAT_R8G8B8A8_UNORM);
-        labelTextures_[i].needsRedraw = true;
-    }
+    constexpr u32 labelRows = (NUM_COMMANDS + LabelColumns - 1) / LabelColumns;
+    CD3D11_TEXTURE2D_DESC atlasDesc(DXGI_FORMAT_R8_UNORM, LabelColumns * LabelCellSize, labelRows * LabelCellSize, 1, 1);
+    std::vector<u8> emptyAtlas(size_t(atlasDesc.Width) * atlasDesc.Height, 0);
+    D3D11_SUBRESOURCE_DATA atlasData{ emptyAtlas.data(), atlasDesc.Width, 0 };
+    GW2_CHECKED_HRESULT(dev->CreateTexture2D(&atlasDesc, &atlasData, labelAtlas_.texture.GetAddressOf()));
+    GW2_CHECKED_HRESULT(dev->CreateShaderResourceView(labelAtlas_.texture.Get(), nullptr, labelAtlas_.srv.GetAddressOf()));
+
+    labelCells_.resize(NUM_COMMANDS);
 
     // Create command slots and corresponding wheel elements
     for (int i = 0; i < NUM_COMMANDS; i++)
@@ -77,11 +266,6 @@ ChatWheel::ChatWheel(std::shared_ptr<Texture2D> bgTexture)
         glm::vec4 color = GetCommandColor(i);
         auto props = ChatCommand::GetDefaultProps();
 
-        // Use the label texture instead of placeholder
-        Texture2D labelTex;
-        labelTex.texture = labelTextures_[i].rt.texture;
-        labelTex.srv = labelTextures_[i].rt.srv;
-
         auto element = std::make_unique<WheelElement>(
             i,
             nickname,
@@ -89,7 +273,8 @@ ChatWheel::ChatWheel(std::shared_ptr<Texture2D> bgTexture)
             commands_[i]->label,  // Use the label from the command
             color,
             props,
-            labelTex  // Use label texture
+            labelAtlas_,  // Use this command's cell of the label atlas
+            LabelCellRect(i)
         );
 
         // Disable shadow effect for cleaner text display
@@ -103,9 +288,7 @@ ChatWheel::ChatWheel(std::shared_ptr<Texture2D> bgTexture)
         // Set custom behavior to only show if command is enabled and has a message
         // This acts as a pre-check (AND) before evaluating conditional props
         const size_t cmdIndex = i;
-        element->customBehaviorKeepProps([this, cmdIndex](bool visibility) {
-            return commands_[cmdIndex]->enabled->value() && !commands_[cmdIndex]->message.empty();
-        });
+        element->customBehaviorKeepProps(SlotBit(cmdIndex));
 
         // Store pointer before moving the unique_ptr
         wheelElements_.push_back(element.get());
@@ -114,6 +297,16 @@ ChatWheel::ChatWheel(std::shared_ptr<Texture2D> bgTexture)
     }
 }
 
+u64 ChatWheel::PackStateWord() const
+{
+    // One bit per command, set when it is enabled and has a message to send
+    u64 word = 0;
+    for (size_t i = 0; i < commands_.size(); i++)
+        if (commands_[i]->enabled->value() && !commands_[i]->message.empty())
+            word |= SlotBit(i);
+    return word;
+}
+
 void ChatWheel::OnUpdate()
 {
     Wheel::OnUpdate();
@@ -157,6 +350,9 @@ Keybind* ChatWheel::GetKeybindFromOpt(OptKeybindWheelElement& o)
 
 void ChatWheel::DrawMenu(Keybind** currentEditedKeybind)
 {
+    // Enabling a command or editing its message changes its visibility
+    InvalidateElementCache();
+
     ImGui::PushID((nickname_ + "ChatCommands").c_str());
 
     UI::Title("Chat Commands");
@@ -191,6 +387,26 @@ void ChatWheel::DrawMenu(Keybind** currentEditedKeybind)
     ImGui::Separator();
     ImGui::Spacing();
 
+    // Measured chat box response, which the send timing adapts to
+    UI::Title("Chat Timing");
+    const auto latencies = chatSender_->latencies();
+    const char* stepNames[] = { "Open chat", "Open squad broadcast", "Close chat", "Close squad broadcast" };
+    for (size_t i = 0; i < latencies.size(); i++) {
+        const auto& step = latencies[i];
+        using Ms = std::chrono::duration<float, std::milli>;
+        if (step.count() == 0)
+            ImGui::Text("%s: not measured yet", stepNames[i]);
+        else
+            ImGui::Text("%s: %.1f ms (mean) / %.1f ms (max) over %zu sends, %u timeouts", stepNames[i],
+                Ms(step.mean()).count(), Ms(step.max()).count(), step.count(), step.timeouts());
+    }
+    UI::HelpTooltip("Messages are typed as soon as the chat box opens and movement keys are pressed again as soon as it closes. "
+        "Until enough sends are measured, fixed delays are used.");
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
     // Command visibility/usability configuration
     UI::Title("Command Visibility & Ordering");
     ImGui::TextWrapped("Configure which commands appear in different game modes and adjust their order in the wheel.");
@@ -427,242 +643,11 @@ void ChatWheel::SendChatMessage(const std::string& message, int channel)
 
 void ChatWheel::SendTextToChat(const std::string& text, bool broadcast)
 {
-    LogInfo("ChatWheel: Attempting to send message: {} (broadcast: {})", text, broadcast);
-
-    // Don't send if chat is already open
-    if (MumbleLink::i().textboxHasFocus())
-    {
-        LogInfo("ChatWheel: Chat already open, aborting");
-        return;
-    }
-
-    // Capture currently pressed movement keys (WASD) and mouse buttons
-    struct InputState {
-        bool w = (GetAsyncKeyState('W') & 0x8000) != 0;
-        bool a = (GetAsyncKeyState('A') & 0x8000) != 0;
-        bool s = (GetAsyncKeyState('S') & 0x8000) != 0;
-        bool d = (GetAsyncKeyState('D') & 0x8000) != 0;
-        bool leftMouse = (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0;
-        bool rightMouse = (GetAsyncKeyState(VK_RBUTTON) & 0x8000) != 0;
-    };
-    InputState pressedKeys;
-    LogInfo("ChatWheel: Captured input - W:{} A:{} S:{} D:{} LMB:{} RMB:{}",
-        pressedKeys.w, pressedKeys.a, pressedKeys.s, pressedKeys.d, pressedKeys.leftMouse, pressedKeys.rightMouse);
-
-    // Release any pressed keys/buttons BEFORE opening chat
-    // This creates a clean state so GW2 will accept our re-presses later
-    std::vector<INPUT> releaseInputs;
-    if (pressedKeys.w) {
-        INPUT wUp = {};
-        wUp.type = INPUT_KEYBOARD;
-        wUp.ki.wScan = 0x11;  // W scan code
-        wUp.ki.dwFlags = KEYEVENTF_SCANCODE | KEYEVENTF_KEYUP;
-        releaseInputs.push_back(wUp);
-        LogInfo("ChatWheel: Releasing W key");
-    }
-    if (pressedKeys.a) {
-        INPUT aUp = {};
-        aUp.type = INPUT_KEYBOARD;
-        aUp.ki.wScan = 0x1E;  // A scan code
-        aUp.ki.dwFlags = KEYEVENTF_SCANCODE | KEYEVENTF_KEYUP;
-        releaseInputs.push_back(aUp);
-        LogInfo("ChatWheel: Releasing A key");
-    }
-    if (pressedKeys.s) {
-        INPUT sUp = {};
-        sUp.type = INPUT_KEYBOARD;
-        sUp.ki.wScan = 0x1F;  // S scan code
-        sUp.ki.dwFlags = KEYEVENTF_SCANCODE | KEYEVENTF_KEYUP;
-        releaseInputs.push_back(sUp);
-        LogInfo("ChatWheel: Releasing S key");
-    }
-    if (pressedKeys.d) {
-        INPUT dUp = {};
-        dUp.type = INPUT_KEYBOARD;
-        dUp.ki.wScan = 0x20;  // D scan code
-        dUp.ki.dwFlags = KEYEVENTF_SCANCODE | KEYEVENTF_KEYUP;
-        releaseInputs.push_back(dUp);
-        LogInfo("ChatWheel: Releasing D key");
-    }
-    if (pressedKeys.leftMouse) {
-        INPUT lmbUp = {};
-        lmbUp.type = INPUT_MOUSE;
-        lmbUp.mi.dwFlags = MOUSEEVENTF_LEFTUP;
-        releaseInputs.push_back(lmbUp);
-        LogInfo("ChatWheel: Releasing left mouse button");
-    }
-    if (pressedKeys.rightMouse) {
-        INPUT rmbUp = {};
-        rmbUp.type = INPUT_MOUSE;
-        rmbUp.mi.dwFlags = MOUSEEVENTF_RIGHTUP;
-        releaseInputs.push_back(rmbUp);
-        LogInfo("ChatWheel: Releasing right mouse button");
-    }
-
-    if (!releaseInputs.empty()) {
-        UINT result = SendInput(static_cast<UINT>(releaseInputs.size()), releaseInputs.data(), sizeof(INPUT));
-        LogInfo("ChatWheel: Released {} inputs, result: {}", releaseInputs.size(), result);
-        // No sleep needed - SendInput is synchronous
-    }
-
-    auto& input = Input::i();
-    mstime currentTime = TimeInMilliseconds();
-    mstime delay = currentTime + 15; // Minimal initial delay
-
-    if (broadcast)
-    {
-        LogInfo("ChatWheel: Opening squad broadcast with Shift+Enter");
-        input.SendKeybind(KeyCombo(ScanCode::Enter, Modifier::Shift), std::nullopt, KeybindAction::Both, true, delay);
-        delay += 80; // Reduced but still enough for broadcast to open
-    }
-    else
-    {
-        LogInfo("ChatWheel: Opening chat with Enter");
-        input.SendKeybind(KeyCombo(ScanCode::Enter), std::nullopt, KeybindAction::Both, true, delay);
-        delay += 50; // Reduced - regular chat opens fast
-    }
-
-    // Type each character using Windows SendInput API
-    LogInfo("ChatWheel: Typing {} characters", text.length());
-
-    // We need to queue the character typing to happen after the chat opens
-    // Since SendKeybind doesn't support WM_CHAR, we'll use Windows SendInput with KEYEVENTF_UNICODE
-    // We need to do this in a way that's queued properly with the delay system
-
-    // Get the window handle for GW2
-    HWND hwnd = GetForegroundWindow();
-    if (!hwnd)
-    {
-        LogWarn("ChatWheel: Could not get foreground window");
-        return;
-    }
-
-    // Schedule a background task to type the characters after the delay
-    std::thread([text, delay, broadcast, pressedKeys]() {
-        // Calculate wait time from current time
-        mstime currentTime = TimeInMilliseconds();
-        mstime waitTime = delay > currentTime ? delay - currentTime : 0;
+    LogInfo("ChatWheel: Queuing message: {} (broadcast: {})", text, broadcast);
 
-        LogInfo("ChatWheel: Thread waiting {}ms before typing", waitTime);
-        Sleep(static_cast<DWORD>(waitTime));
-
-        // Type each character using Unicode input - build all inputs first for faster sending
-        LogInfo("ChatWheel: Starting to type message");
-        std::wstring wtext(text.begin(), text.end());
-        std::vector<INPUT> inputs;
-        inputs.reserve(wtext.length() * 2); // Each character needs key down + key up
-
-        for (wchar_t wc : wtext)
-        {
-            // Key down
-            INPUT inputDown = {};
-            inputDown.type = INPUT_KEYBOARD;
-            inputDown.ki.wScan = wc;
-            inputDown.ki.dwFlags = KEYEVENTF_UNICODE;
-            inputs.push_back(inputDown);
-
-            // Key up
-            INPUT inputUp = {};
-            inputUp.type = INPUT_KEYBOARD;
-            inputUp.ki.wScan = wc;
-            inputUp.ki.dwFlags = KEYEVENTF_UNICODE | KEYEVENTF_KEYUP;
-            inputs.push_back(inputUp);
-        }
-
-        // Send all character inputs at once for maximum speed
-        if (!inputs.empty())
-        {
-            SendInput(static_cast<UINT>(inputs.size()), inputs.data(), sizeof(INPUT));
-        }
-
-        // Send Enter to submit the message (same for both broadcast and regular)
-        LogInfo("ChatWheel: Sending final Enter key");
-        Sleep(50);  // Longer delay to ensure text is fully processed before Enter
-
-        // Regular Enter key to send the message
-        INPUT enterInput[2] = {};
-        enterInput[0].type = INPUT_KEYBOARD;
-        enterInput[0].ki.wScan = 0x1C;  // Scan code for Enter
-        enterInput[0].ki.dwFlags = KEYEVENTF_SCANCODE;
-
-        enterInput[1].type = INPUT_KEYBOARD;
-        enterInput[1].ki.wScan = 0x1C;  // Scan code for Enter
-        enterInput[1].ki.dwFlags = KEYEVENTF_SCANCODE | KEYEVENTF_KEYUP;
-
-        UINT result = SendInput(2, enterInput, sizeof(INPUT));
-        LogInfo("ChatWheel: Enter key sent with scan code, result: {}", result);
-
-        // Re-press movement keys that were held down before opening chat
-        // Wait for chat to close and game to be ready for input
-        // Optimized timing for fast restoration without key capture
-        if (broadcast) {
-            Sleep(40); // Fast restoration for broadcast
-        } else {
-            Sleep(60); // Fast restoration for slash commands
-        }
-
-        std::vector<INPUT> movementInputs;
-
-        // Use scan codes instead of VK codes for hardware-level input
-        // W=0x11, A=0x1E, S=0x1F, D=0x20
-        // Send key down with scan code to register the press with GW2
-        if (pressedKeys.w) {
-            INPUT wDown = {};
-            wDown.type = INPUT_KEYBOARD;
-            wDown.ki.wScan = 0x11;  // W scan code
-            wDown.ki.dwFlags = KEYEVENTF_SCANCODE;
-            movementInputs.push_back(wDown);
-            LogInfo("ChatWheel: Queuing W key press");
-        }
-        if (pressedKeys.a) {
-            INPUT aDown = {};
-            aDown.type = INPUT_KEYBOARD;
-            aDown.ki.wScan = 0x1E;  // A scan code
-            aDown.ki.dwFlags = KEYEVENTF_SCANCODE;
-            movementInputs.push_back(aDown);
-            LogInfo("ChatWheel: Queuing A key press");
-        }
-        if (pressedKeys.s) {
-            INPUT sDown = {};
-            sDown.type = INPUT_KEYBOARD;
-            sDown.ki.wScan = 0x1F;  // S scan code
-            sDown.ki.dwFlags = KEYEVENTF_SCANCODE;
-            movementInputs.push_back(sDown);
-            LogInfo("ChatWheel: Queuing S key press");
-        }
-        if (pressedKeys.d) {
-            INPUT dDown = {};
-            dDown.type = INPUT_KEYBOARD;
-            dDown.ki.wScan = 0x20;  // D scan code
-            dDown.ki.dwFlags = KEYEVENTF_SCANCODE;
-            movementInputs.push_back(dDown);
-            LogInfo("ChatWheel: Queuing D key press");
-        }
-        if (pressedKeys.leftMouse) {
-            INPUT lmbDown = {};
-            lmbDown.type = INPUT_MOUSE;
-            lmbDown.mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
-            movementInputs.push_back(lmbDown);
-            LogInfo("ChatWheel: Queuing left mouse button press");
-        }
-        if (pressedKeys.rightMouse) {
-            INPUT rmbDown = {};
-            rmbDown.type = INPUT_MOUSE;
-            rmbDown.mi.dwFlags = MOUSEEVENTF_RIGHTDOWN;
-            movementInputs.push_back(rmbDown);
-            LogInfo("ChatWheel: Queuing right mouse button press");
-        }
-
-        if (!movementInputs.empty()) {
-            UINT result = SendInput(static_cast<UINT>(movementInputs.size()), movementInputs.data(), sizeof(INPUT));
-            LogInfo("ChatWheel: Sent {} input restorations using scan codes, result: {}", movementInputs.size(), result);
-        } else {
-            LogInfo("ChatWheel: No inputs to restore");
-        }
-
-    }).detach();
-
-    LogInfo("ChatWheel: Character typing scheduled");
+    // The worker types messages one at a time, so spamming commands can't interleave their keystrokes
+    if (!chatSender_->Enqueue({ utf8_decode(text), broadcast }))
+        LogInfo("ChatWheel: Message dropped, it is already waiting or too many messages are pending");
 }
 
 glm::vec4 ChatWheel::GetCommandColor(int index)
@@ -700,104 +685,69 @@ void ChatWheel::UpdateElementLabel(size_t index)
         LogInfo("ChatWheel: Updated label for command {} to '{}'", index + 1, commands_[index]->label);
 
         // Mark texture for regeneration
-        if (index < labelTextures_.size())
+        if (index < labelCells_.size())
         {
-            labelTextures_[index].needsRedraw = true;
+            labelCells_[index].needsRedraw = true;
         }
     }
 }
 
+AtlasRect ChatWheel::LabelCellRect(size_t index) const
+{
+    return { u32(index % LabelColumns) * LabelCellSize, u32(index / LabelColumns) * LabelCellSize, LabelCellSize, LabelCellSize };
+}
+
 void ChatWheel::RegenerateTexture(size_t index, ID3D11DeviceContext* ctx)
 {
-    if (index >= labelTextures_.size() || index >= commands_.size())
+    if (index >= labelCells_.size() || index >= commands_.size())
         return;
 
-    auto& lt = labelTextures_[index];
-    if (!lt.needsRedraw)
+    auto& cell = labelCells_[index];
+    if (!cell.needsRedraw)
         return;
 
     // Convert label to wide string
     std::wstring wlabel = utf8_decode(commands_[index]->label);
-
-    // Check if text changed
-    if (lt.text == wlabel && !lt.needsRedraw)
-        return;
-
-    lt.text = wlabel;
-    lt.needsRedraw = false;
+    cell.text = wlabel;
 
     // Get font
     auto font = Core::i().font();
 
-    const float fontSize = 180.f;  // Much larger font for better visibility
-    const u32 fgColor = 0xFFFFFFFF;
-    const u32 outlineColor = 0xFF000000;  // Black outline for boldness
+    constexpr u32 rasterSize = LabelCellSize * LabelRasterScale;
+    const float fontSize = 90.f;  // Large relative to the cell for better visibility
+    const float outlineSpread = 8.f;  // Distance field range in raster pixels, the outline takes up part of it
 
     // Calculate text size with wrapping at ~5 characters
     const auto& txt = utf8_encode(wlabel);
     const float wrapWidth = fontSize * 5.2f;  // Approximate width for ~5 characters
     auto sz = font->CalcTextSizeA(fontSize, FLT_MAX, wrapWidth, txt.c_str());
 
-    ImVec2 clip(512.f, 512.f);
+    ImVec2 clip(float(rasterSize), float(rasterSize));
     float xOff = (clip.x - sz.x) * 0.5f;
     float yOff = (clip.y - sz.y) * 0.5f;
 
     // Add padding to prevent text from touching edges
-    const float verticalPadding = 32.f;
+    const float verticalPadding = 16.f;
     yOff = std::max(verticalPadding, std::min(yOff, clip.y - sz.y - verticalPadding));
 
-    // Setup ImGui draw list
-    ImDrawList imDraw(ImGui::GetDrawListSharedData());
-    imDraw.AddDrawCmd();
-    imDraw.PushClipRect(ImVec2(0.f, 0.f), clip);
-    imDraw.PushTextureID(font->ContainerAtlas->TexID);
-
-    // Draw outline for bold effect (draw text multiple times with slight offsets)
-    const float outlineThickness = 3.f;
-    for (int x = -1; x <= 1; x++) {
-        for (int y = -1; y <= 1; y++) {
-            if (x == 0 && y == 0) continue;
-            imDraw.AddText(font, fontSize, ImVec2(xOff + x * outlineThickness, yOff + y * outlineThickness),
-                          outlineColor, txt.c_str(), nullptr, wrapWidth);
-        }
-    }
-
-    // Draw main text on top
-    imDraw.AddText(font, fontSize, ImVec2(xOff, yOff), fgColor, txt.c_str(), nullptr, wrapWidth);
-
-    auto& io = ImGui::GetIO();
-    auto oldDisplaySize = io.DisplaySize;
-    io.DisplaySize = clip;
-
-    // Save old render target
-    ComPtr<ID3D11RenderTargetView> oldRt;
-    ComPtr<ID3D11DepthStencilView> oldDs;
-    ctx->OMGetRenderTargets(1, oldRt.GetAddressOf(), oldDs.GetAddressOf());
-    ctx->OMSetRenderTargets(1, lt.rt.rtv.GetAddressOf(), nullptr);
-
-    // Clear to transparent
-    float clearColor[] = { 0.f, 0.f, 0.f, 0.f };
-    ctx->ClearRenderTargetView(lt.rt.rtv.Get(), clearColor);
-
-    // Render text
-    ImDrawData imData;
-    imData.Valid = true;
-    imData.CmdLists.clear();
-    imData.CmdLists.push_back(&imDraw);
-    imData.CmdListsCount = 1;
-    imData.TotalIdxCount = imDraw.IdxBuffer.Size;
-    imData.TotalVtxCount = imDraw.VtxBuffer.Size;
-    imData.DisplayPos = ImVec2(0.0f, 0.0f);
-    imData.DisplaySize = io.DisplaySize;
-
+    const auto coverage = RasterizeText(font, fontSize, txt, wrapWidth, rasterSize, rasterSize, ImVec2(xOff, yOff));
+    if (coverage.empty())
     {
-        ImGuiBlendStateOverride ov(textBlendState_.Get());
-        ImGui_ImplDX11_RenderDrawData(&imData);
+        // Tried again every frame until the atlas has CPU pixels, warning only once
+        if (!cell.warnedMissingPixels)
+            LogWarn("ChatWheel: Font atlas pixels unavailable, cannot draw label for command {}", index + 1);
+        cell.warnedMissingPixels = true;
+        return;
     }
 
-    // Restore render target
-    ctx->OMSetRenderTargets(1, oldRt.GetAddressOf(), oldDs.Get());
-    io.DisplaySize = oldDisplaySize;
+    // One upload replaces the cell, the outline is added when the element is drawn
+    const auto field = DistanceField::Generate(coverage, rasterSize, rasterSize, outlineSpread, LabelRasterScale);
+    const auto rect = LabelCellRect(index);
+    const D3D11_BOX box{ rect.x, rect.y, 0, rect.x + rect.width, rect.y + rect.height, 1 };
+    ctx->UpdateSubresource(labelAtlas_.texture.Get(), 0, &box, field.data(), LabelCellSize, 0);
+    Core::i().iconAtlas().MarkDirty(labelAtlas_.texture.Get());
+    cell.needsRedraw = false;
+    cell.warnedMissingPixels = false;
 
     LogInfo("ChatWheel: Regenerated texture for command {} with label '{}'", index + 1, commands_[index]->label);
 }
@@ -805,7 +755,7 @@ void ChatWheel::RegenerateTexture(size_t index, ID3D11DeviceContext* ctx)
 void ChatWheel::DrawOffscreen(ID3D11DeviceContext* ctx)
 {
     // Regenerate any textures that need it
-    for (size_t i = 0; i < labelTextures_.size(); i++)
+    for (size_t i = 0; i < labelCells_.size(); i++)
     {
         RegenerateTexture(i, ctx);
     }
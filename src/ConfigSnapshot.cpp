@@ -0,0 +1,170 @@
+#include <ConfigSnapshot.h>
+#include <algorithm>
+#include <cstring>
+#include <xxhash.h>
+
+namespace GW2Radial::ConfigSnapshot
+{
+namespace
+{
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t sourceSize;
+    uint64_t tableOffset;
+    uint64_t checksum; // everything after the header
+};
+static_assert(sizeof(Header) == 40);
+
+std::string MakeKey(std::string_view section, std::string_view key)
+{
+    std::string k;
+    k.reserve(section.size() + 1 + key.size());
+    k.append(section).push_back('\0');
+    k.append(key);
+    return k;
+}
+
+uint64_t Hash(std::string_view key)
+{
+    return XXH3_64bits(key.data(), key.size());
+}
+} // namespace
+
+std::filesystem::path PathFor(const std::filesystem::path& ini)
+{
+    auto path = ini;
+    path.replace_extension(L".snapshot");
+    return path;
+}
+
+bool IsCurrent(const std::filesystem::path& ini)
+{
+    std::error_code ec;
+    const auto      snapshotTime = std::filesystem::last_write_time(PathFor(ini), ec);
+    if (ec)
+        return false;
+    const auto iniTime = std::filesystem::last_write_time(ini, ec);
+
+    return !ec && snapshotTime >= iniTime;
+}
+
+bool Reader::Open(std::span<const uint8_t> file, uint64_t sourceSize)
+{
+    Close();
+
+    Header header;
+    if (file.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != Magic || header.version != Version || header.sourceSize != sourceSize)
+        return false;
+
+    const uint64_t tableSize = uint64_t(header.count) * sizeof(Record);
+    if (header.tableOffset < sizeof(header) || header.tableOffset > file.size() || file.size() - header.tableOffset != tableSize)
+        return false;
+
+    const auto body = file.subspan(sizeof(header));
+    if (XXH3_64bits(body.data(), body.size()) != header.checksum)
+        return false;
+
+    std::vector<Record> records(header.count);
+    if (tableSize > 0)
+        std::memcpy(records.data(), file.data() + header.tableOffset, size_t(tableSize));
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const auto& r = records[i];
+        if (r.keyOffset < sizeof(header) || r.keyOffset > header.tableOffset || header.tableOffset - r.keyOffset < r.keyLength)
+            return false;
+        if (r.valueOffset < sizeof(header) || r.valueOffset > header.tableOffset || header.tableOffset - r.valueOffset < r.valueLength)
+            return false;
+        if (i > 0 && records[i - 1].hash > r.hash)
+            return false;
+    }
+
+    file_    = file;
+    records_ = std::move(records);
+
+    return true;
+}
+
+void Reader::Close()
+{
+    file_ = {};
+    records_.clear();
+}
+
+std::optional<std::string_view> Reader::Find(std::string_view section, std::string_view key) const
+{
+    const auto fullKey = MakeKey(section, key);
+    const auto hash    = Hash(fullKey);
+    const auto text    = [&](uint32_t offset, uint32_t length) { return std::string_view(reinterpret_cast<const char*>(file_.data()) + offset, length); };
+
+    // Colliding hashes sit next to each other, the stored key tells them apart
+    for (auto it = std::lower_bound(records_.begin(), records_.end(), hash, [](const Record& r, uint64_t h) { return r.hash < h; });
+         it != records_.end() && it->hash == hash; ++it)
+        if (text(it->keyOffset, it->keyLength) == fullKey)
+            return text(it->valueOffset, it->valueLength);
+
+    return std::nullopt;
+}
+
+void Writer::Add(std::string_view section, std::string_view key, std::string_view value)
+{
+    auto       fullKey = MakeKey(section, key);
+    const auto hash    = Hash(fullKey);
+    entries_.push_back({ hash, std::move(fullKey), std::string(value) });
+}
+
+std::vector<uint8_t> Writer::Serialize(uint64_t sourceSize) const
+{
+    std::vector<const Pending*> sorted;
+    sorted.reserve(entries_.size());
+    for (const auto& e : entries_)
+        sorted.push_back(&e);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->hash < b->hash; });
+
+    // Stable, so of two additions with the same key the later one comes last and is the one kept
+    for (size_t i = 0; i < sorted.size(); i++)
+        for (size_t j = i + 1; j < sorted.size() && sorted[j]->hash == sorted[i]->hash; j++)
+            if (sorted[j]->key == sorted[i]->key)
+            {
+                sorted[i] = nullptr;
+                break;
+            }
+    std::erase(sorted, nullptr);
+
+    std::vector<uint8_t> bytes(sizeof(Header));
+    const auto           append = [&](const std::string& s)
+    {
+        const auto offset = uint32_t(bytes.size());
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        return offset;
+    };
+
+    std::vector<Reader::Record> records;
+    records.reserve(sorted.size());
+    for (const auto* e : sorted)
+    {
+        const auto keyOffset   = append(e->key);
+        const auto valueOffset = append(e->value);
+        records.push_back({ e->hash, keyOffset, uint32_t(e->key.size()), valueOffset, uint32_t(e->value.size()) });
+    }
+
+    const uint64_t tableOffset = bytes.size();
+    const uint64_t tableSize   = records.size() * sizeof(Reader::Record);
+    bytes.resize(size_t(tableOffset + tableSize));
+    if (tableSize > 0)
+        std::memcpy(bytes.data() + tableOffset, records.data(), size_t(tableSize));
+
+    const Header header{ Magic, Version, uint32_t(records.size()), 0, sourceSize, tableOffset, XXH3_64bits(bytes.data() + sizeof(Header), bytes.size() - sizeof(Header)) };
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    return bytes;
+}
+} // namespace GW2Radial::ConfigSnapshot
@@ -0,0 +1,169 @@
+#include <BlobCache.h>
+#include <ConfigSnapshot.h>
+#include <ConfigWriteBehind.h>
+#include <algorithm>
+#include <utility>
+
+namespace GW2Radial
+{
+ConfigWriteBehind::ConfigWriteBehind(std::filesystem::path path, Serializer serialize, Snapshotter snapshot)
+    : ConfigWriteBehind(std::move(path), std::move(serialize), DefaultIdle, std::move(snapshot))
+{
+}
+
+ConfigWriteBehind::ConfigWriteBehind(std::filesystem::path path, Serializer serialize, std::chrono::milliseconds idle, Snapshotter snapshot)
+    : path_(std::move(path))
+    , serialize_(std::move(serialize))
+    , snapshot_(std::move(snapshot))
+    , idle_(idle)
+    , thread_([this](std::stop_token stopToken) { Run(stopToken); })
+{
+}
+
+ConfigWriteBehind::~ConfigWriteBehind()
+{
+    Flush();
+}
+
+void ConfigWriteBehind::MarkDirty(std::string_view section, Clock::time_point now)
+{
+    if (path_.empty())
+        return;
+
+    if (!dirtySections_.contains(section))
+        dirtySections_.emplace(section);
+    lastChange_ = now;
+}
+
+void ConfigWriteBehind::Update(Clock::time_point now)
+{
+    Commit(now);
+
+    if (dirty() && now - lastChange_ >= idle_)
+        Submit();
+}
+
+bool ConfigWriteBehind::Flush()
+{
+    if (dirty())
+        Submit();
+
+    for (;;)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            if (completed_ == submitted_)
+                break;
+            writtenChanged_.wait(lock, [&] { return written_.has_value(); });
+        }
+        Commit(Clock::now());
+    }
+
+    return !lastWriteFailed_;
+}
+
+std::optional<ConfigWriteBehind::FileStamp> ConfigWriteBehind::Stamp() const
+{
+    std::error_code ec;
+    FileStamp       stamp{ std::filesystem::last_write_time(path_, ec), 0 };
+    if (ec)
+        return std::nullopt;
+    stamp.size = std::filesystem::file_size(path_, ec);
+    if (ec)
+        return std::nullopt;
+
+    return stamp;
+}
+
+void ConfigWriteBehind::Submit()
+{
+    dirtySections_.clear();
+
+    auto contents = serialize_();
+    if (!contents)
+        return;
+    auto snapshot = snapshot_ ? snapshot_(*contents) : std::vector<std::uint8_t>{};
+
+    {
+        std::lock_guard lock(mutex_);
+        pending_ = Contents{ std::move(*contents), std::move(snapshot), Stamp(), ++submitted_ };
+    }
+    wake_.notify_one();
+}
+
+void ConfigWriteBehind::Commit(Clock::time_point now)
+{
+    std::optional<Written> written;
+    {
+        std::lock_guard lock(mutex_);
+        written = std::exchange(written_, std::nullopt);
+    }
+    if (!written)
+        return;
+
+    bool failed = !written->tempPath;
+    if (!failed && Stamp() != written->base)
+    {
+        // Saved by someone else since the contents were taken, and so with everything they held and more
+        std::error_code ec;
+        std::filesystem::remove(*written->tempPath, ec);
+        staleCount_++;
+    }
+    else if (!failed)
+    {
+        failed = !BlobCache::Writer::ReplaceWithTemporary(path_, *written->tempPath);
+        if (!failed)
+        {
+            // A snapshot that could not be put in place stays behind the file, and so is not used
+            if (written->snapshotTempPath && BlobCache::Writer::ReplaceWithTemporary(ConfigSnapshot::PathFor(path_), *written->snapshotTempPath))
+                written->snapshotTempPath.reset();
+            writeCount_++;
+
+            // Contents taken before this write were taken from the file it replaced, not from another writer's
+            const auto      stamp = Stamp();
+            std::lock_guard lock(mutex_);
+            if (pending_ && pending_->base == written->base)
+                pending_->base = stamp;
+        }
+    }
+
+    if (written->snapshotTempPath)
+    {
+        std::error_code ec;
+        std::filesystem::remove(*written->snapshotTempPath, ec);
+    }
+
+    lastWriteFailed_ = failed;
+    // An empty section stands for the whole file
+    if (failed)
+        MarkDirty({}, now);
+
+    {
+        std::lock_guard lock(mutex_);
+        completed_ = std::max(completed_, written->generation);
+    }
+    wake_.notify_one();
+}
+
+void ConfigWriteBehind::Run(std::stop_token stopToken)
+{
+    std::unique_lock lock(mutex_);
+    while (wake_.wait(lock, stopToken, [&] { return pending_.has_value() && !written_.has_value(); }))
+    {
+        auto contents = std::move(*pending_);
+        pending_.reset();
+
+        lock.unlock();
+        const auto*                          bytes    = reinterpret_cast<const uint8_t*>(contents.bytes.data());
+        auto                                 tempPath = BlobCache::Writer::WriteTemporary(path_, { bytes, contents.bytes.size() });
+        // Written second so it is never older than the file it was taken from
+        std::optional<std::filesystem::path> snapshotTempPath;
+        if (tempPath && !contents.snapshot.empty())
+            snapshotTempPath = BlobCache::Writer::WriteTemporary(ConfigSnapshot::PathFor(path_), contents.snapshot);
+        lock.lock();
+
+        written_ = Written{ std::move(tempPath), std::move(snapshotTempPath), contents.base, contents.generation };
+        writtenChanged_.notify_all();
+    }
+}
+} // namespace GW2Radial
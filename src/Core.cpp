@@ -1,6 +1,7 @@
 #include <ConfigurationFile.h>
 #include <Core.h>
 #include <CustomWheel.h>
+#include <D3D11GpuTimer.h>
 #include <GFXSettings.h>
 #include <ImGuiPopup.h>
 #include <Input.h>
@@ -11,6 +12,7 @@
 #include <MountWheel.h>
 #include <MumbleLink.h>
 #include <NoveltyWheel.h>
+#include <PlatformConversions.h>
 #include <SettingsMenu.h>
 #include <ShaderManager.h>
 #include <TemplateWheel.h>
@@ -52,6 +54,16 @@ public:
 
         if (ImGui::Button("Reload custom wheels"))
             Core::i().ForceReloadWheels();
+
+        UI::Title("Profiling");
+
+        bool showFrameProfiler = Core::i().frameProfiler().enabled();
+        if (ImGui::Checkbox("Show frame profiler", &showFrameProfiler))
+            Core::i().frameProfiler().enabled(showFrameProfiler);
+
+        UI::Title("Startup Profile");
+
+        Core::i().startupProfile().DrawGUI();
     }
 
     bool reloadOnFocus() const
@@ -62,24 +74,17 @@ public:
 
 void Core::InnerFrequentUpdate()
 {
-    const auto& mumble = MumbleLink::i();
-
-    u32         map    = mumble.mapId();
-    if (map != mapId_)
-    {
-        for (auto& wheel : wheels_)
-            wheel->OnMapChange(mapId_, map);
-
-        mapId_ = map;
-    }
-
-    if (characterName_ != mumble.characterName())
-    {
-        for (auto& wheel : wheels_)
-            wheel->OnCharacterChange(characterName_, mumble.characterName());
-
-        characterName_ = mumble.characterName();
-    }
+    const auto&  mumble = MumbleLink::i();
+
+    GameSnapshot snapshot;
+    snapshot.state           = ToGameConditions(mumble.currentState());
+    snapshot.mounted         = mumble.isMounted();
+    snapshot.mapOpen         = mumble.isMapOpen();
+    snapshot.gameHasFocus    = mumble.gameHasFocus();
+    snapshot.textboxHasFocus = mumble.textboxHasFocus();
+    snapshot.mapId           = mumble.mapId();
+    snapshot.characterName   = mumble.characterName();
+    gameStateMonitor_.Publish(std::move(snapshot));
 }
 
 void Core::InnerOnFocus()
@@ -97,24 +102,86 @@ void Core::InnerOnFocusLost()
 
 void Core::InnerInitPreImGui()
 {
+    auto scope = startupProfile_.Measure("InitPreImGui");
+
     RadialMiscTab::init<RadialMiscTab>();
+    SetCurrentPlatform(platform_.platform(gameStateMonitor_));
+
+    gameStateMonitor_.Subscribe(GameStateMonitor::StateField | GameStateMonitor::MountedField | GameStateMonitor::MapOpenField | GameStateMonitor::FocusField,
+                                [this](const GameSnapshot&, const GameSnapshot&, u32) { queueConditionsChanged_ = true; });
+
+    const auto folder     = INIConfigurationFile::i().folder();
+    const auto configPath = folder ? *folder / L"config.ini" : std::filesystem::path{};
 
-    bgTex_ = std::make_shared<Texture2D>(CreateTextureFromResource(device_.Get(), i().dllModule(), IDR_BG));
-    wheels_.push_back(std::make_unique<MountWheel>(bgTex_));
-    wheels_.push_back(std::make_unique<NoveltyWheel>(bgTex_));
-    wheels_.push_back(std::make_unique<MarkerWheel>(bgTex_));
-    wheels_.push_back(std::make_unique<ObjectMarkerWheel>(bgTex_));
-    wheels_.push_back(std::make_unique<TemplateWheel>(bgTex_));
-    wheels_.push_back(std::make_unique<ChatWheel>(bgTex_));
+    if (folder && ConfigSnapshot::IsCurrent(configPath))
+    {
+        auto snapshotScope  = startupProfile_.Measure("Config snapshot");
+        configSnapshotFile_ = std::make_unique<BlobCache::MappedFile>(ConfigSnapshot::PathFor(configPath));
+
+        std::error_code ec;
+        const auto      iniSize = std::filesystem::file_size(configPath, ec);
+        if (ec || !configSnapshot_.Open(configSnapshotFile_->data(), iniSize))
+            configSnapshotFile_.reset();
+    }
+
+    {
+        auto bgScope = startupProfile_.Measure("Background texture");
+        bgTex_       = std::make_shared<Texture2D>(CreateTextureFromResource(device_.Get(), i().dllModule(), IDR_BG));
+    }
+    iconAtlas_           = std::make_unique<IconAtlas>();
+    assetCache_          = std::make_unique<AssetCache>(folder ? *folder / L"asset_cache.bin" : std::filesystem::path{});
+    frameProfiler_       = std::make_unique<FrameProfiler>(std::make_unique<D3D11GpuTimer>(device_, context_));
+    actionChainExecutor_ = std::make_unique<ActionChainExecutor>();
+    configWriteBehind_   = std::make_unique<ConfigWriteBehind>(configPath,
+                                                               []() -> std::optional<std::string>
+                                                               {
+                                                                   std::string contents;
+                                                                   if (INIConfigurationFile::i().ini().Save(contents) < 0)
+                                                                       return std::nullopt;
+                                                                   return contents;
+                                                               },
+                                                               [](const std::string& contents)
+                                                               {
+                                                                   ConfigSnapshot::Writer snapshot;
+                                                                   ConfigSnapshot::AddAll(snapshot, INIConfigurationFile::i().ini());
+                                                                   return snapshot.Serialize(contents.size());
+                                                               });
+
+    const auto addWheel = [&](const char* name, auto&& make)
+    {
+        auto wheelScope = startupProfile_.Measure(name);
+        wheels_.push_back(make());
+        SettingsMenu::i().AddImplementer(wheels_.back().get());
+    };
+    addWheel("MountWheel", [&] { return std::make_unique<MountWheel>(bgTex_); });
+    addWheel("NoveltyWheel", [&] { return std::make_unique<NoveltyWheel>(bgTex_); });
+    addWheel("MarkerWheel", [&] { return std::make_unique<MarkerWheel>(bgTex_); });
+    addWheel("ObjectMarkerWheel", [&] { return std::make_unique<ObjectMarkerWheel>(bgTex_); });
+    addWheel("TemplateWheel", [&] { return std::make_unique<TemplateWheel>(bgTex_); });
+    addWheel("ChatWheel", [&] { return std::make_unique<ChatWheel>(bgTex_); });
 
     vertexCB_ = ShaderManager::i().MakeConstantBuffer<VertexCB>();
 }
 
 void Core::InnerInitPostImGui()
 {
+    auto scope         = startupProfile_.Measure("InitPostImGui");
+
     customWheels_      = std::make_unique<CustomWheelsManager>(bgTex_, wheels_, font_);
 
     firstMessageShown_ = std::make_unique<ConfigurationOption<bool>>("", "first_message_shown_v1", "Core", false);
+
+    configSnapshot_.Close();
+    configSnapshotFile_.reset();
+}
+
+std::string Core::ReadConfigValue(std::string_view section, std::string_view key) const
+{
+    if (auto value = configSnapshot_.Find(section, key))
+        return std::string(*value);
+
+    const char* value = INIConfigurationFile::i().ini().GetValue(std::string(section).c_str(), std::string(key).c_str(), "");
+    return value ? value : "";
 }
 
 void Core::InnerInternalInit()
@@ -156,6 +223,12 @@ void Core::InnerShutdown()
     comThread_.reset();
     wheels_.clear();
     customWheels_.reset();
+    iconAtlas_.reset();
+    assetCache_.reset();
+    frameProfiler_.reset();
+    actionChainExecutor_.reset();
+    // Flushes changes made since the last idle interval
+    configWriteBehind_.reset();
     bgTex_.reset();
     vertexCB_.reset();
 }
@@ -164,12 +237,26 @@ void Core::InnerUpdate()
 {
     for (auto& wheel : wheels_)
         wheel->OnUpdate();
+
+    platform_.FlushDeferredKeybinds();
+    actionQueue_.Update(std::int64_t(CurrentPlatform().clock->now()), std::exchange(queueConditionsChanged_, false));
+    configWriteBehind_->Update();
 }
 
 void Core::InnerDraw()
 {
+    frameProfiler_->BeginFrame();
+
+    {
+        auto scope = frameProfiler_->Measure("Icon atlas");
+        iconAtlas_->Update(context_.Get());
+    }
+
     for (auto& wheel : wheels_)
+    {
+        auto scope = frameProfiler_->Measure(wheel->displayName());
         wheel->Draw(context_.Get());
+    }
 
     customWheels_->Draw(context_.Get());
 
@@ -192,17 +279,26 @@ void Core::InnerDraw()
                 },
                 [&]() { firstMessageShown_->value(true); });
 
-    customWheels_->DrawOffscreen(context_.Get());
+    {
+        auto scope = frameProfiler_->Measure("Custom wheels offscreen");
+        customWheels_->DrawOffscreen(context_.Get());
+    }
 
     // Draw offscreen for ChatWheel text rendering
     for (auto& wheel : wheels_)
     {
         if (auto* chatWheel = dynamic_cast<ChatWheel*>(wheel.get()))
         {
+            auto scope = frameProfiler_->Measure("ChatWheel offscreen");
             chatWheel->DrawOffscreen(context_.Get());
         }
     }
 
+    assetCache_->Update(context_.Get());
+
+    frameProfiler_->EndFrame();
+    frameProfiler_->DrawOverlay();
+
     if (forceReloadWheels_)
     {
         forceReloadWheels_ = false;
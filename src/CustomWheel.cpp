@@ -1,14 +1,15 @@
 ﻿#include <Core.h>
 #include <CustomWheel.h>
 #include <DirectXTK/DDSTextureLoader.h>
-#include <DirectXTK/WICTextureLoader.h>
 #include <FileSystem.h>
 #include <ImGuiExtensions.h>
 #include <ImGuiPopup.h>
+#include <Log.h>
 #include <Wheel.h>
-#include <backends/imgui_impl_dx11.h>
 #include <filesystem>
+#include <format>
 #include <fstream>
+#include <wincodec.h>
 
 namespace GW2Radial
 {
@@ -21,112 +22,139 @@ float CalcText(ImFont* font, const std::wstring& text)
     return sz.x;
 }
 
-RenderTarget MakeTextTexture(float fontSize)
+// Custom wheels are read through FileSystem, which also sees into zip archives
+CustomWheelFiles GameFiles()
 {
-    auto       dev = Core::i().device();
-    const auto fmt = DXGI_FORMAT_R8G8B8A8_UNORM;
-
-    return MakeRenderTarget(dev, 1024, static_cast<u32>(fontSize), fmt);
+    return {
+        .exists     = [](const std::filesystem::path& path) { return FileSystem::Exists(path); },
+        .read       = [](const std::filesystem::path& path)
+        {
+            const auto& data  = FileSystem::ReadFile(path);
+            const auto* bytes = reinterpret_cast<const u8*>(data.data());
+            return std::vector<u8>(bytes, bytes + data.size());
+        },
+        .zipFolders = [](const std::filesystem::path& archive)
+        {
+            const auto& dirs = FileSystem::IterateZipFolders(archive);
+            return std::vector<std::filesystem::path>(dirs.begin(), dirs.end());
+        },
+    };
 }
 
-void DrawText(ID3D11DeviceContext* ctx, RenderTarget& rt, ID3D11BlendState* blendState, ImFont* font, float fontSize, const std::wstring& text)
+CustomIconData DecodeCustomIcon(const std::filesystem::path& path, std::span<const u8> data, std::wstring& error)
 {
-    const u32   fgColor = 0xFFFFFFFF;
-    const u32   bgColor = 0x00000000;
-
-    const auto& txt     = utf8_encode(text);
-
-    auto        sz      = font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, txt.c_str());
-
-    ImVec2      clip(1024.f, fontSize);
-
-    float       xOff = (clip.x - sz.x) * 0.5f;
-
-    ImDrawList  imDraw(ImGui::GetDrawListSharedData());
-    imDraw.AddDrawCmd();
-    imDraw.PushClipRect(ImVec2(0.f, 0.f), clip);
-    imDraw.PushTextureID(font->ContainerAtlas->TexID);
-    imDraw.AddText(font, fontSize, ImVec2(xOff, 0.f), fgColor, txt.c_str());
-
-    auto& io             = ImGui::GetIO();
-    auto  oldDisplaySize = io.DisplaySize;
-    io.DisplaySize       = clip;
-
-    ComPtr<ID3D11RenderTargetView> oldRt;
-    ComPtr<ID3D11DepthStencilView> oldDs;
-    ctx->OMGetRenderTargets(1, oldRt.GetAddressOf(), oldDs.GetAddressOf());
-    ctx->OMSetRenderTargets(1, rt.rtv.GetAddressOf(), nullptr);
-
-    float clearBlack[] = { 0.f, 0.f, 0.f, 0.f };
-    ctx->ClearRenderTargetView(rt.rtv.Get(), clearBlack);
-
-    ImDrawList* imDraws[] = { &imDraw };
-    ImDrawData  imData;
-    imData.Valid = true;
-    imData.CmdLists.clear();
-    imData.CmdLists.push_back(&imDraw);
-    imData.CmdListsCount = 1;
-    imData.TotalIdxCount = imDraw.IdxBuffer.Size;
-    imData.TotalVtxCount = imDraw.VtxBuffer.Size;
-    imData.DisplayPos    = ImVec2(0.0f, 0.0f);
-    imData.DisplaySize   = io.DisplaySize;
-
+    CustomIconData icon;
+    if (path.extension() == L".dds")
     {
-        ImGuiBlendStateOverride ov(blendState);
-        ImGui_ImplDX11_RenderDrawData(&imData);
+        icon.dds.assign(data.begin(), data.end());
+        return icon;
     }
 
-    ctx->OMSetRenderTargets(1, oldRt.GetAddressOf(), oldDs.Get());
+    const u64 cacheKey = AssetCache::ContentKey(data);
+    if (auto cached = Core::i().assetCache().Find(cacheKey))
+    {
+        icon.width  = cached->width;
+        icon.height = cached->height;
+        icon.pixels = std::move(cached->pixels);
+        return icon;
+    }
 
-    io.DisplaySize = oldDisplaySize;
-}
+    // Loader threads are our own, so COM can be initialized on them without affecting the game or other addons
+    thread_local const struct ComScope
+    {
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        ~ComScope()
+        {
+            if (SUCCEEDED(hr))
+                CoUninitialize();
+        }
+    } com;
 
-Texture2D LoadCustomTexture(const std::filesystem::path& path)
-{
-    if (!FileSystem::Exists(path))
+    const auto decode = [&]() -> HRESULT
     {
-        FormattedMessageBox(L"Could not load custom radial menu image '%s': file not found.", L"Custom Menu Error", path.wstring().c_str());
-        return {};
-    }
+        ComPtr<IWICImagingFactory> factory;
+        HRESULT                    hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(factory.GetAddressOf()));
+        if (FAILED(hr))
+            return hr;
+
+        ComPtr<IWICStream> stream;
+        if (FAILED(hr = factory->CreateStream(stream.GetAddressOf())))
+            return hr;
+        if (FAILED(hr = stream->InitializeFromMemory(const_cast<BYTE*>(data.data()), static_cast<DWORD>(data.size()))))
+            return hr;
+
+        ComPtr<IWICBitmapDecoder> decoder;
+        if (FAILED(hr = factory->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf())))
+            return hr;
+
+        ComPtr<IWICBitmapFrameDecode> frame;
+        if (FAILED(hr = decoder->GetFrame(0, frame.GetAddressOf())))
+            return hr;
+
+        UINT width, height;
+        if (FAILED(hr = frame->GetSize(&width, &height)))
+            return hr;
+        if (width == 0 || height == 0 || width > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || height > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+            return E_INVALIDARG;
+
+        ComPtr<IWICFormatConverter> converter;
+        if (FAILED(hr = factory->CreateFormatConverter(converter.GetAddressOf())))
+            return hr;
+        if (FAILED(hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeMedianCut)))
+            return hr;
+
+        icon.width  = width;
+        icon.height = height;
+        icon.pixels.resize(size_t(width) * height * 4);
+        return converter->CopyPixels(nullptr, width * 4, static_cast<UINT>(icon.pixels.size()), icon.pixels.data());
+    };
 
-    const auto& data = FileSystem::ReadFile(path);
-    if (data.empty())
+    if (HRESULT hr = decode(); FAILED(hr))
     {
-        FormattedMessageBox(L"Could not load custom radial menu image '%s': file is empty.", L"Custom Menu Error", path.wstring().c_str());
+        error = std::format(L"Could not load custom radial menu image '{}': 0x{:x}.", path.wstring(), static_cast<u32>(hr));
         return {};
     }
 
-    try
+    Core::i().assetCache().Store(cacheKey, icon.width, icon.height, icon.pixels);
+
+    return icon;
+}
+
+Texture2D UploadCustomTexture(const CustomIconData& icon, const std::filesystem::path& path, std::wstring& error)
+{
+    auto      dev = Core::i().device();
+    Texture2D tex;
+    HRESULT   hr = S_OK;
+    if (!icon.dds.empty())
     {
-        auto                   dev = Core::i().device();
-        Texture2D              tex;
         ComPtr<ID3D11Resource> res;
-        HRESULT                hr = S_OK;
-        if (path.extension() == L".dds")
-            hr = DirectX::CreateDDSTextureFromMemory(dev.Get(), data.data(), data.size(), &res, &tex.srv);
-        else
-        {
-            Core::i().RunCOMTask([&] { hr = DirectX::CreateWICTextureFromMemory(dev.Get(), data.data(), data.size(), &res, &tex.srv); });
-        }
+        hr = DirectX::CreateDDSTextureFromMemory(dev.Get(), icon.dds.data(), icon.dds.size(), &res, &tex.srv);
         if (res)
             res->QueryInterface(tex.texture.GetAddressOf());
-
-        if (!SUCCEEDED(hr))
-            FormattedMessageBox(L"Could not load custom radial menu image '%s': 0x%x.", L"Custom Menu Error", path.wstring().c_str(), hr);
-
-        return tex;
     }
-    catch (...)
+    else
     {
-        FormattedMessageBox(L"Could not load custom radial menu image '%s'.", L"Custom Menu Error", path.wstring().c_str());
+        CD3D11_TEXTURE2D_DESC  desc(DXGI_FORMAT_R8G8B8A8_UNORM, icon.width, icon.height, 1, 1);
+        D3D11_SUBRESOURCE_DATA initData{ icon.pixels.data(), icon.width * 4, 0 };
+        hr = dev->CreateTexture2D(&desc, &initData, tex.texture.GetAddressOf());
+        if (SUCCEEDED(hr))
+            hr = dev->CreateShaderResourceView(tex.texture.Get(), nullptr, tex.srv.GetAddressOf());
+    }
+
+    if (FAILED(hr))
+    {
+        error = std::format(L"Could not load custom radial menu image '{}': 0x{:x}.", path.wstring(), static_cast<u32>(hr));
         return {};
     }
+
+    return tex;
 }
 
 CustomWheelsManager::CustomWheelsManager(std::shared_ptr<Texture2D> bgTex, std::vector<std::unique_ptr<Wheel>>& wheels, ImFont* font)
     : wheels_(wheels)
     , font_(font)
     , backgroundTexture_(bgTex)
+    , loader_(GameFiles(), DecodeCustomIcon)
 {
     CD3D11_BLEND_DESC blendDesc(D3D11_DEFAULT);
     blendDesc.RenderTarget[0].BlendEnable    = true;
@@ -135,18 +163,27 @@ CustomWheelsManager::CustomWheelsManager(std::shared_ptr<Texture2D> bgTex, std::
     blendDesc.RenderTarget[0].SrcBlendAlpha  = D3D11_BLEND_ONE;
     blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
     GW2_CHECKED_HRESULT(Core::i().device()->CreateBlendState(&blendDesc, textBlendState_.GetAddressOf()));
+
+    labelBaker_ = std::make_unique<LabelBaker>(font_, textBlendState_);
 }
 
 void CustomWheelsManager::DrawOffscreen(ID3D11DeviceContext* ctx)
 {
     if (!loaded_)
         Reload();
-    else if (!textDraws_.empty())
+    else if (auto results = loader_.TakeResults())
+        ApplyReload(std::move(*results));
+
+    // Every label queued by the reload is drawn at once
+    if (labelBaker_->hasPending())
     {
-        auto& td = textDraws_.front();
-        DrawText(ctx, td.rt, textBlendState_.Get(), font_, td.size, td.text);
-        textDraws_.pop_front();
+        auto scope = Core::i().startupProfile().Measure("Custom wheel labels");
+        labelBaker_->Bake(ctx);
     }
+
+    // Startup is over once the first reload has been applied and its labels baked
+    if (loaded_ && !startupLoad_ && !Core::i().startupProfile().finished())
+        Core::i().startupProfile().Finish();
 }
 
 
@@ -169,173 +206,138 @@ void CustomWheelsManager::Draw(ID3D11DeviceContext* ctx)
             [&]() { failedLoads_.pop_back(); });
 }
 
-std::unique_ptr<Wheel> CustomWheelsManager::BuildWheel(const std::filesystem::path& configPath)
+std::unique_ptr<Wheel> CustomWheelsManager::BuildWheel(CustomWheelSettings& settings, u32 baseId, std::vector<LabelBaker::LabelHandle>& labels)
 {
-    const auto& dataFolder = configPath.parent_path();
-
-    auto        fail       = [&](const wchar_t* error)
+    auto fail = [&](const std::wstring& error)
     {
-        failedLoads_.push_back(error + (L": '" + configPath.wstring() + L"'"));
+        failedLoads_.push_back(error + L": '" + settings.configPath.wstring() + L"'");
         return nullptr;
     };
 
-    const auto& cfgSource = FileSystem::ReadFile(configPath);
-    if (cfgSource.empty())
+    if (!settings.error.empty())
+    {
+        failedLoads_.push_back(settings.error);
         return nullptr;
+    }
 
-    CSimpleIniA ini(true);
-    const auto& loadResult = ini.LoadData(reinterpret_cast<const char*>(cfgSource.data()), cfgSource.size());
-    if (loadResult != SI_OK)
-        return fail(L"Invalid INI file");
-
-    const auto& general          = *ini.GetSection("General");
-    const auto& wheelDisplayName = general.find("display_name");
-    const auto& wheelNickname    = general.find("nickname");
-
-    if (wheelDisplayName == general.end())
-        return fail(L"Missing field display_name");
-    if (wheelNickname == general.end())
-        return fail(L"Missing field nickname");
-
-    if (std::any_of(customWheels_.begin(), customWheels_.end(), [&](const auto& w) { return w->nickname() == wheelNickname->second; }))
-        return fail((L"Nickname " + utf8_decode(std::string(wheelNickname->second)) + L" already exists").c_str());
+    if (std::any_of(customWheels_.begin(), customWheels_.end(), [&](const auto& w) { return w.wheel->nickname() == settings.nickname; }))
+        return fail(L"Nickname " + utf8_decode(settings.nickname) + L" already exists");
 
-    auto                          wheel  = std::make_unique<Wheel>(backgroundTexture_, wheelNickname->second, wheelDisplayName->second);
+    if (settings.elements.size() > Wheel::MaxElementCount)
+        return fail(L"Too many elements (maximum is " + std::to_wstring(Wheel::MaxElementCount) + L")");
 
-    u32                           baseId = customWheelNextId_;
+    std::ranges::copy(settings.warnings, std::back_inserter(failedLoads_));
 
-    std::list<CSimpleIniA::Entry> sections;
-    ini.GetAllSections(sections);
-    sections.sort(CSimpleIniA::Entry::LoadOrder());
-    std::vector<CustomElementSettings> elements;
-    elements.reserve(sections.size());
-    float maxTextWidth = 0.f;
-    for (const auto& sec : sections)
+    std::vector<Texture2D> textures(settings.elements.size());
+    float                  maxTextWidth = 0.f;
+    for (size_t i = 0; i < settings.elements.size(); i++)
     {
-        if (_stricmp(sec.pItem, "General") == 0)
-            continue;
-
-        const auto& element                   = *ini.GetSection(sec.pItem);
-
-        const auto& elementName               = element.find("name");
-        const auto& elementColor              = element.find("color");
-        const auto& elementIcon               = element.find("icon");
-        const auto& elementShadow             = element.find("shadow_strength");
-        const auto& elementColorize           = element.find("colorize_strength");
-        const auto& elementPremultipliedAlpha = element.find("premultiply_alpha");
-        const auto& elementProps              = element.find("props");
-
-        glm::vec4   color{ 1.f };
-        if (elementColor != element.end())
-        {
-            std::array<std::string, 3> colorElems;
-            SplitString(elementColor->second, ",", colorElems.begin());
-
-            size_t i = 0;
-            for (const auto& c : colorElems)
-                reinterpret_cast<float*>(&color)[i++] = static_cast<float>(atof(c.c_str()) / 255.f);
-        }
-
-        CustomElementSettings ces;
-        ces.category    = wheel->nickname();
-        ces.nickname    = ToLower(wheel->nickname()) + "_" + ToLower(std::string(sec.pItem));
-        ces.name        = elementName == element.end() ? sec.pItem : elementName->second;
-        ces.color       = color;
-        ces.id          = baseId++;
-        ces.shadow      = elementShadow == element.end() ? 1.f : static_cast<float>(atof(elementShadow->second));
-        ces.colorize    = elementColorize == element.end() ? 1.f : static_cast<float>(atof(elementColorize->second));
-        ces.premultiply = false;
-        ces.props =
-            elementProps == element.end() ? ConditionalProperties::UsableAll | ConditionalProperties::VisibleAll : static_cast<ConditionalProperties>(atoi(elementProps->second));
-
-        if (elementIcon != element.end())
+        const auto& ces = settings.elements[i];
+        if (!ces.icon.empty())
         {
-            ces.rt = LoadCustomTexture(dataFolder / utf8_decode(elementIcon->second));
-            if (elementPremultipliedAlpha != element.end())
-                ces.premultiply = ini.GetBoolValue(sec.pItem, "premultiply_alpha", true);
+            std::wstring error;
+            textures[i] = UploadCustomTexture(ces.icon, ces.iconPath, error);
+            if (!error.empty())
+                failedLoads_.push_back(error);
         }
 
-        if (!ces.rt.texture)
+        if (!textures[i].texture)
             maxTextWidth = std::max(maxTextWidth, CalcText(font_, utf8_decode(ces.name)));
-
-        elements.push_back(ces);
-
-        GW2_ASSERT(baseId < customWheelNextId_ + CustomWheelIdStep);
     }
 
-    float desiredFontSize = 1024.f / maxTextWidth * 100.f;
+    float desiredFontSize = float(LabelWidth) / maxTextWidth * 100.f;
 
-    for (auto& ces : elements)
+    auto  wheel           = std::make_unique<Wheel>(backgroundTexture_, settings.nickname, settings.displayName);
+    SettingsMenu::i().AddImplementer(wheel.get());
+
+    u32   id              = baseId;
+    for (size_t i = 0; i < settings.elements.size(); i++)
     {
-        if (!ces.rt.texture)
+        const auto&              ces = settings.elements[i];
+        auto&                    tex = textures[i];
+        std::optional<AtlasRect> texRegion;
+        if (!tex.texture)
         {
-            ces.rt = MakeTextTexture(desiredFontSize);
-            textDraws_.push_back({ desiredFontSize, utf8_decode(ces.name), ces.rt });
+            auto label = labelBaker_->Add(utf8_decode(ces.name), desiredFontSize, LabelWidth, static_cast<u32>(desiredFontSize));
+            tex        = label->page->rt;
+            texRegion  = label->rect;
+            labels.push_back(std::move(label));
         }
 
-        auto we = std::make_unique<WheelElement>(ces.id, ces.nickname, ces.category, ces.name, ces.color, ces.props, ces.rt);
+        auto we = std::make_unique<WheelElement>(id++, ces.nickname, ces.category, ces.name, ces.color, ces.props, tex, texRegion);
         we->shadowStrength(ces.shadow);
         we->colorizeAmount(ces.colorize);
         we->premultiplyAlpha(ces.premultiply);
         wheel->AddElement(std::move(we));
-    }
 
-    customWheelNextId_ += CustomWheelIdStep;
+        GW2_ASSERT(id < baseId + CustomWheelIdStep);
+    }
 
     return std::move(wheel);
 }
 
 void CustomWheelsManager::Reload()
 {
-    failedLoads_.clear();
-    textDraws_.clear();
-    customWheelNextId_ = CustomWheelStartId;
+    loaded_ = true;
 
-    if (!customWheels_.empty())
+    if (!startupLoad_ && !Core::i().startupProfile().finished())
+        startupLoad_.emplace(Core::i().startupProfile().Measure("Custom wheel loading"));
+
+    // Existing wheels stay in use until the loader is done
+    if (auto folderBaseOpt = INIConfigurationFile::i().folder())
     {
-        std::erase_if(wheels_, [&](const auto& ptr) { return std::find(customWheels_.begin(), customWheels_.end(), ptr.get()) != customWheels_.end(); });
+        CustomWheelLoader::ContentHashes knownHashes;
+        for (const auto& lw : customWheels_)
+            knownHashes[lw.configPath] = lw.contentHash;
 
-        customWheels_.clear();
+        loader_.Start(*folderBaseOpt / L"custom", std::move(knownHashes));
     }
+    else
+        ApplyReload({});
+}
+
+void CustomWheelsManager::ApplyReload(std::vector<CustomWheelSettings> wheels)
+{
+    failedLoads_.clear();
+
+    // Wheels whose config and icons are unchanged are kept along with their textures and labels
+    const auto isUnchanged = [&](const LoadedWheel& lw)
+    { return std::any_of(wheels.begin(), wheels.end(), [&](const auto& s) { return s.unchanged && s.configPath == lw.configPath && s.contentHash == lw.contentHash; }); };
+
+    std::vector<const Wheel*> removed;
+    for (const auto& lw : customWheels_)
+        if (!isUnchanged(lw))
+            removed.push_back(lw.wheel);
 
-    auto folderBaseOpt = INIConfigurationFile::i().folder();
-    if (folderBaseOpt)
+    if (!removed.empty())
     {
-        auto folderBase = *folderBaseOpt / L"custom";
+        const auto isRemoved = [&](const Wheel* w) { return std::find(removed.begin(), removed.end(), w) != removed.end(); };
+        std::erase_if(customWheels_, [&](const auto& lw) { return isRemoved(lw.wheel); });
+        std::erase_if(wheels_, [&](const auto& ptr) { return isRemoved(ptr.get()); });
+    }
+
+    const size_t keptCount = customWheels_.size();
+    for (auto& settings : wheels)
+    {
+        if (settings.unchanged && std::any_of(customWheels_.begin(), customWheels_.end(), [&](const auto& lw) { return lw.configPath == settings.configPath; }))
+            continue;
+
+        u32 baseId = CustomWheelStartId;
+        while (std::any_of(customWheels_.begin(), customWheels_.end(), [&](const auto& lw) { return lw.baseId == baseId; }))
+            baseId += CustomWheelIdStep;
 
-        if (exists(folderBase))
+        auto                                 scope = Core::i().startupProfile().Measure(std::format("Custom wheel '{}'", settings.nickname));
+        std::vector<LabelBaker::LabelHandle> labels;
+        auto                                 wheel = BuildWheel(settings, baseId, labels);
+        if (wheel)
         {
-            auto addWheel = [&](const std::filesystem::path& configFile)
-            {
-                auto wheel = BuildWheel(configFile);
-                if (wheel)
-                {
-                    wheels_.push_back(std::move(wheel));
-                    customWheels_.push_back(wheels_.back().get());
-                }
-            };
-
-            for (const auto& entry : std::filesystem::directory_iterator(folderBase))
-            {
-                if (!entry.is_directory() && entry.path().extension() != L".zip")
-                    continue;
-
-                std::filesystem::path configFile = entry.path() / L"config.ini";
-                if (FileSystem::Exists(configFile))
-                    addWheel(configFile);
-                else if (auto dirs = FileSystem::IterateZipFolders(entry.path()); !dirs.empty())
-                {
-                    for (const auto& subdir : dirs)
-                    {
-                        std::filesystem::path subdirCfgFile = subdir / L"config.ini";
-                        if (FileSystem::Exists(subdirCfgFile))
-                            addWheel(subdirCfgFile);
-                    }
-                }
-            }
+            wheels_.push_back(std::move(wheel));
+            customWheels_.push_back({ settings.configPath, settings.contentHash, baseId, wheels_.back().get(), std::move(labels) });
         }
     }
 
-    loaded_ = true;
+    LogInfo("Reloaded custom wheels: {} unchanged, {} built, {} discarded", keptCount, customWheels_.size() - keptCount, removed.size());
+
+    startupLoad_.reset();
 }
 } // namespace GW2Radial
@@ -0,0 +1,254 @@
+#include <CustomWheelLoader.h>
+#include <SimpleIni.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <utility>
+#include <xxhash.h>
+
+namespace GW2Radial
+{
+namespace
+{
+constexpr std::uint32_t DefaultProps = static_cast<std::uint32_t>(ConditionalProperties::UsableAll) | static_cast<std::uint32_t>(ConditionalProperties::VisibleAll);
+
+std::string             ToLowerAscii(std::string s)
+{
+    std::ranges::transform(s, s.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return s;
+}
+} // namespace
+
+CustomWheelSettings ParseCustomWheel(const std::filesystem::path& configPath, std::span<const std::uint8_t> source)
+{
+    CustomWheelSettings settings;
+    settings.configPath = configPath;
+
+    auto fail           = [&](const std::wstring& error)
+    {
+        settings.error = error + L": '" + configPath.wstring() + L"'";
+        return settings;
+    };
+
+    CSimpleIniA ini(true);
+    const auto& loadResult = ini.LoadData(reinterpret_cast<const char*>(source.data()), source.size());
+    if (loadResult != SI_OK)
+        return fail(L"Invalid INI file");
+
+    const auto* generalPtr = ini.GetSection("General");
+    if (!generalPtr)
+        return fail(L"Missing section General");
+
+    const auto& general          = *generalPtr;
+    const auto& wheelDisplayName = general.find("display_name");
+    const auto& wheelNickname    = general.find("nickname");
+
+    if (wheelDisplayName == general.end())
+        return fail(L"Missing field display_name");
+    if (wheelNickname == general.end())
+        return fail(L"Missing field nickname");
+
+    settings.nickname    = wheelNickname->second;
+    settings.displayName = wheelDisplayName->second;
+
+    const auto&                   dataFolder = configPath.parent_path();
+
+    std::list<CSimpleIniA::Entry> sections;
+    ini.GetAllSections(sections);
+    sections.sort(CSimpleIniA::Entry::LoadOrder());
+    settings.elements.reserve(sections.size());
+    for (const auto& sec : sections)
+    {
+        if (ToLowerAscii(sec.pItem) == "general")
+            continue;
+
+        const auto& element                   = *ini.GetSection(sec.pItem);
+
+        const auto& elementName               = element.find("name");
+        const auto& elementColor              = element.find("color");
+        const auto& elementIcon               = element.find("icon");
+        const auto& elementShadow             = element.find("shadow_strength");
+        const auto& elementColorize           = element.find("colorize_strength");
+        const auto& elementPremultipliedAlpha = element.find("premultiply_alpha");
+        const auto& elementProps              = element.find("props");
+
+        glm::vec4   color{ 1.f };
+        if (elementColor != element.end())
+        {
+            // Comma separated 0-255 channels, missing ones are zero
+            const char* channel = elementColor->second;
+            for (int i = 0; i < 3; i++)
+            {
+                color[i] = channel ? static_cast<float>(atof(channel) / 255.f) : 0.f;
+                if (channel && (channel = std::strchr(channel, ',')))
+                    channel++;
+            }
+        }
+
+        CustomElementSettings ces;
+        ces.category    = settings.nickname;
+        ces.nickname    = ToLowerAscii(settings.nickname) + "_" + ToLowerAscii(sec.pItem);
+        ces.name        = elementName == element.end() ? sec.pItem : elementName->second;
+        ces.color       = color;
+        ces.shadow      = elementShadow == element.end() ? 1.f : static_cast<float>(atof(elementShadow->second));
+        ces.colorize    = elementColorize == element.end() ? 1.f : static_cast<float>(atof(elementColorize->second));
+        ces.premultiply = false;
+        ces.props       = static_cast<ConditionalProperties>(elementProps == element.end() ? DefaultProps : std::uint32_t(atoi(elementProps->second)));
+
+        if (elementIcon != element.end())
+        {
+            ces.iconPath = dataFolder / std::u8string(reinterpret_cast<const char8_t*>(elementIcon->second));
+            if (elementPremultipliedAlpha != element.end())
+                ces.premultiply = ini.GetBoolValue(sec.pItem, "premultiply_alpha", true);
+        }
+
+        settings.elements.push_back(std::move(ces));
+    }
+
+    return settings;
+}
+
+void CustomWheelLoader::Start(std::filesystem::path folder, ContentHashes knownHashes)
+{
+    {
+        std::lock_guard lk(resultsMutex_);
+        results_.reset();
+    }
+
+    // Assigning over a running thread requests it to stop and joins it
+    thread_ = std::jthread([this, folder = std::move(folder), knownHashes = std::move(knownHashes)](std::stop_token stopToken) { Run(stopToken, folder, knownHashes); });
+}
+
+std::optional<std::vector<CustomWheelSettings>> CustomWheelLoader::TakeResults()
+{
+    std::lock_guard lk(resultsMutex_);
+    return std::exchange(results_, std::nullopt);
+}
+
+void CustomWheelLoader::Run(const std::stop_token& stopToken, const std::filesystem::path& folder, const ContentHashes& knownHashes)
+{
+    std::vector<std::filesystem::path> configFiles;
+    if (std::error_code ec; std::filesystem::exists(folder, ec))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(folder, ec))
+        {
+            if (!entry.is_directory() && entry.path().extension() != L".zip")
+                continue;
+
+            std::filesystem::path configFile = entry.path() / L"config.ini";
+            if (files_.exists(configFile))
+                configFiles.push_back(configFile);
+            else if (auto dirs = files_.zipFolders(entry.path()); !dirs.empty())
+            {
+                for (const auto& subdir : dirs)
+                {
+                    std::filesystem::path subdirCfgFile = subdir / L"config.ini";
+                    if (files_.exists(subdirCfgFile))
+                        configFiles.push_back(subdirCfgFile);
+                }
+            }
+        }
+
+        // Directory order is unspecified, wheels are always handed over in the same order
+        std::ranges::sort(configFiles);
+    }
+
+    // Unreadable configs are skipped silently, like a folder without a config.ini
+    std::vector<std::optional<CustomWheelSettings>> wheels(configFiles.size());
+    std::atomic<size_t>                             next = 0;
+    auto                                            work = [&]
+    {
+        for (size_t i = next++; i < configFiles.size() && !stopToken.stop_requested(); i = next++)
+        {
+            const auto source = files_.read(configFiles[i]);
+            if (source.empty())
+                continue;
+
+            auto settings = ParseCustomWheel(configFiles[i], source);
+            if (settings.error.empty())
+                LoadIcons(stopToken, settings, knownHashes, source);
+
+            wheels[i] = std::move(settings);
+        }
+    };
+
+    {
+        const size_t             workerCount = std::min<size_t>(configFiles.size(), std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1);
+
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; i++)
+            workers.emplace_back(work);
+        for (auto& w : workers)
+            w.join();
+    }
+
+    if (stopToken.stop_requested())
+        return;
+
+    std::vector<CustomWheelSettings> results;
+    results.reserve(wheels.size());
+    for (auto& w : wheels)
+        if (w)
+            results.push_back(std::move(*w));
+
+    std::lock_guard lk(resultsMutex_);
+    results_ = std::move(results);
+}
+
+void CustomWheelLoader::LoadIcons(const std::stop_token& stopToken, CustomWheelSettings& settings, const ContentHashes& knownHashes,
+                                  std::span<const std::uint8_t> configSource) const
+{
+    // Read everything first so the hash covers all inputs before deciding whether decoding is needed
+    std::uint64_t                          hash = XXH3_64bits(configSource.data(), configSource.size());
+    std::vector<std::vector<std::uint8_t>> iconSources(settings.elements.size());
+    std::vector<std::wstring>              iconWarnings;
+    for (size_t i = 0; i < settings.elements.size() && !stopToken.stop_requested(); i++)
+    {
+        const auto& path = settings.elements[i].iconPath;
+        if (path.empty())
+            continue;
+
+        const auto& pathString = path.wstring();
+        hash                   = XXH3_64bits_withSeed(pathString.data(), pathString.size() * sizeof(wchar_t), hash);
+
+        if (!files_.exists(path))
+        {
+            iconWarnings.push_back(L"Could not load custom radial menu image '" + pathString + L"': file not found.");
+            continue;
+        }
+
+        iconSources[i] = files_.read(path);
+        if (iconSources[i].empty())
+        {
+            iconWarnings.push_back(L"Could not load custom radial menu image '" + pathString + L"': file is empty.");
+            continue;
+        }
+
+        hash = XXH3_64bits_withSeed(iconSources[i].data(), iconSources[i].size(), hash);
+    }
+
+    settings.contentHash = hash;
+    if (auto it = knownHashes.find(settings.configPath); it != knownHashes.end() && it->second == hash)
+    {
+        settings.unchanged = true;
+        return;
+    }
+
+    settings.warnings = std::move(iconWarnings);
+    for (size_t i = 0; i < settings.elements.size() && !stopToken.stop_requested(); i++)
+    {
+        if (iconSources[i].empty())
+            continue;
+
+        auto&        ces = settings.elements[i];
+        std::wstring error;
+        ces.icon = decoder_(ces.iconPath, iconSources[i], error);
+        if (!error.empty())
+            settings.warnings.push_back(error);
+    }
+}
+} // namespace GW2Radial
@@ -0,0 +1,102 @@
+#include <D3D11GpuTimer.h>
+
+namespace GW2Radial
+{
+D3D11GpuTimer::D3D11GpuTimer(ComPtr<ID3D11Device> device, ComPtr<ID3D11DeviceContext> context)
+    : device_(std::move(device))
+    , context_(std::move(context))
+{
+    for (auto& f : frames_)
+        f.disjoint = MakeQuery(D3D11_QUERY_TIMESTAMP_DISJOINT);
+}
+
+ComPtr<ID3D11Query> D3D11GpuTimer::MakeQuery(D3D11_QUERY type) const
+{
+    CD3D11_QUERY_DESC   desc(type);
+    ComPtr<ID3D11Query> query;
+    GW2_CHECKED_HRESULT(device_->CreateQuery(&desc, query.GetAddressOf()));
+
+    return query;
+}
+
+void D3D11GpuTimer::BeginFrame()
+{
+    auto& f    = frames_[current_];
+    recording_ = !f.pending;
+    if (!recording_)
+        return;
+
+    f.used = 0;
+    context_->Begin(f.disjoint.Get());
+}
+
+void D3D11GpuTimer::EndFrame()
+{
+    if (!recording_)
+        return;
+
+    auto& f = frames_[current_];
+    context_->End(f.disjoint.Get());
+    f.pending  = true;
+    current_   = (current_ + 1) % FrameLatency;
+    recording_ = false;
+    open_.clear();
+}
+
+void D3D11GpuTimer::Begin(u32 section)
+{
+    if (!recording_)
+        return;
+
+    auto& f = frames_[current_];
+    if (f.used == f.intervals.size())
+        f.intervals.push_back({ 0, MakeQuery(D3D11_QUERY_TIMESTAMP), MakeQuery(D3D11_QUERY_TIMESTAMP) });
+
+    auto& interval   = f.intervals[f.used];
+    interval.section = section;
+    context_->End(interval.begin.Get());
+    open_.push_back(f.used++);
+}
+
+void D3D11GpuTimer::End()
+{
+    if (!recording_ || open_.empty())
+        return;
+
+    context_->End(frames_[current_].intervals[open_.back()].end.Get());
+    open_.pop_back();
+}
+
+void D3D11GpuTimer::Collect(std::vector<GpuFrameTimes>& frames)
+{
+    while (frames_[oldest_].pending)
+    {
+        auto&                               f = frames_[oldest_];
+
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+        if (context_->GetData(f.disjoint.Get(), &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            break;
+
+        f.pending = false;
+        oldest_   = (oldest_ + 1) % FrameLatency;
+
+        // Timestamps are meaningless if the GPU clock changed during the frame
+        if (disjoint.Disjoint)
+            continue;
+
+        GpuFrameTimes times;
+        for (u32 i = 0; i < f.used; i++)
+        {
+            const auto& interval = f.intervals[i];
+            u64         begin, end;
+            if (context_->GetData(interval.begin.Get(), &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+                context_->GetData(interval.end.Get(), &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+                continue;
+
+            times.ms[interval.section] += float(double(end - begin) * 1000.0 / double(disjoint.Frequency));
+            times.used.set(interval.section);
+        }
+        frames.push_back(times);
+    }
+}
+} // namespace GW2Radial
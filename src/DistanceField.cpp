@@ -0,0 +1,117 @@
+#include <DistanceField.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GW2Radial::DistanceField
+{
+namespace
+{
+// Stands in for infinity where no seed is reachable, small enough that the parabola intersections below stay finite
+constexpr float Far = 1e20f;
+
+// Squared distance transform of one row or column (Felzenszwalb & Huttenlocher), in place; scratch buffers are sized by the caller
+void            Transform1D(float* f, size_t stride, size_t n, std::vector<float>& d, std::vector<int>& v, std::vector<float>& z)
+{
+    const auto at        = [&](int q) { return f[size_t(q) * stride]; };
+    const auto intersect = [&](int q, int p) { return ((at(q) + float(q * q)) - (at(p) + float(p * p))) / float(2 * (q - p)); };
+
+    int        k         = 0;
+    v[0]                 = 0;
+    z[0]                 = -std::numeric_limits<float>::infinity();
+    z[1]                 = std::numeric_limits<float>::infinity();
+    for (int q = 1; q < int(n); q++)
+    {
+        float s = intersect(q, v[k]);
+        while (k > 0 && s <= z[k])
+        {
+            k--;
+            s = intersect(q, v[k]);
+        }
+        k++;
+        v[k]     = q;
+        z[k]     = s;
+        z[k + 1] = std::numeric_limits<float>::infinity();
+    }
+
+    k = 0;
+    for (int q = 0; q < int(n); q++)
+    {
+        while (z[k + 1] < float(q))
+            k++;
+        const float dq = float(q - v[k]);
+        d[q]           = dq * dq + at(v[k]);
+    }
+    for (size_t q = 0; q < n; q++)
+        f[q * stride] = d[q];
+}
+
+// Squared distance from every pixel to the nearest pixel where seed is true
+std::vector<float> Transform2D(const std::vector<bool>& seed, uint32_t width, uint32_t height)
+{
+    std::vector<float> f(seed.size());
+    for (size_t i = 0; i < seed.size(); i++)
+        f[i] = seed[i] ? 0.f : Far;
+
+    const size_t       n = std::max(width, height);
+    std::vector<float> d(n), z(n + 1);
+    std::vector<int>   v(n);
+    for (uint32_t x = 0; x < width; x++)
+        Transform1D(f.data() + x, width, height, d, v, z);
+    for (uint32_t y = 0; y < height; y++)
+        Transform1D(f.data() + size_t(y) * width, 1, width, d, v, z);
+
+    return f;
+}
+} // namespace
+
+uint8_t Encode(float distance, float spread)
+{
+    const float value = 0.5f - distance / (2.f * spread);
+    return uint8_t(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+std::vector<uint8_t> Generate(std::span<const uint8_t> coverage, uint32_t width, uint32_t height, float spread, uint32_t factor)
+{
+    factor = std::max(factor, 1u);
+    if (coverage.size() < size_t(width) * height || width < factor || height < factor)
+        return {};
+
+    std::vector<bool> inside(size_t(width) * height), outside(size_t(width) * height);
+    for (size_t i = 0; i < inside.size(); i++)
+    {
+        inside[i]  = coverage[i] >= 128;
+        outside[i] = !inside[i];
+    }
+
+    // Distance to the nearest pixel of the other side; the edge lies halfway, half a pixel before it
+    const auto toInside  = Transform2D(inside, width, height);
+    const auto toOutside = Transform2D(outside, width, height);
+
+    std::vector<float> signedDistance(inside.size());
+    for (size_t i = 0; i < signedDistance.size(); i++)
+    {
+        const uint8_t c = coverage[i];
+        if (c > 0 && c < 255)
+            signedDistance[i] = 0.5f - float(c) / 255.f; // antialiased edge pixels know where the edge crosses them
+        else if (inside[i])
+            signedDistance[i] = 0.5f - std::sqrt(toOutside[i]);
+        else
+            signedDistance[i] = std::sqrt(toInside[i]) - 0.5f;
+    }
+
+    const uint32_t       outWidth = width / factor, outHeight = height / factor;
+    std::vector<uint8_t> field(size_t(outWidth) * outHeight);
+    for (uint32_t y = 0; y < outHeight; y++)
+        for (uint32_t x = 0; x < outWidth; x++)
+        {
+            float sum = 0.f;
+            for (uint32_t by = 0; by < factor; by++)
+                for (uint32_t bx = 0; bx < factor; bx++)
+                    sum += signedDistance[size_t(y * factor + by) * width + x * factor + bx];
+            field[size_t(y) * outWidth + x] = Encode(sum / float(factor * factor), spread);
+        }
+
+    return field;
+}
+} // namespace GW2Radial::DistanceField
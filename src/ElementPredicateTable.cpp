@@ -0,0 +1,90 @@
+#include <ElementPredicateTable.h>
+#include <cassert>
+
+namespace GW2Radial
+{
+namespace
+{
+constexpr size_t AnyStateIndexBit = 16;
+static_assert(GameCondition::All < AnyStateIndexBit);
+
+// Inverse of StateIndex, in the key form the compiled props masks are tested against
+std::uint32_t StateKeyForIndex(size_t index)
+{
+    return StateKey((index & AnyStateIndexBit) ? std::uint32_t(index) & GameCondition::All : GameCondition::None);
+}
+} // namespace
+
+size_t ElementPredicateTable::StateIndex(std::uint32_t conditions)
+{
+    conditions &= GameCondition::All;
+    return conditions == GameCondition::None ? 0 : AnyStateIndexBit | conditions;
+}
+
+size_t ElementPredicateTable::FirstSet(const Mask& mask)
+{
+    for (size_t i = 0; i < mask.size(); i++)
+        if (mask.test(i))
+            return i;
+
+    return mask.size();
+}
+
+void ElementPredicateTable::Compile(std::span<const ElementConditions> elements)
+{
+    // Plain assert, this file also builds without GW2Common
+    assert(elements.size() <= Capacity);
+
+    visible_.fill({});
+    usable_.fill({});
+    bound_.reset();
+    overrides_.reset();
+    prechecks_.reset();
+    gateRequired_.assign(elements.size(), 0);
+    gateValid_ = false;
+
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+        const auto& we = elements[i];
+        if (we.bound)
+            bound_.set(i);
+        overrides_.set(i, we.gate.mode == GateMode::Override);
+        prechecks_.set(i, we.gate.mode == GateMode::Precheck);
+        gateRequired_[i] = we.gate.required;
+
+        if (!we.bound)
+            continue;
+
+        for (size_t s = 0; s < StateCount; s++)
+        {
+            const std::uint32_t key = StateKeyForIndex(s);
+            visible_[s].set(i, (key & ~we.visibleStates) == 0);
+            usable_[s].set(i, (key & ~we.usableStates) == 0);
+        }
+    }
+
+    valid_ = true;
+}
+
+const ElementPredicateTable::Mask& ElementPredicateTable::GatePasses(std::uint64_t stateWord) const
+{
+    if (!gateValid_ || gateStateWord_ != stateWord)
+    {
+        gatePasses_.reset();
+        for (size_t i = 0; i < gateRequired_.size(); i++)
+            gatePasses_.set(i, (stateWord & gateRequired_[i]) == gateRequired_[i]);
+
+        gateStateWord_ = stateWord;
+        gateValid_     = true;
+    }
+
+    return gatePasses_;
+}
+
+ElementPredicateTable::Mask ElementPredicateTable::ApplyGates(const Mask& byProps, std::uint64_t stateWord) const
+{
+    // Same truth table as EvaluateElement: prechecks must also pass their gate, overrides pass on their gate alone
+    const auto& passes = GatePasses(stateWord);
+    return (byProps & (~prechecks_ | passes)) | (overrides_ & passes);
+}
+} // namespace GW2Radial
@@ -0,0 +1,77 @@
+#include <FlickRecognizer.h>
+#include <algorithm>
+#include <utility>
+
+namespace GW2Radial
+{
+void FlickRecognizer::Reset(std::int64_t time, const Thresholds& thresholds)
+{
+    thresholds_     = thresholds;
+    state_          = State::Armed;
+    lastSampleTime_ = time;
+    startTime_      = time;
+}
+
+std::optional<glm::vec2> FlickRecognizer::Feed(std::int64_t time, glm::vec2 offset)
+{
+    const float        length   = glm::length(offset);
+    const bool         inside   = length <= thresholds_.deadZone;
+    const std::int64_t previous = std::exchange(lastSampleTime_, time);
+
+    switch (state_)
+    {
+        case State::Committed:
+            return std::nullopt;
+        case State::Rejected:
+            if (inside)
+                state_ = State::Armed;
+            return std::nullopt;
+        case State::Armed:
+            if (inside)
+                return std::nullopt;
+
+            // The gesture began at the last sample before this one, unless the cursor was at rest until now
+            state_     = State::Tracking;
+            startTime_ = time - previous > thresholds_.maxDuration ? time : previous;
+            break;
+        case State::Tracking:
+            if (inside)
+            {
+                state_ = State::Armed;
+                return std::nullopt;
+            }
+            break;
+    }
+
+    const std::int64_t elapsed = time - startTime_;
+    if (elapsed > thresholds_.maxDuration)
+    {
+        state_ = State::Rejected;
+        return std::nullopt;
+    }
+
+    if (length < thresholds_.distance)
+        return std::nullopt;
+
+    const float speed = (length - thresholds_.deadZone) / static_cast<float>(std::max<std::int64_t>(elapsed, 1));
+    if (speed < thresholds_.minSpeed)
+    {
+        state_ = State::Rejected;
+        return std::nullopt;
+    }
+
+    state_ = State::Committed;
+    return offset;
+}
+
+std::optional<glm::vec2> FlickRecognizer::Replay(std::span<const HoverTracker::Sample> samples, const Thresholds& thresholds)
+{
+    FlickRecognizer recognizer;
+    recognizer.Reset(samples.empty() ? 0 : samples.front().time, thresholds);
+    for (const auto& s : samples)
+        if (auto offset = recognizer.Feed(s.time, s.offset))
+            return offset;
+
+    return std::nullopt;
+}
+} // namespace GW2Radial
@@ -0,0 +1,177 @@
+#include <ConfigurationFile.h>
+#include <FrameProfiler.h>
+#include <Log.h>
+#include <Utility.h>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <imgui.h>
+
+namespace GW2Radial
+{
+void RollingHistogram::Add(float value)
+{
+    samples_[next_] = value;
+    next_           = (next_ + 1) % Capacity;
+    count_          = std::min(count_ + 1, Capacity);
+}
+
+RollingHistogram::Stats RollingHistogram::stats() const
+{
+    if (count_ == 0)
+        return {};
+
+    std::array<float, Capacity> sorted;
+    std::copy_n(samples_.begin(), count_, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + count_);
+
+    const auto at = [&](float q) { return sorted[std::min(count_ - 1, u32(q * float(count_ - 1) + 0.5f))]; };
+
+    return { at(0.5f), at(0.99f), sorted[count_ - 1], count_ };
+}
+
+FrameProfiler::FrameProfiler(std::unique_ptr<GpuTimerBackend> gpu)
+    : gpu_(gpu ? std::move(gpu) : std::make_unique<NullGpuTimerBackend>())
+{
+}
+
+FrameProfiler::Scope FrameProfiler::Begin(std::string_view name)
+{
+    auto it = std::find_if(sections_.begin(), sections_.end(), [&](const auto& s) { return s.name == name; });
+    if (it == sections_.end())
+    {
+        if (sections_.size() >= MaxProfilerSections)
+            return {};
+
+        sections_.push_back({ std::string(name) });
+        it = sections_.end() - 1;
+    }
+
+    const auto section = u32(it - sections_.begin());
+    gpu_->Begin(section);
+
+    return { this, section };
+}
+
+void FrameProfiler::End(u32 section, Clock::time_point start)
+{
+    gpu_->End();
+
+    // Sections entered several times per frame, such as one per wheel, report their sum
+    auto& s = sections_[section];
+    s.cpuMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    s.cpuActive = true;
+}
+
+void FrameProfiler::BeginFrame()
+{
+    active_ = enabled_;
+    if (!active_)
+        return;
+
+    frameStart_ = Clock::now();
+    gpu_->BeginFrame();
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (!active_)
+        return;
+    active_ = false;
+
+    gpu_->EndFrame();
+    frameCpu_.Add(std::chrono::duration<float, std::milli>(Clock::now() - frameStart_).count());
+
+    for (auto& s : sections_)
+    {
+        if (s.cpuActive)
+            s.cpu.Add(s.cpuMs);
+        s.cpuMs     = 0.f;
+        s.cpuActive = false;
+    }
+
+    gpuFrames_.clear();
+    gpu_->Collect(gpuFrames_);
+    for (const auto& f : gpuFrames_)
+        for (u32 i = 0; i < sections_.size(); i++)
+            if (f.used[i])
+                sections_[i].gpu.Add(f.ms[i]);
+}
+
+std::string FrameProfiler::ToCsv() const
+{
+    std::string csv = "section,samples,cpu_p50_ms,cpu_p99_ms,cpu_max_ms,gpu_samples,gpu_p50_ms,gpu_p99_ms,gpu_max_ms\n";
+
+    const auto  row = [&](const std::string& name, const RollingHistogram::Stats& cpu, const RollingHistogram::Stats& gpu)
+    { csv += std::format("\"{}\",{},{:.4f},{:.4f},{:.4f},{},{:.4f},{:.4f},{:.4f}\n", name, cpu.count, cpu.p50, cpu.p99, cpu.max, gpu.count, gpu.p50, gpu.p99, gpu.max); };
+
+    row("Frame", frameCpu_.stats(), {});
+    for (const auto& s : sections_)
+        row(s.name, s.cpu.stats(), s.gpu.stats());
+
+    return csv;
+}
+
+void FrameProfiler::DrawOverlay()
+{
+    if (!enabled_)
+        return;
+
+    ImGui::SetNextWindowSize(ImVec2(520.f, 0.f), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Radial menu frame profiler", &enabled_))
+    {
+        const auto frame = frameCpu_.stats();
+        ImGui::Text("Total: %.3f ms (p50) / %.3f ms (p99) / %.3f ms (max) over %u frames", frame.p50, frame.p99, frame.max, frame.count);
+
+        if (ImGui::BeginTable("FrameProfiler", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Section");
+            ImGui::TableSetupColumn("CPU p50");
+            ImGui::TableSetupColumn("CPU p99");
+            ImGui::TableSetupColumn("CPU max");
+            ImGui::TableSetupColumn("GPU p50");
+            ImGui::TableSetupColumn("GPU p99");
+            ImGui::TableSetupColumn("GPU max");
+            ImGui::TableHeadersRow();
+
+            for (const auto& s : sections_)
+            {
+                const auto cpu = s.cpu.stats();
+                const auto gpu = s.gpu.stats();
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(s.name.c_str());
+                for (float v : { cpu.p50, cpu.p99, cpu.max })
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", v);
+                }
+                for (float v : { gpu.p50, gpu.p99, gpu.max })
+                {
+                    ImGui::TableNextColumn();
+                    if (gpu.count > 0)
+                        ImGui::Text("%.3f", v);
+                    else
+                        ImGui::TextUnformatted("-");
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Export CSV"))
+        {
+            if (auto folder = INIConfigurationFile::i().folder())
+            {
+                const auto path = *folder / L"frame_profile.csv";
+                std::ofstream(path, std::ios::trunc) << ToCsv();
+                LogInfo("Frame profile written to '{}'", utf8_encode(path.wstring()));
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Copy CSV"))
+            ImGui::SetClipboardText(ToCsv().c_str());
+    }
+    ImGui::End();
+}
+} // namespace GW2Radial
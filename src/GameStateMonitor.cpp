@@ -0,0 +1,79 @@
+#include <GameStateMonitor.h>
+#include <algorithm>
+#include <utility>
+
+namespace GW2Radial
+{
+std::uint32_t GameStateMonitor::Diff(const GameSnapshot& a, const GameSnapshot& b)
+{
+    std::uint32_t changed = 0;
+    if (a.state != b.state)
+        changed |= StateField;
+    if (a.mounted != b.mounted)
+        changed |= MountedField;
+    if (a.mapOpen != b.mapOpen)
+        changed |= MapOpenField;
+    if (a.gameHasFocus != b.gameHasFocus)
+        changed |= FocusField;
+    if (a.textboxHasFocus != b.textboxHasFocus)
+        changed |= TextboxFocusField;
+    if (a.mapId != b.mapId)
+        changed |= MapField;
+    if (a.characterName != b.characterName)
+        changed |= CharacterField;
+    return changed;
+}
+
+GameStateMonitor::ListenerId GameStateMonitor::Subscribe(std::uint32_t fields, Listener listener)
+{
+    const auto id = nextId_++;
+    subscriptions_.push_back({ id, fields, std::move(listener) });
+    return id;
+}
+
+void GameStateMonitor::Unsubscribe(ListenerId id)
+{
+    auto it = std::ranges::find(subscriptions_, id, &Subscription::id);
+    if (it == subscriptions_.end())
+        return;
+
+    // Erasing would shift the entries Publish is iterating over, so only drop the listener until it is done
+    if (publishing_)
+        it->listener = nullptr;
+    else
+        subscriptions_.erase(it);
+}
+
+std::uint32_t GameStateMonitor::Publish(GameSnapshot snapshot)
+{
+    const std::uint32_t changed = published_ ? Diff(current_, snapshot) : AllFields;
+    published_                  = true;
+    if (changed == 0)
+        return 0;
+
+    GameSnapshot previous = std::exchange(current_, std::move(snapshot));
+
+    // Listeners added while notifying are past this bound and wait for the next change
+    publishing_           = true;
+    const size_t count    = subscriptions_.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!(subscriptions_[i].fields & changed) || !subscriptions_[i].listener)
+            continue;
+
+        // Copied since subscribing from within the listener may reallocate the vector under it
+        const auto listener = subscriptions_[i].listener;
+        listener(previous, current_, changed);
+    }
+    publishing_ = false;
+
+    std::erase_if(subscriptions_, [](const Subscription& sub) { return !sub.listener; });
+
+    return changed;
+}
+
+size_t GameStateMonitor::listenerCount() const
+{
+    return size_t(std::ranges::count_if(subscriptions_, [](const Subscription& sub) { return bool(sub.listener); }));
+}
+} // namespace GW2Radial
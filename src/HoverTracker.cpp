@@ -0,0 +1,61 @@
+#include <HoverTracker.h>
+
+namespace GW2Radial
+{
+void HoverTracker::Push(std::int64_t time, glm::vec2 offset)
+{
+    if (count_ > 0 && sample(0).offset == offset)
+        return;
+
+    head_           = (head_ + 1) % Capacity;
+    samples_[head_] = { time, offset };
+    if (count_ < Capacity)
+        count_++;
+}
+
+const HoverTracker::Sample& HoverTracker::sample(size_t age) const
+{
+    return samples_[(head_ + Capacity - age) % Capacity];
+}
+
+std::optional<glm::vec2> HoverTracker::latest() const
+{
+    if (count_ == 0)
+        return std::nullopt;
+
+    return sample(0).offset;
+}
+
+std::optional<glm::vec2> HoverTracker::ReleaseOffset(std::int64_t now, float deadZoneSq, std::int64_t flickWindow) const
+{
+    const auto outside = [&](const Sample& s) { return glm::dot(s.offset, s.offset) > deadZoneSq; };
+
+    if (count_ == 0)
+        return std::nullopt;
+    if (outside(sample(0)))
+        return sample(0).offset;
+
+    // Walk back through the samples inside the dead zone; the oldest of them is when the cursor returned to the center
+    for (size_t age = 1; age < count_; age++)
+    {
+        if (!outside(sample(age)))
+            continue;
+
+        if (now - sample(age - 1).time > flickWindow)
+            return std::nullopt;
+
+        return sample(age).offset;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<glm::vec2> HoverTracker::Replay(std::span<const Sample> samples, std::int64_t now, float deadZoneSq, std::int64_t flickWindow)
+{
+    HoverTracker tracker;
+    for (const auto& s : samples)
+        tracker.Push(s.time, s.offset);
+
+    return tracker.ReleaseOffset(now, deadZoneSq, flickWindow);
+}
+} // namespace GW2Radial
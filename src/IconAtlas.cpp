@@ -0,0 +1,239 @@
+#include <Core.h>
+#include <IconAtlas.h>
+#include <Log.h>
+#include <algorithm>
+
+namespace GW2Radial
+{
+IconAtlas::IconAtlas()
+{
+    vs_ = ShaderManager::i().GetShader(L"ScreenQuad.hlsl", D3D11_SHVER_VERTEX_SHADER, "ScreenQuad");
+    ps_ = ShaderManager::i().GetShader(L"AtlasBlit.hlsl", D3D11_SHVER_PIXEL_SHADER, "AtlasBlit");
+    cb_ = ShaderManager::i().MakeConstantBuffer<BlitCB>();
+
+    CD3D11_SAMPLER_DESC sampDesc(D3D11_DEFAULT);
+    GW2_CHECKED_HRESULT(Core::i().device()->CreateSamplerState(&sampDesc, sampler_.GetAddressOf()));
+}
+
+IconAtlas::EntryHandle IconAtlas::Add(const Texture2D& source, const std::optional<AtlasRect>& region)
+{
+    GW2_ASSERT(source.texture);
+
+    D3D11_TEXTURE2D_DESC desc;
+    source.texture->GetDesc(&desc);
+
+    const AtlasRect sourceRect    = region.value_or(AtlasRect{ 0, 0, desc.Width, desc.Height });
+    // Distance fields stay sharp when magnified, so they keep their own small size and are only expanded when drawn
+    const bool      distanceField = desc.Format == DXGI_FORMAT_R8_UNORM;
+    const float     scale         = std::min(1.f, float(MaxIconEdge) / float(std::max(sourceRect.width, sourceRect.height)));
+
+    auto            entry         = std::make_shared<Entry>();
+    entry->source                 = source.texture.Get();
+    entry->sourceSrv              = source.srv.Get();
+    entry->distanceField          = distanceField;
+    entry->sourceUvRect           = { float(sourceRect.x) / float(desc.Width), float(sourceRect.y) / float(desc.Height), float(sourceRect.width) / float(desc.Width),
+                                      float(sourceRect.height) / float(desc.Height) };
+    entry->sourceTexelSize        = { 1.f / float(desc.Width), 1.f / float(desc.Height) };
+    entry->size                   = { std::max(1u, u32(float(sourceRect.width) * scale + 0.5f)), std::max(1u, u32(float(sourceRect.height) * scale + 0.5f)) };
+
+    if (!Place(*entry))
+    {
+        Repack();
+        if (!Place(*entry))
+        {
+            CreatePages(pageCount_ + 1);
+            const bool placed = Place(*entry);
+            GW2_ASSERT(placed);
+        }
+    }
+
+    entries_.push_back(entry);
+
+    return entry;
+}
+
+bool IconAtlas::Place(Entry& entry)
+{
+    for (u32 page = 0; page < u32(packers_.size()); page++)
+    {
+        if (auto rect = packers_[page].Insert(entry.size.width, entry.size.height))
+        {
+            entry.page   = page;
+            entry.rect   = *rect;
+            entry.uvRect = { float(rect->x) / PageSize, float(rect->y) / PageSize, float(rect->width) / PageSize, float(rect->height) / PageSize };
+            entry.dirty  = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void IconAtlas::Repack()
+{
+    std::erase_if(entries_, [](const auto& e) { return e.expired(); });
+
+    std::vector<EntryHandle> live;
+    std::vector<AtlasSize>   sizes;
+    live.reserve(entries_.size());
+    sizes.reserve(entries_.size());
+    for (const auto& e : entries_)
+    {
+        live.push_back(e.lock());
+        sizes.push_back(live.back()->size);
+    }
+
+    const auto placements = PackIntoPages(sizes, PageSize, PageSize, Padding, Padding);
+
+    u32        pageCount  = 0;
+    for (const auto& p : placements)
+    {
+        GW2_ASSERT(p.has_value());
+        pageCount = std::max(pageCount, p->page + 1);
+    }
+    if (pageCount > pageCount_)
+        CreatePages(pageCount);
+
+    // Rebuild the packers so the skylines match the new layout, tallest first like PackIntoPages
+    for (auto& packer : packers_)
+        packer.Reset();
+
+    std::vector<size_t> order(live.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a].height != sizes[b].height ? sizes[a].height > sizes[b].height : sizes[a].width > sizes[b].width; });
+
+    for (size_t i : order)
+    {
+        auto&      entry = *live[i];
+        const auto rect  = packers_[placements[i]->page].Insert(entry.size.width, entry.size.height);
+        GW2_ASSERT(rect.has_value());
+
+        entry.page   = placements[i]->page;
+        entry.rect   = *rect;
+        entry.uvRect = { float(rect->x) / PageSize, float(rect->y) / PageSize, float(rect->width) / PageSize, float(rect->height) / PageSize };
+        entry.dirty  = true;
+    }
+
+    LogDebug("Repacked icon atlas: {} icons over {} pages", live.size(), pageCount_);
+}
+
+void IconAtlas::CreatePages(u32 count)
+{
+    GW2_ASSERT(count <= D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION);
+
+    auto                 dev = Core::i().device();
+
+    CD3D11_TEXTURE2D_DESC desc(DXGI_FORMAT_R8G8B8A8_UNORM, PageSize, PageSize, count, MipLevels, D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET, D3D11_USAGE_DEFAULT, 0, 1, 0,
+                               D3D11_RESOURCE_MISC_GENERATE_MIPS);
+    GW2_CHECKED_HRESULT(dev->CreateTexture2D(&desc, nullptr, texture_.ReleaseAndGetAddressOf()));
+
+    CD3D11_SHADER_RESOURCE_VIEW_DESC srvDesc(D3D11_SRV_DIMENSION_TEXTURE2DARRAY, desc.Format, 0, MipLevels, 0, count);
+    GW2_CHECKED_HRESULT(dev->CreateShaderResourceView(texture_.Get(), &srvDesc, srv_.ReleaseAndGetAddressOf()));
+
+    rtvs_.resize(count);
+    for (u32 i = 0; i < count; i++)
+    {
+        CD3D11_RENDER_TARGET_VIEW_DESC rtvDesc(D3D11_RTV_DIMENSION_TEXTURE2DARRAY, desc.Format, 0, i, 1);
+        GW2_CHECKED_HRESULT(dev->CreateRenderTargetView(texture_.Get(), &rtvDesc, rtvs_[i].ReleaseAndGetAddressOf()));
+    }
+
+    packers_.resize(count, AtlasPacker(PageSize, PageSize, Padding, Padding));
+    pageCount_ = count;
+
+    // The new texture starts out empty, every live entry must be copied again
+    for (const auto& e : entries_)
+        if (auto entry = e.lock())
+            entry->dirty = true;
+}
+
+void IconAtlas::MarkDirty(ID3D11Resource* source)
+{
+    for (const auto& e : entries_)
+    {
+        auto entry = e.lock();
+        if (entry && entry->source == source)
+            entry->dirty = true;
+    }
+}
+
+void IconAtlas::Update(ID3D11DeviceContext* ctx)
+{
+    std::erase_if(entries_, [](const auto& e) { return e.expired(); });
+
+    std::vector<EntryHandle> dirty;
+    for (const auto& e : entries_)
+    {
+        auto entry = e.lock();
+        if (entry->dirty)
+            dirty.push_back(std::move(entry));
+    }
+
+    if (dirty.empty())
+        return;
+
+    ComPtr<ID3D11RenderTargetView> oldRt;
+    ComPtr<ID3D11DepthStencilView> oldDs;
+    ctx->OMGetRenderTargets(1, oldRt.GetAddressOf(), oldDs.GetAddressOf());
+
+    u32            viewportCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    D3D11_VIEWPORT oldViewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    ctx->RSGetViewports(&viewportCount, oldViewports);
+
+    ShaderManager::i().SetShaders(ctx, vs_, ps_);
+    ctx->OMSetBlendState(nullptr, nullptr, 0xffffffff);
+    ctx->PSSetSamplers(0, 1, sampler_.GetAddressOf());
+
+    auto& vscb             = *Core::i().vertexCB();
+    vscb->spriteDimensions = { 0.5f, 0.5f, 1.f, 1.f };
+    vscb->tiltMatrix       = glm::identity<glm::mat4x4>();
+    vscb->spriteZ          = 0.f;
+    vscb.Update(ctx);
+    ctx->VSSetConstantBuffers(0, 1, vscb.buffer().GetAddressOf());
+
+    for (const auto& entry : dirty)
+    {
+        Blit(ctx, *entry);
+        entry->dirty = false;
+    }
+
+    ID3D11ShaderResourceView* nullSrv = nullptr;
+    ctx->PSSetShaderResources(0, 1, &nullSrv);
+    ctx->OMSetRenderTargets(1, oldRt.GetAddressOf(), oldDs.Get());
+    ctx->RSSetViewports(viewportCount, oldViewports);
+
+    ctx->GenerateMips(srv_.Get());
+}
+
+void IconAtlas::Blit(ID3D11DeviceContext* ctx, const Entry& entry)
+{
+    // Draw over the whole cell, the clamping sampler extends the icon's edges into its padding
+    const auto     cell = packers_[entry.page].Cell(entry.rect);
+    D3D11_VIEWPORT vp;
+    vp.TopLeftX = float(cell.x);
+    vp.TopLeftY = float(cell.y);
+    vp.Width    = float(cell.width);
+    vp.Height   = float(cell.height);
+    vp.MinDepth = 0.f;
+    vp.MaxDepth = 1.f;
+    ctx->RSSetViewports(1, &vp);
+
+    // Map the padded viewport onto the source region, clamping to the region's edge texels rather than the whole texture's
+    const auto& src         = entry.sourceUvRect;
+    auto&       cb          = *cb_;
+    cb->sourceUvTransform.x = src.x - src.z * float(entry.rect.x - cell.x) / float(entry.rect.width);
+    cb->sourceUvTransform.y = src.y - src.w * float(entry.rect.y - cell.y) / float(entry.rect.height);
+    cb->sourceUvTransform.z = src.z * vp.Width / float(entry.rect.width);
+    cb->sourceUvTransform.w = src.w * vp.Height / float(entry.rect.height);
+    cb->sourceUvClamp       = { src.x + entry.sourceTexelSize.x * 0.5f, src.y + entry.sourceTexelSize.y * 0.5f, src.x + src.z - entry.sourceTexelSize.x * 0.5f,
+                                src.y + src.w - entry.sourceTexelSize.y * 0.5f };
+    cb->distanceField       = { entry.distanceField ? 1.f : 0.f, 0.f, 0.f, 0.f };
+    cb.Update(ctx);
+    ctx->PSSetConstantBuffers(0, 1, cb.buffer().GetAddressOf());
+
+    ctx->OMSetRenderTargets(1, rtvs_[entry.page].GetAddressOf(), nullptr);
+    ctx->PSSetShaderResources(0, 1, &entry.sourceSrv);
+
+    DrawScreenQuad(ctx);
+}
+} // namespace GW2Radial
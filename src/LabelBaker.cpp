@@ -0,0 +1,149 @@
+#include <Core.h>
+#include <ImGuiExtensions.h>
+#include <LabelBaker.h>
+#include <Utility.h>
+#include <backends/imgui_impl_dx11.h>
+#include <algorithm>
+#include <map>
+
+namespace GW2Radial
+{
+LabelBaker::LabelBaker(ImFont* font, ComPtr<ID3D11BlendState> blendState)
+    : font_(font)
+    , blendState_(std::move(blendState))
+{
+}
+
+LabelBaker::LabelHandle LabelBaker::Add(const std::wstring& text, float fontSize, u32 width, u32 height)
+{
+    auto label      = std::make_shared<Label>();
+    label->text     = utf8_encode(text);
+    label->fontSize = fontSize;
+    label->cacheKey = AssetCache::LabelKey(font_, fontSize, label->text, width, height, 0);
+
+    if (auto cached = Core::i().assetCache().Find(label->cacheKey); cached && cached->width == width && cached->height == height)
+        label->cachedPixels = std::move(cached->pixels);
+
+    std::erase_if(pages_, [](const auto& p) { return p.expired(); });
+    for (const auto& p : pages_)
+    {
+        auto page = p.lock();
+        if (auto rect = page->packer.Insert(width, height))
+        {
+            label->page = std::move(page);
+            label->rect = *rect;
+            break;
+        }
+    }
+
+    if (!label->page)
+    {
+        // Labels too large for a regular page get a page of their own
+        auto page = std::make_shared<Page>();
+        if (width + Padding * 2 > PageWidth || height + Padding * 2 > PageHeight)
+            page->packer = AtlasPacker(std::max(PageWidth, width + Padding * 2), std::max(PageHeight, height + Padding * 2), Padding);
+        page->rt = MakeRenderTarget(Core::i().device(), page->packer.width(), page->packer.height(), DXGI_FORMAT_R8G8B8A8_UNORM);
+
+        auto rect = page->packer.Insert(width, height);
+        GW2_ASSERT(rect.has_value());
+
+        label->page = page;
+        label->rect = *rect;
+        pages_.push_back(page);
+    }
+
+    pending_.push_back(label);
+
+    return label;
+}
+
+void LabelBaker::Bake(ID3D11DeviceContext* ctx)
+{
+    std::map<Page*, std::vector<LabelHandle>> byPage;
+    for (const auto& l : pending_)
+        if (auto label = l.lock())
+            byPage[label->page.get()].push_back(std::move(label));
+    pending_.clear();
+
+    if (byPage.empty())
+        return;
+
+    auto& io             = ImGui::GetIO();
+    auto  oldDisplaySize = io.DisplaySize;
+
+    ComPtr<ID3D11RenderTargetView> oldRt;
+    ComPtr<ID3D11DepthStencilView> oldDs;
+    ctx->OMGetRenderTargets(1, oldRt.GetAddressOf(), oldDs.GetAddressOf());
+
+    for (auto& [page, labels] : byPage)
+    {
+        // Rectangles are never reused within a page, so clearing once when it is first drawn to is enough
+        if (!page->cleared)
+        {
+            float clearBlack[] = { 0.f, 0.f, 0.f, 0.f };
+            ctx->ClearRenderTargetView(page->rt.rtv.Get(), clearBlack);
+            page->cleared = true;
+        }
+
+        std::vector<LabelHandle> drawn;
+        for (auto& label : labels)
+        {
+            if (label->cachedPixels.empty())
+            {
+                drawn.push_back(label);
+                continue;
+            }
+
+            const auto&     r = label->rect;
+            const D3D11_BOX box{ r.x, r.y, 0, r.x + r.width, r.y + r.height, 1 };
+            ctx->UpdateSubresource(page->rt.texture.Get(), 0, &box, label->cachedPixels.data(), r.width * 4, 0);
+            label->cachedPixels = {};
+        }
+
+        if (!drawn.empty())
+        {
+            const ImVec2 clip(float(page->packer.width()), float(page->packer.height()));
+            io.DisplaySize = clip;
+
+            ImDrawList imDraw(ImGui::GetDrawListSharedData());
+            imDraw.AddDrawCmd();
+            imDraw.PushClipRect(ImVec2(0.f, 0.f), clip);
+            imDraw.PushTextureID(font_->ContainerAtlas->TexID);
+
+            for (const auto& label : drawn)
+            {
+                const auto& r = label->rect;
+                imDraw.PushClipRect(ImVec2(float(r.x), float(r.y)), ImVec2(float(r.x + r.width), float(r.y + r.height)));
+                imDraw.AddText(font_, label->fontSize, LayoutLabel(font_, label->fontSize, label->text, r), 0xFFFFFFFF, label->text.c_str());
+                imDraw.PopClipRect();
+            }
+
+            ctx->OMSetRenderTargets(1, page->rt.rtv.GetAddressOf(), nullptr);
+
+            ImDrawData imData;
+            imData.Valid = true;
+            imData.CmdLists.clear();
+            imData.CmdLists.push_back(&imDraw);
+            imData.CmdListsCount = 1;
+            imData.TotalIdxCount = imDraw.IdxBuffer.Size;
+            imData.TotalVtxCount = imDraw.VtxBuffer.Size;
+            imData.DisplayPos    = ImVec2(0.0f, 0.0f);
+            imData.DisplaySize   = io.DisplaySize;
+
+            {
+                ImGuiBlendStateOverride ov(blendState_.Get());
+                ImGui_ImplDX11_RenderDrawData(&imData);
+            }
+
+            for (const auto& label : drawn)
+                Core::i().assetCache().QueueReadback(ctx, page->rt.texture.Get(), label->rect, label->cacheKey);
+        }
+
+        Core::i().iconAtlas().MarkDirty(page->rt.texture.Get());
+    }
+
+    ctx->OMSetRenderTargets(1, oldRt.GetAddressOf(), oldDs.Get());
+
+    io.DisplaySize = oldDisplaySize;
+}
+} // namespace GW2Radial
@@ -24,32 +24,41 @@ MountWheel::MountWheel(std::shared_ptr<Texture2D> bgTexture)
 
     auto cancel =
         std::make_unique<WheelElement>(ToUnderlying(MountSpecial::Cancel), "mount_special_cancel", "Mounts", "Cancel queue", glm::vec4(0.8f), ConditionalProperties::None);
-    cancel->customBehavior([&](bool visibility) { return enableQueuingOption_.value() && showCancelOption_.value() && OptHasValue(conditionalDelay_.element); });
+    cancel->customBehavior(MountGate::Cancel.required);
     AddElement(std::move(cancel));
 
     auto force = std::make_unique<WheelElement>(ToUnderlying(MountSpecial::Force), "mount_special_force", "Mounts", "Force mount", glm::vec4(0.8f), ConditionalProperties::None);
-    force->customBehavior(
-        [&](bool visibility)
-        {
-            if (enableQueuingOption_.value() && showForceOption_.value() && std::holds_alternative<WheelElement*>(conditionalDelay_.element))
-            {
-                const auto* element = std::get<WheelElement*>(conditionalDelay_.element);
-                return element == wheelElements_[MountIndex(MountType::Skyscale)].get() || element == wheelElements_[MountIndex(MountType::Warclaw)].get();
-            }
-            else
-                return false;
-        });
+    force->customBehavior(MountGate::Force.required);
     force_ = force.get();
     AddElement(std::move(force));
+
+    // If we mounted up while we had a mount queued, we don't want to try mounting again, that'd dismount us instead!
+    SubscribeGameState(GameStateMonitor::MountedField,
+                       [this](const GameSnapshot&, const GameSnapshot& current, u32)
+                       {
+                           if (current.mounted && OptHasValue(conditionalDelay_.element))
+                               ResetConditionallyDelayed(!conditionalDelay_.hidden);
+                       });
 }
 
-void MountWheel::OnUpdate()
+u64 MountWheel::PackStateWord() const
 {
-    Wheel::OnUpdate();
-
-    // If we mounted up while we had a mount queued, we don't want to try mounting again, that'd dismount us instead!
-    if (conditionalDelay_.element.index() != 0 && MumbleLink::i().currentMount() != MumbleLink::MountType::None)
-        ResetConditionallyDelayed(!conditionalDelay_.hidden);
+    u64 word = 0;
+    if (enableQueuingOption_.value())
+        word |= MountGate::QueuingEnabledBit;
+    if (showCancelOption_.value())
+        word |= MountGate::ShowCancelBit;
+    if (showForceOption_.value())
+        word |= MountGate::ShowForceBit;
+    if (OptHasValue(conditionalDelay_.element))
+        word |= MountGate::InputQueuedBit;
+    if (std::holds_alternative<WheelElement*>(conditionalDelay_.element))
+    {
+        const auto* element = std::get<WheelElement*>(conditionalDelay_.element);
+        if (element == wheelElements_[MountIndex(MountType::Skyscale)].get() || element == wheelElements_[MountIndex(MountType::Warclaw)].get())
+            word |= MountGate::ForceableMountQueuedBit;
+    }
+    return word;
 }
 
 glm::vec4 MountWheel::GetMountColorFromType(MountType m)
@@ -113,14 +122,14 @@ void MountWheel::MenuSectionInteraction()
 
 bool MountWheel::BypassCheck(WheelElement*& we, Keybind*& kb)
 {
-    const auto& mumble = MumbleLink::i();
-    if (quickDismountOption_.value() && mumble.isMounted())
+    const auto& gameState = *CurrentPlatform().gameState;
+    if (quickDismountOption_.value() && gameState.isMounted())
     {
         if (previousUsed_ != nullptr)
             we = previousUsed_;
         else
         {
-            const auto& activeElems = GetUsableElements(mumble.currentState());
+            const auto& activeElems = GetCachedUsableElements(ToConditionalState(gameState.currentState()));
             if (!activeElems.empty())
                 we = activeElems.front();
         }
@@ -131,7 +140,7 @@ bool MountWheel::BypassCheck(WheelElement*& we, Keybind*& kb)
         if (we || kb)
         {
             if (dismountDelayOption_.value() > 0)
-                dismountTriggerTime_ = TimeInMilliseconds() + dismountDelayOption_.value();
+                dismountTriggerTime_ = CurrentPlatform().clock->now() + dismountDelayOption_.value();
             else
                 dismountTriggerTime_ = 0;
             return true;
@@ -145,13 +154,8 @@ bool MountWheel::BypassCheck(WheelElement*& we, Keybind*& kb)
 
 bool MountWheel::CustomDelayCheck(OptKeybindWheelElement&)
 {
-    if (TimeInMilliseconds() < dismountTriggerTime_)
-    {
-        conditionalDelay_.hidden    = true;
-        conditionalDelay_.immediate = true;
-
+    if (CurrentPlatform().clock->now() < dismountTriggerTime_)
         return true;
-    }
 
     return false;
 }
@@ -161,24 +165,40 @@ bool MountWheel::ResetMouseCheck(WheelElement* we)
     return we == wheelElements_[MountIndex(MountType::Skiff)].get();
 }
 
-Keybind* MountWheel::GetKeybindFromOpt(OptKeybindWheelElement& o)
+bool MountWheel::HandleQueueCommand(const OptKeybindWheelElement& o)
 {
-    if (std::holds_alternative<WheelElement*>(o))
+    if (!std::holds_alternative<WheelElement*>(o))
+        return false;
+
+    auto* we = std::get<WheelElement*>(o);
+    if (we == wheelElements_[MountIndex(MountSpecial::Cancel)].get())
     {
-        auto* we = std::get<WheelElement*>(o);
-        if (we == wheelElements_[MountIndex(MountSpecial::Cancel)].get())
-        {
-            ResetConditionallyDelayed(true);
-            return nullptr;
-        }
-        else if (we == wheelElements_[MountIndex(MountSpecial::Force)].get())
-        {
-            auto delayedElement = conditionalDelay_.element;
-            return GetKeybindFromOpt(delayedElement);
-        }
+        ResetConditionallyDelayed(true);
+        return true;
+    }
+    else if (we == wheelElements_[MountIndex(MountSpecial::Force)].get())
+    {
+        // Send the queued mount right away, whatever the game state
+        auto delayedElement = conditionalDelay_.element;
+        if (auto* kb = GetKeybindFromOpt(delayedElement))
+            CurrentPlatform().input->SendKeybind(ToKeyChord(kb->keyCombo()), std::nullopt);
+        ResetConditionallyDelayed(false);
+        return true;
     }
 
-    return Wheel::GetKeybindFromOpt(o);
+    return false;
+}
+
+bool MountWheel::ReplacesQueuedInput() const
+{
+    // Only ever one mount pending, a new choice supersedes the previous one
+    return true;
+}
+
+bool MountWheel::KeepsQueuedInputAfterSend() const
+{
+    // A mount keybind sent while mounted switches or dismounts, retrying it would only undo that
+    return !CurrentPlatform().gameState->isMounted();
 }
 
 bool MountWheel::SpecialBehaviorBeforeDelay()
@@ -186,7 +206,7 @@ bool MountWheel::SpecialBehaviorBeforeDelay()
     if (!beforeDelayForceOption_.value())
         return false;
 
-    if (MumbleLink::i().isInWvW())
+    if (CurrentPlatform().gameState->isInWvW())
         return false;
 
     if (!std::holds_alternative<WheelElement*>(conditionalDelay_.element))
@@ -0,0 +1,140 @@
+#include <NullPlatform.h>
+
+namespace GW2Radial
+{
+void NullPlatform::Reset()
+{
+    sentKeybinds.clear();
+    releasedKeybinds.clear();
+    keyUpActiveCount = 0;
+    centerCount      = 0;
+}
+
+bool NullPlatform::RaiseMouseMove(glm::vec2 position)
+{
+    cursorPosition  = position;
+
+    bool passToGame = true;
+    for (const auto& [id, handler] : mouseMoveHandlers_)
+        handler(passToGame);
+    return passToGame;
+}
+
+bool NullPlatform::RaiseMouseButton(std::uint32_t scanCode, bool down)
+{
+    bool passToGame = true;
+    for (const auto& [id, handler] : mouseButtonHandlers_)
+        handler(scanCode, down, passToGame);
+    return passToGame;
+}
+
+PlatformTime NullPlatform::now() const
+{
+    return time;
+}
+
+void NullPlatform::SendKeybind(const KeyChord& keys, std::optional<glm::ivec2> cursorPos)
+{
+    sentKeybinds.push_back({ keys, cursorPos, time });
+    if (cursorPos)
+        cursorPosition = glm::vec2(*cursorPos);
+}
+
+bool NullPlatform::PressKeybindNow(const KeyChord& keys)
+{
+    // Recorded like queued keybinds; harnesses timing the executor use their own step callbacks instead
+    if (!hasFocus)
+        return false;
+
+    SendKeybind(keys, std::nullopt);
+    return true;
+}
+
+void NullPlatform::ReleaseKeybindNow(const KeyChord& keys)
+{
+    releasedKeybinds.push_back({ keys, std::nullopt, time });
+}
+
+void NullPlatform::KeyUpActive()
+{
+    keyUpActiveCount++;
+}
+
+NullPlatform::SubscriptionId NullPlatform::SubscribeMouseMove(MouseMoveHandler handler)
+{
+    const auto id = nextSubscription_++;
+    mouseMoveHandlers_.emplace(id, std::move(handler));
+    return id;
+}
+
+NullPlatform::SubscriptionId NullPlatform::SubscribeMouseButton(MouseButtonHandler handler)
+{
+    const auto id = nextSubscription_++;
+    mouseButtonHandlers_.emplace(id, std::move(handler));
+    return id;
+}
+
+void NullPlatform::Unsubscribe(SubscriptionId id)
+{
+    mouseMoveHandlers_.erase(id);
+    mouseButtonHandlers_.erase(id);
+}
+
+std::uint32_t NullPlatform::currentState() const
+{
+    return state;
+}
+
+bool NullPlatform::gameHasFocus() const
+{
+    return hasFocus;
+}
+
+bool NullPlatform::isMapOpen() const
+{
+    return mapOpen;
+}
+
+bool NullPlatform::isMounted() const
+{
+    return mounted;
+}
+
+bool NullPlatform::isInWvW() const
+{
+    return inWvW;
+}
+
+std::uint32_t NullPlatform::uiScale() const
+{
+    return scale;
+}
+
+glm::vec2 NullPlatform::position() const
+{
+    return cursorPosition;
+}
+
+glm::vec2 NullPlatform::livePosition() const
+{
+    return cursorPosition;
+}
+
+bool NullPlatform::CenterInWindow()
+{
+    cursorPosition = glm::vec2(screen) * 0.5f;
+    centerCount++;
+
+    return true;
+}
+
+glm::ivec2 NullPlatform::screenSize() const
+{
+    return screen;
+}
+
+float NullPlatform::dpiScale() const
+{
+    return dpi;
+}
+} // namespace GW2Radial
@@ -0,0 +1,22 @@
+#include <Platform.h>
+#include <cassert>
+
+namespace GW2Radial
+{
+namespace
+{
+Platform currentPlatform;
+}
+
+const Platform& CurrentPlatform()
+{
+    return currentPlatform;
+}
+
+void SetCurrentPlatform(const Platform& platform)
+{
+    // Plain assert, this file also builds without GW2Common
+    assert(platform.clock && platform.input && platform.events && platform.gameState && platform.cursor && platform.renderer);
+    currentPlatform = platform;
+}
+} // namespace GW2Radial
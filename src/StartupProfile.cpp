@@ -0,0 +1,91 @@
+#include <ConfigurationFile.h>
+#include <Log.h>
+#include <StartupProfile.h>
+#include <Utility.h>
+#include <fstream>
+#include <imgui.h>
+#include <nlohmann/json.hpp>
+
+namespace GW2Radial
+{
+StartupProfile::Scope::~Scope()
+{
+    if (!profile_)
+        return;
+
+    auto& phase      = profile_->phases_[index_];
+    phase.durationMs = profile_->ElapsedMs() - phase.startMs;
+    profile_->depth_--;
+}
+
+StartupProfile::Scope StartupProfile::Measure(std::string name)
+{
+    if (finished_)
+        return { nullptr, 0 };
+
+    phases_.push_back({ std::move(name), depth_++, ElapsedMs(), 0.0 });
+
+    return { this, phases_.size() - 1 };
+}
+
+void StartupProfile::Finish()
+{
+    if (finished_)
+        return;
+
+    finished_ = true;
+    totalMs_  = ElapsedMs();
+
+    LogInfo("Startup took {:.1f} ms:", totalMs_);
+    for (const auto& p : phases_)
+        LogInfo("{:>{}}{}: {:.2f} ms", "", 2 + p.depth * 2, p.name, p.durationMs);
+
+    if (auto folder = INIConfigurationFile::i().folder())
+    {
+        std::ofstream out(*folder / L"startup_profile.json", std::ios::trunc);
+        out << ToJson();
+    }
+}
+
+std::string StartupProfile::ToJson() const
+{
+    nlohmann::json phases = nlohmann::json::array();
+    for (const auto& p : phases_)
+        phases.push_back({ { "name", p.name }, { "depth", p.depth }, { "start_ms", p.startMs }, { "duration_ms", p.durationMs } });
+
+    return nlohmann::json{ { "version", 1 }, { "total_ms", totalMs_ }, { "phases", std::move(phases) } }.dump(2);
+}
+
+void StartupProfile::DrawGUI() const
+{
+    if (!finished_)
+    {
+        ImGui::TextUnformatted("Startup has not completed yet.");
+        return;
+    }
+
+    ImGui::Text("Total: %.1f ms", totalMs_);
+
+    if (ImGui::BeginTable("StartupProfile", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+    {
+        for (const auto& p : phases_)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + float(p.depth) * ImGui::GetStyle().IndentSpacing);
+            ImGui::TextUnformatted(p.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f ms", p.durationMs);
+        }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::Button("Copy as JSON"))
+        ImGui::SetClipboardText(ToJson().c_str());
+}
+
+double StartupProfile::ElapsedMs() const
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start_).count();
+}
+} // namespace GW2Radial
@@ -51,15 +51,7 @@ TemplateWheel::TemplateWheel(std::shared_ptr<Texture2D> bgTexture)
         // Use customBehaviorKeepProps to check if keybinds are configured
         // This acts as a pre-check (AND) before evaluating props
         size_t index = i - 1;
-        element->customBehaviorKeepProps([this, index](bool visibility) {
-            // Check if any keybinds are configured for this combo
-            if (index >= comboKeybinds_.size())
-                return false;
-
-            bool hasKeybind = comboKeybinds_[index]->buildTemplateKeybind->isSet() ||
-                              comboKeybinds_[index]->equipTemplateKeybind->isSet();
-            return hasKeybind;
-        });
+        element->customBehaviorKeepProps(SlotBit(index));
 
         AddElement(std::move(element));
 
@@ -77,6 +69,9 @@ void TemplateWheel::UpdateActionChain(size_t elementIndex)
     auto& element = wheelElements_[elementIndex];
     auto& keybinds = comboKeybinds_[elementIndex];
 
+    // Keybind changes affect visibility through the custom behavior pre-check
+    InvalidateElementCache();
+
     // Clear existing chain
     element->clearChain();
 
@@ -120,6 +115,22 @@ void TemplateWheel::UpdateActionChain(size_t elementIndex)
     }
 }
 
+u64 TemplateWheel::PackStateWord() const
+{
+    // One bit per combo slot, set when any of its keybinds are configured
+    u64 word = 0;
+    for (size_t i = 0; i < comboKeybinds_.size(); i++)
+        if (comboKeybinds_[i]->buildTemplateKeybind->isSet() || comboKeybinds_[i]->equipTemplateKeybind->isSet())
+            word |= SlotBit(i);
+    return word;
+}
+
+bool TemplateWheel::ReplacesQueuedInput() const
+{
+    // Queued templates keep retrying until they expire, so a newer choice has to replace the pending one
+    return true;
+}
+
 void TemplateWheel::OnUpdate()
 {
     Wheel::OnUpdate();
@@ -139,6 +150,7 @@ void TemplateWheel::OnUpdate()
                 element->props(currentProps);
             }
         }
+        InvalidateElementCache();
         propsFixed = true;
     }
 
@@ -176,6 +188,8 @@ void TemplateWheel::OnUpdate()
 
 void TemplateWheel::DrawMenu(Keybind** currentEditedKeybind)
 {
+    InvalidateElementCache();
+
     ImGui::PushID((nickname_ + "Elements").c_str());
 
     // Skip the "In-game Keybinds" section (lines 170-175 in base Wheel::DrawMenu)
@@ -251,6 +265,14 @@ void TemplateWheel::DrawMenu(Keybind** currentEditedKeybind)
                         "Mutually exclusive with \"hover to select\".");
     }
 
+    {
+        UI::Scoped::Disable disable(clickSelectOption_.value());
+
+        ImGui::ConfigurationWrapper(&ImGui::Checkbox, flickSelectOption_);
+        UI::HelpTooltip("A quick flick of the mouse toward an option activates it immediately, without waiting for the key to be released or for the pop-up delay. "
+                        "Slower movements aim as usual. Has no effect with \"click to select\".");
+    }
+
     ImGui::ConfigurationWrapper(&ImGui::Checkbox, resetCursorOnLockedKeybindOption_);
     UI::HelpTooltip("Moves the cursor to the center of the screen when the \"show in center\" keybind is used.");
 
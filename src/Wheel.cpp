@@ -1,5 +1,4 @@
 #include <Core.h>
-#include <GFXSettings.h>
 #include <ImGuiExtensions.h>
 #include <ImGuiPopup.h>
 #include <Input.h>
@@ -9,10 +8,13 @@
 #include <Utility.h>
 #include <Wheel.h>
 #include <algorithm>
+#include <bit>
+#include <cmath>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/euler_angles.hpp>
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <numeric>
 #include <utility>
 
 namespace GW2Radial
@@ -47,6 +49,7 @@ Wheel::Wheel(std::shared_ptr<Texture2D> bgTexture, std::string nickname, std::st
     , showOverGameUIOption_("Show on top of game UI", "show_over_ui", "wheel_" + nickname_, true)
     , noHoldOption_("Activate first hovered option without holding down", "no_hold", "wheel_" + nickname_, false)
     , clickSelectOption_("Require click on option to select", "click_select", "wheel_" + nickname_, false)
+    , flickSelectOption_("Select by flicking toward an option", "flick_select", "wheel_" + nickname_, false)
     , behaviorOnReleaseBeforeDelay_("Behavior when released before delay has lapsed", "behavior_before_delay", "wheel_" + nickname_)
     , resetCursorAfterKeybindOption_("Move cursor to original location after release", "reset_cursor_after", "wheel_" + nickname_, true)
     , maximumConditionalWaitTimeOption_("Expiration time of queued input", "max_wait_cond", "wheel_" + nickname_, 30)
@@ -70,20 +73,44 @@ Wheel::Wheel(std::shared_ptr<Texture2D> bgTexture, std::string nickname, std::st
     keybind_.callback([&](Activated a) { return KeybindEvent(false, a); });
     centralKeybind_.callback([&](Activated a) { return KeybindEvent(true, a); });
 
-    mouseMoveCallbackID_   = Input::i().mouseMoveEvent().AddCallback([this](bool& rv) { OnMouseMove(rv); });
-    mouseButtonCallbackID_ = Input::i().mouseButtonEvent().AddCallback([this](EventKey ek, bool& rv) { OnMouseButton(ek.sc, ek.down, rv); });
+    auto& events           = *CurrentPlatform().events;
+    mouseMoveCallbackID_   = events.SubscribeMouseMove([this](bool& rv) { OnMouseMove(rv); });
+    mouseButtonCallbackID_ = events.SubscribeMouseButton([this](std::uint32_t sc, bool down, bool& rv) { OnMouseButton(ScanCode(sc), down, rv); });
+    SubscribeGameState(GameStateMonitor::MapField | GameStateMonitor::CharacterField,
+                       [this](const GameSnapshot& previous, const GameSnapshot& current, u32 changed)
+                       {
+                           if (changed & GameStateMonitor::MapField)
+                               OnMapChange(previous.mapId, current.mapId);
+                           if (changed & GameStateMonitor::CharacterField)
+                               OnCharacterChange(previous.characterName, current.characterName);
+                       });
+}
 
-    SettingsMenu::i().AddImplementer(this);
+Wheel::~Wheel()
+{
+    auto& events = *CurrentPlatform().events;
+    events.Unsubscribe(mouseMoveCallbackID_);
+    events.Unsubscribe(mouseButtonCallbackID_);
+    SettingsMenu::f([&](auto& i) { i.RemoveImplementer(this); });
+    ActionChainExecutor::Cancel(actionChain_);
+    for (auto id : gameStateListeners_)
+        CurrentPlatform().monitor->Unsubscribe(id);
+    CancelQueuedInputs();
+}
 
-    vs_                   = ShaderManager::i().GetShader(L"ScreenQuad.hlsl", D3D11_SHVER_VERTEX_SHADER, "ScreenQuad");
-    psWheel_              = ShaderManager::i().GetShader(L"Wheel.hlsl", D3D11_SHVER_PIXEL_SHADER, "Wheel");
-    psWheelElement_       = ShaderManager::i().GetShader(L"WheelElement.hlsl", D3D11_SHVER_PIXEL_SHADER, "WheelElement");
-    psCursor_             = ShaderManager::i().GetShader(L"Cursor.hlsl", D3D11_SHVER_PIXEL_SHADER, "Cursor");
-    psDelayIndicator_     = ShaderManager::i().GetShader(L"DelayIndicator.hlsl", D3D11_SHVER_PIXEL_SHADER, "DelayIndicator");
+void Wheel::CreateDeviceResources(ID3D11DeviceContext* ctx)
+{
+    vs_               = ShaderManager::i().GetShader(L"ScreenQuad.hlsl", D3D11_SHVER_VERTEX_SHADER, "ScreenQuad");
+    psWheel_          = ShaderManager::i().GetShader(L"Wheel.hlsl", D3D11_SHVER_PIXEL_SHADER, "Wheel");
+    psWheelElement_   = ShaderManager::i().GetShader(L"WheelElement.hlsl", D3D11_SHVER_PIXEL_SHADER, "WheelElement");
+    vsElements_       = ShaderManager::i().GetShader(L"ScreenQuad.hlsl", D3D11_SHVER_VERTEX_SHADER, "WheelElementInstanced");
+    psCursor_         = ShaderManager::i().GetShader(L"Cursor.hlsl", D3D11_SHVER_PIXEL_SHADER, "Cursor");
+    psDelayIndicator_ = ShaderManager::i().GetShader(L"DelayIndicator.hlsl", D3D11_SHVER_PIXEL_SHADER, "DelayIndicator");
 
-    auto              dev = Core::i().device();
+    ComPtr<ID3D11Device> dev;
+    ctx->GetDevice(dev.GetAddressOf());
 
-    CD3D11_BLEND_DESC blendDesc(D3D11_DEFAULT);
+    CD3D11_BLEND_DESC    blendDesc(D3D11_DEFAULT);
     blendDesc.RenderTarget[0].BlendEnable    = true;
     blendDesc.RenderTarget[0].SrcBlend       = D3D11_BLEND_ONE;
     blendDesc.RenderTarget[0].DestBlend      = D3D11_BLEND_INV_SRC_ALPHA;
@@ -108,54 +135,24 @@ Wheel::Wheel(std::shared_ptr<Texture2D> bgTexture, std::string nickname, std::st
     }
 }
 
-Wheel::~Wheel()
+void Wheel::SubscribeGameState(u32 fields, GameStateMonitor::Listener listener)
 {
-    Input::f(
-        [&](auto& i)
-        {
-            i.mouseMoveEvent().RemoveCallback(std::move(mouseMoveCallbackID_));
-            i.mouseButtonEvent().RemoveCallback(std::move(mouseButtonCallbackID_));
-        });
-    SettingsMenu::f([&](auto& i) { i.RemoveImplementer(this); });
+    gameStateListeners_.push_back(CurrentPlatform().monitor->Subscribe(fields, std::move(listener)));
 }
 
 void Wheel::UpdateHover()
 {
-    const auto& io = ImGui::GetIO();
-
-    glm::vec2   mousePos;
-    mousePos.x = io.MousePos.x / float(Core::i().screenWidth());
-    mousePos.y = io.MousePos.y / float(Core::i().screenHeight());
-    mousePos.x -= currentPosition_.x;
-    mousePos.y -= currentPosition_.y;
-
-    mousePos.y *= float(Core::i().screenHeight()) / float(Core::i().screenWidth());
-
-    WheelElement* lastHovered    = currentHovered_;
+    const auto& platform = CurrentPlatform();
+    const auto  time     = platform.clock->now();
 
-    auto          activeElements = GetVisibleElements(MumbleLink::i().currentState());
+    // Sample the OS cursor rather than the per-frame UI snapshot, so moves between frames land in the trajectory
+    hoverTracker_.Push(time, CursorOffset(platform.cursor->livePosition()));
 
-    float         mpLenSq        = mousePos.x * mousePos.x + mousePos.y * mousePos.y;
-
-    // Middle circle does not count as a hover event
-    if (!activeElements.empty() && mpLenSq > Square(scaleOption_.value() * 0.125f * 0.8f * centerScaleOption_.value()))
-    {
-        float mouseAngle = atan2(-mousePos.y, -mousePos.x) - 0.5f * float(M_PI);
-        if (mouseAngle < 0)
-            mouseAngle += float(2 * M_PI);
-
-        const float elementAngle = float(2 * M_PI) / activeElements.size();
-        const int   elementId    = int((mouseAngle - elementAngle / 2) / elementAngle + 1) % int(activeElements.size());
-
-        currentHovered_          = activeElements[elementId];
-    }
-    else
-        currentHovered_ = GetCenterHoveredElement();
+    WheelElement* lastHovered = currentHovered_;
+    currentHovered_           = ElementAtOffset(*hoverTracker_.latest());
 
     if (lastHovered != currentHovered_)
     {
-        const auto time = TimeInMilliseconds();
-
         if (lastHovered)
             lastHovered->currentExitTime(time);
         if (currentHovered_)
@@ -163,8 +160,52 @@ void Wheel::UpdateHover()
     }
 }
 
+glm::vec2 Wheel::CursorOffset(glm::vec2 cursor) const
+{
+    const auto screenSize = glm::vec2(CurrentPlatform().renderer->screenSize());
+
+    glm::vec2  offset     = cursor / screenSize;
+    offset.x -= currentPosition_.x;
+    offset.y -= currentPosition_.y;
+
+    offset.y *= screenSize.y / screenSize.x;
+
+    return offset;
+}
+
+float Wheel::HoverDeadZoneSq() const
+{
+    return Square(scaleOption_.value() * 0.125f * 0.8f * centerScaleOption_.value());
+}
+
+WheelElement* Wheel::ElementAtOffset(glm::vec2 offset)
+{
+    const auto& activeElements = GetCachedVisibleElements(ToConditionalState(CurrentPlatform().gameState->currentState()));
+
+    // Middle circle does not count as a hover event
+    if (activeElements.empty() || offset.x * offset.x + offset.y * offset.y <= HoverDeadZoneSq())
+        return GetCenterHoveredElement();
+
+    // Sector boundaries only move when the number of visible elements does, so the trig lives in the rebuild
+    if (sectorTable_.sectorCount() != activeElements.size())
+        sectorTable_.BuildUniform(activeElements.size());
+
+    return activeElements[sectorTable_.Resolve(offset)];
+}
+
+FlickRecognizer::Thresholds Wheel::FlickThresholds() const
+{
+    // Offsets are in fractions of the screen width: commit past three center radii, averaging at least about a thousand pixels
+    // per second at 1080p, within 150 ms of leaving the center
+    const float deadZone = std::sqrt(HoverDeadZoneSq());
+    return { .deadZone = deadZone, .distance = std::max(3.f * deadZone, 0.04f), .minSpeed = 0.0005f, .maxDuration = 150 };
+}
+
 void Wheel::DrawMenu(Keybind** currentEditedKeybind)
 {
+    // Any of the options below may change which elements are visible or usable
+    InvalidateElementCache();
+
     ImGui::PushID((nickname_ + "Elements").c_str());
 
     UI::Title("In-game Keybinds");
@@ -244,6 +285,14 @@ void Wheel::DrawMenu(Keybind** currentEditedKeybind)
                         "Mutually exclusive with \"hover to select\".");
     }
 
+    {
+        UI::Scoped::Disable disable(clickSelectOption_.value());
+
+        ImGui::ConfigurationWrapper(&ImGui::Checkbox, flickSelectOption_);
+        UI::HelpTooltip("A quick flick of the mouse toward an option activates it immediately, without waiting for the key to be released or for the pop-up delay. "
+                        "Slower movements aim as usual. Has no effect with \"click to select\".");
+    }
+
     auto favoriteCombo = [](const std::vector<std::unique_ptr<WheelElement>>& elements, ConfigurationOption<Favorite>& opt)
     {
         Favorite fav    = opt.value();
@@ -272,8 +321,9 @@ void Wheel::DrawMenu(Keybind** currentEditedKeybind)
 
         namespace rv      = std::ranges::views;
 
-        const auto& all   = elements | rv::enumerate;
-        auto        wvw   = elements | rv::enumerate | rv::filter([](auto&& e) { return std::get<1>(e)->isUsable(ConditionalState::InWvW); });
+        // Only elements up to WheelFavorite::MaxIndex fit in the stored favorite
+        const auto& all   = elements | rv::enumerate | rv::take(Favorite::MaxIndex + 1);
+        auto        wvw   = all | rv::filter([stateWord = PackStateWord()](auto&& e) { return std::get<1>(e)->isUsable(ConditionalState::InWvW, stateWord); });
 
         fav.bits.baseline = single(fav.bits.baseline, "Default ", "This determines the default favorite option.", all, false);
         if (!std::ranges::empty(wvw | rv::drop(1)))
@@ -450,164 +500,19 @@ void Wheel::DrawMenu(Keybind** currentEditedKeybind)
 
 void Wheel::OnUpdate()
 {
+    // The executor drops the rest of a chain when the game stops taking input halfway, report that from here
+    if (actionChain_ && actionChain_->finished && actionChain_->dropped)
+    {
+        Log::i().Print(Severity::Warn, "Action chain stopped early, the game was not accepting input.");
+        actionChain_.reset();
+    }
+
     if (showEmptyPopup_)
         ImGuiPopup("Radial menu missing keybinds")
             .Position({ 0.5f, 0.45f })
             .Size({ 400.f, 200.f }, false)
             .Display([&](const ImVec2&) { ImGui::TextWrapped("A radial menu was triggered, but no keybinds are currently bound for it, so nothing could be shown."); },
                      [&]() { showEmptyPopup_ = false; });
-
-    // Execute action chain steps
-    if (actionChain_.isActive())
-    {
-        const auto currentTime = TimeInMilliseconds();
-
-        if (currentTime >= actionChain_.nextStepTime)
-        {
-            auto& step = actionChain_.steps[actionChain_.currentStep];
-
-            // Send this step's keybind
-            if (step.keyCombo.key() != ScanCode::None)
-            {
-                Log::i().Print(Severity::Info, "Executing chain step {}/{} for '{}'", actionChain_.currentStep + 1, actionChain_.steps.size(),
-                               actionChain_.sourceElement ? actionChain_.sourceElement->displayName() : "unknown");
-
-                Input::i().SendKeybind(step.keyCombo, std::nullopt);
-            }
-
-            // Schedule next step using THIS step's delay (before incrementing)
-            const mstime delayAfterThisStep = step.delayAfterMs;
-
-            // Move to next step
-            actionChain_.currentStep++;
-
-            if (actionChain_.currentStep >= actionChain_.steps.size())
-            {
-                // Chain complete!
-                Log::i().Print(Severity::Info, "Action chain completed for '{}'", actionChain_.sourceElement ? actionChain_.sourceElement->displayName() : "unknown");
-                actionChain_.reset();
-            }
-            else
-            {
-                // Schedule next step using the delay we saved
-                actionChain_.nextStepTime = currentTime + delayAfterThisStep;
-                Log::i().Print(Severity::Debug, "Next step scheduled in {}ms", delayAfterThisStep);
-            }
-        }
-    }
-
-    auto& cd = conditionalDelay_;
-    if (OptHasValue(cd.element))
-    {
-        const auto currentTime = TimeInMilliseconds();
-        if (currentTime > cd.time + maximumConditionalWaitTimeOption_.value() * 1000ull)
-            ResetConditionallyDelayed(true, currentTime);
-        else
-        {
-            if (cd.immediate)
-            {
-                if (cd.time <= currentTime && (std::holds_alternative<Keybind*>(cd.element) || CanActivate(std::get<WheelElement*>(cd.element))))
-                {
-                    // Check if this is a WheelElement with an action chain
-                    if (std::holds_alternative<WheelElement*>(cd.element))
-                    {
-                        WheelElement* element = std::get<WheelElement*>(cd.element);
-                        if (element->hasActionChain())
-                        {
-                            // Start the action chain for queued element
-                            actionChain_.steps         = element->getChain();
-                            actionChain_.currentStep   = 0;
-                            actionChain_.nextStepTime  = currentTime;
-                            actionChain_.sourceElement = element;
-                            Log::i().Print(Severity::Info, "Starting queued action chain for '{}' with {} steps.", element->displayName(), actionChain_.steps.size());
-
-                            // Clear the queue immediately since we've started the chain
-                            ResetConditionallyDelayed(false, currentTime);
-                            return; // Don't process clearConditionalDelayOnSend_ logic
-                        }
-                        else
-                        {
-                            // Normal single keybind
-                            auto kb = GetKeybindFromOpt(cd.element);
-                            if (kb)
-                                Input::i().SendKeybind(kb->keyCombo(), std::nullopt);
-                        }
-                    }
-                    else
-                    {
-                        // It's a Keybind*, send it directly
-                        auto kb = GetKeybindFromOpt(cd.element);
-                        if (kb)
-                            Input::i().SendKeybind(kb->keyCombo(), std::nullopt);
-                    }
-
-                    if (clearConditionalDelayOnSend_)
-                        ResetConditionallyDelayed(false, currentTime);
-                    else
-                    {
-                        if (cd.testPasses)
-                        {
-                            cd.time       = currentTime + 1000;
-                            cd.testPasses = false;
-                        }
-                        else
-                            cd.hidden = cd.immediate = false;
-                    }
-                }
-            }
-            else
-            {
-                if (std::holds_alternative<Keybind*>(cd.element) || CanActivate(std::get<WheelElement*>(cd.element)))
-                {
-                    if (!cd.testPasses)
-                        cd.testPassesTime = currentTime;
-                    else if (currentTime >= cd.testPassesTime + conditionalDelayDelayOption_.value())
-                    {
-                        // Check if this is a WheelElement with an action chain
-                        if (std::holds_alternative<WheelElement*>(cd.element))
-                        {
-                            WheelElement* element = std::get<WheelElement*>(cd.element);
-                            if (element->hasActionChain())
-                            {
-                                // Start the action chain for queued element
-                                actionChain_.steps         = element->getChain();
-                                actionChain_.currentStep   = 0;
-                                actionChain_.nextStepTime  = currentTime;
-                                actionChain_.sourceElement = element;
-                                Log::i().Print(Severity::Info, "Starting queued action chain for '{}' with {} steps.", element->displayName(), actionChain_.steps.size());
-
-                                // Clear the queue immediately since we've started the chain
-                                ResetConditionallyDelayed(true, currentTime);
-                                return; // Don't process clearConditionalDelayOnSend_ logic
-                            }
-                            else
-                            {
-                                // Normal single keybind
-                                auto kb = GetKeybindFromOpt(cd.element);
-                                if (kb)
-                                    Input::i().SendKeybind(kb->keyCombo(), std::nullopt);
-                            }
-                        }
-                        else
-                        {
-                            // It's a Keybind*, send it directly
-                            auto kb = GetKeybindFromOpt(cd.element);
-                            if (kb)
-                                Input::i().SendKeybind(kb->keyCombo(), std::nullopt);
-                        }
-
-                        if (clearConditionalDelayOnSend_)
-                            ResetConditionallyDelayed(true, currentTime);
-                        else
-                            cd.testPassesTime = currentTime + 3000 - conditionalDelayDelayOption_.value(); // At most retry once every 3 seconds
-                    }
-                    cd.testPasses = true;
-                }
-                else
-                    cd.testPasses = false;
-            }
-        }
-    }
 }
 
 void Wheel::OnMapChange(u32 prevId, u32 newId)
@@ -625,25 +530,20 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
     if (opacityMultiplierOption_.value() == 0)
         return;
 
-    const int  screenWidth                 = Core::i().screenWidth();
-    const int  screenHeight                = Core::i().screenHeight();
+    if (!blendState_)
+        CreateDeviceResources(ctx);
+
+    const auto screenPixels                = CurrentPlatform().renderer->screenSize();
+    const int  screenWidth                 = screenPixels.x;
+    const int  screenHeight                = screenPixels.y;
 
     glm::vec4  screenSize                  = { float(screenWidth), float(screenHeight), 1.f / screenWidth, 1.f / screenHeight };
 
-    const auto currentTime                 = TimeInMilliseconds();
+    const auto currentTime                 = CurrentPlatform().clock->now();
 
     const auto resetCursorPositionToCenter = [&]()
     {
-        RECT rect = {};
-        if (GetWindowRect(Core::i().gameWindow(), &rect))
-        {
-            if (SetCursorPos((rect.right - rect.left) / 2 + rect.left, (rect.bottom - rect.top) / 2 + rect.top))
-            {
-                auto& io      = ImGui::GetIO();
-                io.MousePos.x = screenWidth * 0.5f;
-                io.MousePos.y = screenHeight * 0.5f;
-            }
-        }
+        CurrentPlatform().cursor->CenterInWindow();
         resetCursorPositionToCenter_ = false;
     };
 
@@ -668,7 +568,7 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
             vp.MaxDepth               = 1.0f;
             ctx->RSSetViewports(1, &vp);
 
-            auto activeElements = GetVisibleElements(MumbleLink::i().currentState());
+            const auto& activeElements = GetCachedVisibleElements(ToConditionalState(CurrentPlatform().gameState->currentState()));
             if (!activeElements.empty())
             {
                 glm::vec4 baseSpriteDimensions;
@@ -679,60 +579,43 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
 
                 const float fadeTimer  = std::min(1.f, (currentTime - (currentTriggerTime_ + displayDelayOption_.value())) / float(animationTimeOption_.value() * 0.5f));
 
-                std::array<float, MaxHoverFadeIns> hoveredFadeIns;
-                std::transform(activeElements.begin(), activeElements.end(), hoveredFadeIns.begin(),
-                               [&](const WheelElement* elem) { return elem->hoverFadeIn(currentTime, this); });
-
-                auto& lastHoverFadeIn = hoveredFadeIns[activeElements.size()];
+                float centerHoverFadeIn = 0.f;
                 switch (CenterBehavior(centerBehaviorOption_.value()))
                 {
                     case CenterBehavior::Previous:
                         if (previousUsed_)
-                            lastHoverFadeIn = previousUsed_->hoverFadeIn(currentTime, this);
+                            centerHoverFadeIn = previousUsed_->hoverFadeIn(currentTime, this);
                         break;
                     case CenterBehavior::Favorite:
-                    {
                         if (auto* fav = GetFavorite(centerFavoriteOption_.value()))
-                        {
-                            lastHoverFadeIn = fav->hoverFadeIn(currentTime, this);
-                            break;
-                        }
-                    }
-                        [[fallthrough]];
+                            centerHoverFadeIn = fav->hoverFadeIn(currentTime, this);
+                        break;
                     default:
-                        lastHoverFadeIn = 0.f;
                         break;
                 }
 
-                for (u32 i = u32(activeElements.size()) + 1; i < MaxHoverFadeIns; i++)
-                    hoveredFadeIns[i] = 0.f;
-
                 ShaderManager::i().SetShaders(ctx, vs_, psWheel_);
                 ctx->OMSetBlendState(blendState_.Get(), nullptr, 0xffffffff);
-                UpdateConstantBuffer(ctx, baseSpriteDimensions, fadeTimer, fmod(currentTime / 1010.f, 55000.f), activeElements, hoveredFadeIns, 0.f, false, true);
+                UpdateConstantBuffer(ctx, baseSpriteDimensions, fadeTimer, fmod(currentTime / 1010.f, 55000.f), u32(activeElements.size()), 0.f, false, true);
+                UpdateElementData(ctx, activeElements, centerHoverFadeIn, currentTime);
 
                 ctx->PSSetShaderResources(0, 1, backgroundTexture_->srv.GetAddressOf());
 
                 DrawScreenQuad(ctx);
 
-                ShaderManager::i().SetShaders(ctx, vs_, psWheelElement_);
+                ShaderManager::i().SetShaders(ctx, vsElements_, psWheelElement_);
                 ctx->OMSetBlendState(blendState_.Get(), nullptr, 0xffffffff);
 
-                int n = 0;
-                for (auto it : activeElements)
-                {
-                    it->Draw(ctx, n, baseSpriteDimensions, activeElements.size(), currentTime, currentHovered_, this);
-                    n++;
-                }
+                DrawElements(ctx, activeElements, baseSpriteDimensions, currentTime);
             }
 
             {
-                const auto& io = ImGui::GetIO();
+                const auto cursorPos = CurrentPlatform().cursor->position();
 
                 ShaderManager::i().SetShaders(ctx, vs_, psCursor_);
                 ctx->OMSetBlendState(blendState_.Get(), nullptr, 0xffffffff);
 
-                glm::vec4 spriteDimensions = { io.MousePos.x * screenSize.z, io.MousePos.y * screenSize.w, 0.08f * screenSize.y * screenSize.z, 0.08f };
+                glm::vec4 spriteDimensions = { cursorPos.x * screenSize.z, cursorPos.y * screenSize.w, 0.08f * screenSize.y * screenSize.z, 0.08f };
 
                 UpdateConstantBuffer(ctx, spriteDimensions);
                 DrawScreenQuad(ctx);
@@ -752,6 +635,8 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
         }();
         if (delayElement)
         {
+            auto  scope     = Core::i().frameProfiler().Measure("Delay indicator");
+
             bool  inFadeOut = currentTime >= delayFadeOutTime;
 
             float dt        = float(currentTime - conditionalDelay_.time) / 1000.f;
@@ -761,16 +646,12 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
                 absDt = 1.f - (dt - maximumConditionalWaitTimeOption_.value()) / (ConditionalDelay::FadeOutTime / 1000.f);
             else
                 timeLeft = 1.f - (currentTime - conditionalDelay_.time) / (float(maximumConditionalWaitTimeOption_.value()) * 1000.f);
-            const auto& io = ImGui::GetIO();
-
             ShaderManager::i().SetShaders(ctx, vs_, psDelayIndicator_);
             ctx->OMSetBlendState(blendState_.Get(), nullptr, 0xffffffff);
 
-            float dpiScale = 1.f;
-            if (GFXSettings::i().dpiScaling())
-                dpiScale = float(Core::i().GetDpiForWindow(Core::i().gameWindow())) / 96.f;
+            float     dpiScale = CurrentPlatform().renderer->dpiScale();
 
-            auto      uiScale = float(MumbleLink::i().uiScale());
+            auto      uiScale  = float(CurrentPlatform().gameState->uiScale());
 
             glm::vec2 topLeftCorner;
             topLeftCorner.y = 77.f + 10.f * uiScale;
@@ -808,9 +689,7 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
             spriteDimensions.x += spriteDimensions.z * 0.5f;
             spriteDimensions.y += spriteDimensions.w * 0.5f;
 
-            std::array<float, MaxHoverFadeIns> hoveredFadeIns;
-            std::fill(hoveredFadeIns.begin(), hoveredFadeIns.end(), 0.f);
-            UpdateConstantBuffer(ctx, spriteDimensions, std::min(absDt * 2, 1.f), fmod(currentTime / 1010.f, 55000.f), {}, hoveredFadeIns, timeLeft, delayElement, false);
+            UpdateConstantBuffer(ctx, spriteDimensions, std::min(absDt * 2, 1.f), fmod(currentTime / 1010.f, 55000.f), 0, timeLeft, delayElement, false);
             delayElement->SetShaderState(ctx);
 
             ID3D11ShaderResourceView* srvs[] = { backgroundTexture_->srv.Get(), delayElement->appearance().srv.Get() };
@@ -822,19 +701,18 @@ void Wheel::Draw(ID3D11DeviceContext* ctx)
     }
 }
 
-void Wheel::UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spriteDimensions, float fadeIn, float animationTimer, const std::vector<WheelElement*>& activeElements,
-                                 const std::span<float>& hoveredFadeIns, float timeLeft, bool showIcon, bool tilt)
+void Wheel::UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spriteDimensions, float fadeIn, float animationTimer, u32 elementCount, float timeLeft, bool showIcon,
+                                 bool tilt)
 {
     auto& cb           = *cb_;
     cb->wipeMaskData   = wipeMaskData_;
     cb->wheelFadeIn    = fadeIn;
     cb->animationTimer = animationTimer;
     cb->centerScale    = centerScaleOption_.value();
-    cb->elementCount   = int(activeElements.size());
+    cb->elementCount   = int(elementCount);
     cb->globalOpacity  = opacityMultiplierOption_.value() * 0.01f;
     cb->timeLeft       = timeLeft;
     cb->showIcon       = showIcon;
-    memcpy_s(cb->hoverFadeIns, sizeof(cb->hoverFadeIns), hoveredFadeIns.data(), MaxHoverFadeIns * sizeof(float));
 
     cb.Update(ctx);
     ctx->PSSetConstantBuffers(0, 1, cb.buffer().GetAddressOf());
@@ -842,8 +720,7 @@ void Wheel::UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spri
     glm::mat4x4 tiltMatrix;
     if (tilt)
     {
-        auto      mousePos = ImGui::GetIO().MousePos;
-        glm::vec2 mouseDist{ currentPosition_.x - mousePos.x / float(Core::i().screenWidth()), currentPosition_.y - mousePos.y / float(Core::i().screenHeight()) };
+        glm::vec2 mouseDist = currentPosition_ - CurrentPlatform().cursor->position() / glm::vec2(CurrentPlatform().renderer->screenSize());
         mouseDist = -mouseDist / glm::vec2(spriteDimensions.z, spriteDimensions.w);
         if (glm::length(mouseDist) > 0.2f)
             mouseDist *= 0.2f / glm::length(mouseDist);
@@ -862,6 +739,84 @@ void Wheel::UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spri
     ctx->VSSetConstantBuffers(0, 1, vscb.buffer().GetAddressOf());
 }
 
+void Wheel::UpdateElementData(ID3D11DeviceContext* ctx, const std::vector<WheelElement*>& activeElements, float centerHoverFadeIn, mstime currentTime)
+{
+    GW2_ASSERT(activeElements.size() <= MaxElementCount);
+
+    // Last entry is reserved for the center region
+    const u32 elementCount = std::min(u32(activeElements.size()), MaxElementCount);
+    const u32 entryCount   = elementCount + 1;
+
+    if (entryCount > elementDataCapacity_)
+    {
+        elementDataCapacity_ = std::min(std::bit_ceil(std::max(entryCount, 16u)), MaxElementCount + 1);
+
+        auto               dev = Core::i().device();
+
+        CD3D11_BUFFER_DESC desc(elementDataCapacity_ * u32(sizeof(ElementData)), D3D11_BIND_SHADER_RESOURCE, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE,
+                                D3D11_RESOURCE_MISC_BUFFER_STRUCTURED, u32(sizeof(ElementData)));
+        GW2_CHECKED_HRESULT(dev->CreateBuffer(&desc, nullptr, elementDataBuffer_.ReleaseAndGetAddressOf()));
+
+        CD3D11_SHADER_RESOURCE_VIEW_DESC srvDesc(D3D11_SRV_DIMENSION_BUFFER, DXGI_FORMAT_UNKNOWN, 0, elementDataCapacity_);
+        GW2_CHECKED_HRESULT(dev->CreateShaderResourceView(elementDataBuffer_.Get(), &srvDesc, elementDataSrv_.ReleaseAndGetAddressOf()));
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (SUCCEEDED(ctx->Map(elementDataBuffer_.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+    {
+        auto* data = static_cast<ElementData*>(mapped.pData);
+        for (u32 i = 0; i < elementCount; i++)
+            data[i].hoverFadeIn = activeElements[i]->hoverFadeIn(currentTime, this);
+        data[elementCount].hoverFadeIn = centerHoverFadeIn;
+
+        ctx->Unmap(elementDataBuffer_.Get(), 0);
+    }
+
+    ctx->PSSetShaderResources(2, 1, elementDataSrv_.GetAddressOf());
+}
+
+void Wheel::DrawElements(ID3D11DeviceContext* ctx, const std::vector<WheelElement*>& activeElements, const glm::vec4& baseSpriteDimensions, mstime currentTime)
+{
+    using Instance         = WheelElement::Instance;
+
+    const u32 elementCount = std::min(u32(activeElements.size()), MaxElementCount);
+    const u32 maxInstances = elementCount * WheelElement::MaxInstancesPerElement;
+
+    if (maxInstances > instanceCapacity_)
+    {
+        instanceCapacity_ = std::bit_ceil(std::max(maxInstances, 32u));
+
+        auto               dev = Core::i().device();
+
+        CD3D11_BUFFER_DESC desc(instanceCapacity_ * u32(sizeof(Instance)), D3D11_BIND_SHADER_RESOURCE, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE,
+                                D3D11_RESOURCE_MISC_BUFFER_STRUCTURED, u32(sizeof(Instance)));
+        GW2_CHECKED_HRESULT(dev->CreateBuffer(&desc, nullptr, instanceBuffer_.ReleaseAndGetAddressOf()));
+
+        CD3D11_SHADER_RESOURCE_VIEW_DESC srvDesc(D3D11_SRV_DIMENSION_BUFFER, DXGI_FORMAT_UNKNOWN, 0, instanceCapacity_);
+        GW2_CHECKED_HRESULT(dev->CreateShaderResourceView(instanceBuffer_.Get(), &srvDesc, instanceSrv_.ReleaseAndGetAddressOf()));
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(ctx->Map(instanceBuffer_.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+        return;
+
+    auto* instances     = static_cast<Instance*>(mapped.pData);
+    u32   instanceCount = 0;
+    for (u32 i = 0; i < elementCount; i++)
+        instanceCount += activeElements[i]->FillInstances(instances + instanceCount, int(i), activeElements.size(), baseSpriteDimensions, currentTime, this);
+
+    ctx->Unmap(instanceBuffer_.Get(), 0);
+
+    // All icons live in the shared atlas, so the whole ring is a single draw
+    ctx->VSSetShaderResources(0, 1, instanceSrv_.GetAddressOf());
+    ctx->PSSetShaderResources(3, 1, Core::i().iconAtlas().srv().GetAddressOf());
+    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    ctx->DrawInstanced(4, instanceCount, 0, 0);
+
+    ID3D11ShaderResourceView* nullSrv = nullptr;
+    ctx->VSSetShaderResources(0, 1, &nullSrv);
+}
+
 void Wheel::UpdateConstantBuffer(ID3D11DeviceContext* ctx, const glm::vec4& spriteDimensions)
 {
     auto& vscb             = *Core::i().vertexCB();
@@ -877,34 +832,40 @@ void Wheel::OnFocusLost()
     isVisible_          = false;
     currentTriggerTime_ = 0;
 
-    conditionalDelay_   = {};
+    ResetConditionallyDelayed(false);
 
     // Cancel any active action chains
-    if (actionChain_.isActive())
+    if (ActionChainExecutor::IsActive(actionChain_))
     {
         Log::i().Print(Severity::Warn, "Canceling active action chain due to focus loss");
-        actionChain_.reset();
+        ActionChainExecutor::Cancel(actionChain_);
     }
 }
 
 bool Wheel::CanActivate(const WheelElement* we) const
 {
-    const auto& mumble = MumbleLink::i();
-    if (!mumble.gameHasFocus() || mumble.isMapOpen())
+    const auto& gameState = *CurrentPlatform().gameState;
+    if (!gameState.gameHasFocus() || gameState.isMapOpen())
         return false;
 
-    auto cs = mumble.currentState();
+    auto cs = ToConditionalState(gameState.currentState());
 
-    return we->isUsable(cs);
+    return we->isUsable(cs, PackStateWord());
 }
 
 void Wheel::Sort()
 {
-    sortedWheelElements_.resize(wheelElements_.size());
-    std::ranges::transform(wheelElements_, sortedWheelElements_.begin(), [](auto& p) { return p.get(); });
+    sortedOrder_.resize(wheelElements_.size());
+    std::iota(sortedOrder_.begin(), sortedOrder_.end(), 0u);
+    std::ranges::sort(sortedOrder_, [&](u32 a, u32 b) { return wheelElements_[a]->sortingPriority() < wheelElements_[b]->sortingPriority(); });
 
-    std::ranges::sort(sortedWheelElements_, [](const WheelElement* a, const WheelElement* b) { return a->sortingPriority() < b->sortingPriority(); });
+    sortedWheelElements_.resize(wheelElements_.size());
+    std::ranges::transform(sortedOrder_, sortedWheelElements_.begin(), [&](u32 i) { return wheelElements_[i].get(); });
     minElementSortingPriority_ = sortedWheelElements_.front()->sortingPriority();
+
+    visibleCache_.Reserve(sortedWheelElements_.size());
+    usableCache_.Reserve(sortedWheelElements_.size());
+    InvalidateElementCache();
 }
 
 WheelElement* Wheel::GetCenterHoveredElement()
@@ -928,91 +889,84 @@ WheelElement* Wheel::GetCenterHoveredElement()
 
 WheelElement* Wheel::GetFavorite(Favorite fav) const
 {
-    ConditionalState cs = MumbleLink::i().currentState();
-
-    int              favoriteId;
-    if (NotNone(cs & ConditionalState::InWvW) && fav.bits.inWvW != -1)
-        favoriteId = fav.bits.inWvW;
-    else if (NotNone(cs & ConditionalState::InCombat) && fav.bits.inCombat != -1)
-        favoriteId = fav.bits.inCombat;
-    else if (NotNone(cs & ConditionalState::OnWater) && fav.bits.onWater != -1)
-        favoriteId = fav.bits.onWater;
-    else if (NotNone(cs & ConditionalState::Underwater) && fav.bits.underwater != -1)
-        favoriteId = fav.bits.underwater;
-    else
-        favoriteId = fav.bits.baseline;
-
-    if (favoriteId < 0 || favoriteId >= int(wheelElements_.size()))
+    const int favoriteId = fav.Pick(CurrentPlatform().gameState->currentState());
+    if (favoriteId < 0 || favoriteId >= int(wheelElements_.size()) || !Predicates().bound().test(favoriteId))
         return nullptr;
 
-    auto* elem = wheelElements_[favoriteId].get();
-
-    return elem->isBound() ? elem : nullptr;
+    return wheelElements_[favoriteId].get();
 }
 
-std::vector<WheelElement*> Wheel::GetVisibleElements(ConditionalState cs, bool sorted) const
+const ElementPredicateTable& Wheel::Predicates() const
 {
-    std::vector<WheelElement*> elems;
-    if (sorted)
+    if (!predicates_.valid())
     {
-        for (auto& we : sortedWheelElements_)
-            if (we->isVisible(cs))
-                elems.push_back(we);
+        std::vector<ElementConditions> conditions;
+        conditions.reserve(wheelElements_.size());
+        for (const auto& we : wheelElements_)
+            conditions.push_back(we->conditions());
+        predicates_.Compile(conditions);
     }
-    else
+
+    return predicates_;
+}
+
+namespace
+{
+std::vector<WheelElement*> CollectElements(const ElementPredicateTable::Mask& mask, const std::vector<std::unique_ptr<WheelElement>>& elements, const std::vector<u32>* order)
+{
+    std::vector<WheelElement*> elems;
+    elems.reserve(mask.count());
+    for (size_t i = 0; i < elements.size(); i++)
     {
-        for (auto& we : wheelElements_)
-            if (we->isVisible(cs))
-                elems.push_back(we.get());
+        const u32 index = order ? (*order)[i] : u32(i);
+        if (mask.test(index))
+            elems.push_back(elements[index].get());
     }
 
     return elems;
 }
+} // namespace
 
-bool Wheel::HasVisibleElements(ConditionalState cs) const
+std::vector<WheelElement*> Wheel::GetVisibleElements(ConditionalState cs, bool sorted) const
 {
-    for (auto& we : wheelElements_)
-        if (we->isVisible(cs))
-            return true;
+    return CollectElements(Predicates().Visible(ToGameConditions(cs), PackStateWord()), wheelElements_, sorted ? &sortedOrder_ : nullptr);
+}
+
+const std::vector<WheelElement*>& Wheel::GetCachedVisibleElements(ConditionalState cs) const
+{
+    const auto conditions = ToGameConditions(cs);
+    const auto stateWord  = PackStateWord();
+    return visibleCache_.Get(conditions, stateWord, sortedOrder_, [&] { return Predicates().Visible(conditions, stateWord); }, [&](u32 i) { return wheelElements_[i].get(); });
+}
 
-    return false;
+bool Wheel::HasVisibleElements(ConditionalState cs) const
+{
+    return Predicates().Visible(ToGameConditions(cs), PackStateWord()).any();
 }
 
 std::vector<WheelElement*> Wheel::GetUsableElements(ConditionalState cs, bool sorted) const
 {
-    std::vector<WheelElement*> elems;
-    if (sorted)
-    {
-        for (auto& we : sortedWheelElements_)
-            if (we->isUsable(cs))
-                elems.push_back(we);
-    }
-    else
-    {
-        for (auto& we : wheelElements_)
-            if (we->isUsable(cs))
-                elems.push_back(we.get());
-    }
+    return CollectElements(Predicates().Usable(ToGameConditions(cs), PackStateWord()), wheelElements_, sorted ? &sortedOrder_ : nullptr);
+}
 
-    return elems;
+const std::vector<WheelElement*>& Wheel::GetCachedUsableElements(ConditionalState cs) const
+{
+    const auto conditions = ToGameConditions(cs);
+    const auto stateWord  = PackStateWord();
+    return usableCache_.Get(conditions, stateWord, sortedOrder_, [&] { return Predicates().Usable(conditions, stateWord); }, [&](u32 i) { return wheelElements_[i].get(); });
 }
 
 bool Wheel::HasUsableElements(ConditionalState cs) const
 {
-    for (auto& we : wheelElements_)
-        if (we->isUsable(cs))
-            return true;
-
-    return false;
+    return Predicates().Usable(ToGameConditions(cs), PackStateWord()).any();
 }
 
 bool Wheel::HasVisibleOrUsableElements(ConditionalState cs) const
 {
-    for (auto& we : wheelElements_)
-        if (we->isUsable(cs) || we->isVisible(cs))
-            return true;
-
-    return false;
+    const auto  conditions = ToGameConditions(cs);
+    const auto  stateWord  = PackStateWord();
+    const auto& predicates = Predicates();
+    return (predicates.Usable(conditions, stateWord) | predicates.Visible(conditions, stateWord)).any();
 }
 
 void Wheel::OnMouseMove(bool& rv)
@@ -1021,6 +975,16 @@ void Wheel::OnMouseMove(bool& rv)
     {
         UpdateHover();
 
+        if (flickSelectOption_.value() && !clickSelectOption_.value())
+        {
+            if (const auto flick = flickRecognizer_.Feed(CurrentPlatform().clock->now(), *hoverTracker_.latest()))
+            {
+                currentHovered_ = ElementAtOffset(*flick);
+                if (currentHovered_)
+                    DeactivateWheel(true);
+            }
+        }
+
         // If holding down the button is not necessary, modify behavior
         if (noHoldOption_.value() && isVisible_ && currentHovered_ != nullptr)
             DeactivateWheel();
@@ -1047,7 +1011,7 @@ PassToGame Wheel::KeybindEvent(bool center, Activated activated)
 {
     const bool previousVisibility = isVisible_;
 
-    if (MumbleLink::i().isMapOpen())
+    if (CurrentPlatform().gameState->isMapOpen())
         isVisible_ = false;
     else
     {
@@ -1064,8 +1028,8 @@ PassToGame Wheel::KeybindEvent(bool center, Activated activated)
             {
                 Log::i().Print(Severity::Debug, "Sending bypass keybind.");
 
-                Input::i().KeyUpActive();
-                Input::i().SendKeybind(bypassKeybind->keyCombo(), std::nullopt);
+                CurrentPlatform().input->KeyUpActive();
+                CurrentPlatform().input->SendKeybind(ToKeyChord(bypassKeybind->keyCombo()), std::nullopt);
             }
         }
 
@@ -1095,12 +1059,13 @@ PassToGame Wheel::KeybindEvent(bool center, Activated activated)
 
 void Wheel::ActivateWheel(bool isMountOverlayLocked)
 {
-    auto& io             = ImGui::GetIO();
+    const auto& platform  = CurrentPlatform();
+    const auto  cursorPos = platform.cursor->position();
 
-    cursorResetPosition_ = { static_cast<int>(io.MousePos.x), static_cast<int>(io.MousePos.y) };
+    cursorResetPosition_  = { static_cast<int>(cursorPos.x), static_cast<int>(cursorPos.y) };
     LogDebug("Storing cursor position ({}, {}) for restore...", cursorResetPosition_.x, cursorResetPosition_.y);
 
-    if (!HasVisibleOrUsableElements(MumbleLink::i().currentState()))
+    if (!HasVisibleOrUsableElements(ToConditionalState(platform.gameState->currentState())))
     {
         LogWarn("Triggered menu '{}', but no element is visible or usable!", displayName_);
         bool isAnyBound = false;
@@ -1126,38 +1091,45 @@ void Wheel::ActivateWheel(bool isMountOverlayLocked)
     else
     {
         resetCursorPositionToCenter_ = false;
-        currentPosition_.x           = io.MousePos.x / float(Core::i().screenWidth());
-        currentPosition_.y           = io.MousePos.y / float(Core::i().screenHeight());
+        currentPosition_             = cursorPos / glm::vec2(platform.renderer->screenSize());
     }
 
-    currentTriggerTime_ = TimeInMilliseconds();
+    currentTriggerTime_ = platform.clock->now();
 
     wipeMaskData_       = { frand() * 0.20f + 0.40f, frand() * 0.20f + 0.40f, frand() * 2 * float(M_PI) };
 
+    hoverTracker_.Reset();
+    flickRecognizer_.Reset(currentTriggerTime_, FlickThresholds());
     UpdateHover();
 }
 
 void Wheel::PassToGame()
 {
     bool centerKeybind = currentPosition_.x == 0.5f && currentPosition_.y == 0.5f;
-    Input::i().SendKeybind((centerKeybind ? centralKeybind_ : keybind_).keyCombo());
+    CurrentPlatform().input->SendKeybind(ToKeyChord((centerKeybind ? centralKeybind_ : keybind_).keyCombo()), std::nullopt);
     currentHovered_ = nullptr;
 }
 
 
-void Wheel::DeactivateWheel()
+void Wheel::DeactivateWheel(bool flicked)
 {
     isVisible_                   = false;
     resetCursorPositionToCenter_ = false;
 
+    // A flick can cross a sector and spring back toward the center faster than hover is looked at; go by the trajectory
+    if (!flicked)
+        if (const auto offset = hoverTracker_.ReleaseOffset(CurrentPlatform().clock->now(), HoverDeadZoneSq(), FlickReleaseWindow))
+            currentHovered_ = ElementAtOffset(*offset);
+    hoverTracker_.Reset();
+
     if (currentHovered_ == nullptr && OptHasValue(conditionalDelay_.element) && centerCancelDelayedInputOption_.value())
     {
         ResetConditionallyDelayed(true);
         return;
     }
 
-    // If keybind release was done before the wheel is visible, check our behavior
-    if (currentTriggerTime_ + displayDelayOption_.value() > TimeInMilliseconds())
+    // If keybind release was done before the wheel is visible, check our behavior; a recognized flick already made its choice
+    if (!flicked && currentTriggerTime_ + displayDelayOption_.value() > CurrentPlatform().clock->now())
     {
         if (!SpecialBehaviorBeforeDelay())
         {
@@ -1210,16 +1182,23 @@ void Wheel::SendKeybindOrDelay(OptKeybindWheelElement kbwe, std::optional<Point>
         if (mousePos)
         {
             Log::i().Print(Severity::Debug, "Moving cursor to position ({}, {}).", mousePos->x, mousePos->y);
-            Input::i().SendKeybind({}, mousePos);
+            CurrentPlatform().input->SendKeybind({}, ToCursorPos(mousePos));
         }
         return;
     }
 
-    auto cs                = MumbleLink::i().currentState();
+    if (HandleQueueCommand(kbwe))
+    {
+        if (mousePos)
+            CurrentPlatform().input->SendKeybind({}, ToCursorPos(mousePos));
+        return;
+    }
+
+    auto cs                = ToConditionalState(CurrentPlatform().gameState->currentState());
 
     // We're not checking WvW here; no reason to enqueue an action that would require a map change to execute
     bool shouldAlwaysDelay = CustomDelayCheck(kbwe);
-    bool shouldDelay       = shouldAlwaysDelay || (enableQueuingOption_.value() && std::holds_alternative<WheelElement*>(kbwe) && !std::get<WheelElement*>(kbwe)->isUsable(cs));
+    bool shouldDelay       = shouldAlwaysDelay || (enableQueuingOption_.value() && std::holds_alternative<WheelElement*>(kbwe) && !std::get<WheelElement*>(kbwe)->isUsable(cs, PackStateWord()));
 
     // Check if this is a WheelElement with an action chain
     if (std::holds_alternative<WheelElement*>(kbwe))
@@ -1231,21 +1210,10 @@ void Wheel::SendKeybindOrDelay(OptKeybindWheelElement kbwe, std::optional<Point>
             // If we can activate now (not in combat), start the chain immediately
             if (!shouldDelay)
             {
-                actionChain_.steps         = element->getChain();
-                actionChain_.currentStep   = 0;
-                actionChain_.nextStepTime  = TimeInMilliseconds();
-                actionChain_.sourceElement = element;
-
                 if (mousePos)
-                {
-                    Log::i().Print(Severity::Info, "Starting action chain for '{}' with {} steps.", element->displayName(), actionChain_.steps.size());
-                    Input::i().SendKeybind({}, mousePos); // Reset cursor position
-                }
-                else
-                {
-                    Log::i().Print(Severity::Info, "Starting action chain for '{}' with {} steps.", element->displayName(), actionChain_.steps.size());
-                }
+                    CurrentPlatform().input->SendKeybind({}, ToCursorPos(mousePos)); // Reset cursor position
 
+                StartActionChain(element);
                 return; // Don't use normal single-keybind flow
             }
             // Otherwise fall through to queue the element (action chain will start when conditions allow)
@@ -1256,15 +1224,125 @@ void Wheel::SendKeybindOrDelay(OptKeybindWheelElement kbwe, std::optional<Point>
         Log::i().Print(Severity::Debug, "Moving cursor to position ({}, {}) and queuing keybind.", mousePos->x, mousePos->y);
     else
         Log::i().Print(Severity::Debug, "Queuing keybind.");
-    Input::i().SendKeybind({}, mousePos);
+    CurrentPlatform().input->SendKeybind({}, ToCursorPos(mousePos));
 
-    auto& cd      = conditionalDelay_;
-    cd.element    = kbwe;
-    cd.time       = TimeInMilliseconds();
-    cd.testPasses = cd.immediate = cd.hidden = !shouldDelay;
+    QueueInput(kbwe, !shouldDelay);
+}
+
+void Wheel::StartActionChain(WheelElement* element)
+{
+    // A new chain replaces whatever is left of the previous one
+    ActionChainExecutor::Cancel(actionChain_);
+
+    std::vector<ActionChainExecutor::Step> steps;
+    for (const auto& step : element->getChain())
+    {
+        if (step.keyCombo.key() == ScanCode::None)
+        {
+            steps.push_back({ {}, std::chrono::milliseconds(step.delayAfterMs) });
+            continue;
+        }
+
+        const auto keys  = ToKeyChord(step.keyCombo);
+        auto*      input = CurrentPlatform().input;
+        ActionChainExecutor::AppendKeybind(steps, [input, keys] { return input->PressKeybindNow(keys); }, [input, keys] { input->ReleaseKeybindNow(keys); },
+                                           std::chrono::milliseconds(step.delayAfterMs));
+    }
+
+    Log::i().Print(Severity::Info, "Starting action chain for '{}' with {} steps.", element->displayName(), element->getChain().size());
+    actionChain_ = Core::i().actionChainExecutor().Submit(std::move(steps));
+    if (!actionChain_)
+        Log::i().Print(Severity::Warn, "Too many action chains pending, dropped '{}'", element->displayName());
+}
+
+void Wheel::QueueInput(const OptKeybindWheelElement& kbwe, bool immediate)
+{
+    const auto now = CurrentPlatform().clock->now();
+    if (ReplacesQueuedInput())
+        CancelQueuedInputs();
+
+    const std::int64_t   delay = immediate ? 0 : conditionalDelayDelayOption_.value();
+
+    ActionQueue::Request request;
+    request.owner     = this;
+    request.notBefore = std::int64_t(now);
+    request.expiry    = std::int64_t(now) + maximumConditionalWaitTimeOption_.value() * 1000ll;
+    request.sendDelay = delay;
+    // Wheels that keep their input queued after sending retry after a second for immediate inputs, at most once every 3 seconds otherwise
+    if (!clearConditionalDelayOnSend_)
+        request.retryInterval = immediate ? 1000 : std::max<std::int64_t>(3000 - delay, 0);
+    request.ready    = [this, kbwe] { return std::holds_alternative<Keybind*>(kbwe) || CanActivate(std::get<WheelElement*>(kbwe)); };
+    request.send     = [this, kbwe] { return SendQueuedInput(kbwe); };
+    request.finished = [this](ActionQueue::Id id, ActionQueue::Outcome outcome) { OnQueuedInputFinished(id, outcome); };
+
+    const auto id = Core::i().actionQueue().Push(std::move(request), std::int64_t(now));
+    queuedInputs_.push_back({ id, kbwe, now, immediate });
+
+    conditionalDelay_ = { kbwe, now, immediate };
+    InvalidateElementCache();
+}
+
+bool Wheel::SendQueuedInput(OptKeybindWheelElement kbwe)
+{
+    if (std::holds_alternative<WheelElement*>(kbwe))
+    {
+        WheelElement* element = std::get<WheelElement*>(kbwe);
+        if (element->hasActionChain())
+        {
+            StartActionChain(element);
+
+            // The chain takes over from here, never retry it
+            return false;
+        }
+    }
+
+    if (auto kb = GetKeybindFromOpt(kbwe))
+        CurrentPlatform().input->SendKeybind(ToKeyChord(kb->keyCombo()), std::nullopt);
+
+    return KeepsQueuedInputAfterSend();
+}
+
+void Wheel::OnQueuedInputFinished(ActionQueue::Id id, ActionQueue::Outcome outcome)
+{
+    auto it = std::ranges::find(queuedInputs_, id, &QueuedInput::id);
+    if (it == queuedInputs_.end())
+        return;
+
+    const bool hidden = it->hidden;
+    queuedInputs_.erase(it);
+
+    // ResetConditionallyDelayed updates the indicator itself once every input is cancelled
+    if (cancellingQueuedInputs_)
+        return;
+
+    if (queuedInputs_.empty())
+        ClearDelayIndicator(outcome == ActionQueue::Outcome::Expired || !hidden, CurrentPlatform().clock->now());
+    else
+    {
+        const auto& latest = queuedInputs_.back();
+        conditionalDelay_  = { latest.element, latest.time, latest.hidden };
+        InvalidateElementCache();
+    }
+}
+
+void Wheel::CancelQueuedInputs()
+{
+    if (queuedInputs_.empty())
+        return;
+
+    cancellingQueuedInputs_ = true;
+    Core::f([&](auto& i) { i.actionQueue().CancelOwner(this); });
+    cancellingQueuedInputs_ = false;
+    queuedInputs_.clear();
 }
 
 void Wheel::ResetConditionallyDelayed(bool withFadeOut, mstime currentTime)
+{
+    CancelQueuedInputs();
+    ClearDelayIndicator(withFadeOut, currentTime);
+}
+
+void Wheel::ClearDelayIndicator(bool withFadeOut, mstime currentTime)
 {
     if (withFadeOut && std::holds_alternative<WheelElement*>(conditionalDelay_.element))
         conditionalDelayDisplay_ = std::get<WheelElement*>(conditionalDelay_.element);
@@ -1275,5 +1353,8 @@ void Wheel::ResetConditionallyDelayed(bool withFadeOut, mstime currentTime)
     conditionalDelay_.time = currentTime - maximumConditionalWaitTimeOption_.value() * 1000ull;
     if (!withFadeOut)
         conditionalDelay_.time -= ConditionalDelay::FadeOutTime;
+
+    // Queued state feeds into some custom behaviors (e.g. mount cancel/force)
+    InvalidateElementCache();
 }
 } // namespace GW2Radial
@@ -4,6 +4,8 @@
 #include <Utility.h>
 #include <Wheel.h>
 #include <WheelElement.h>
+#include <WheelLayout.h>
+#include <format>
 #include <imgui_internal.h>
 
 namespace GW2Radial
@@ -11,7 +13,7 @@ namespace GW2Radial
 ConstantBufferWPtr<WheelElement::WheelElementCB> WheelElement::cb_s;
 
 WheelElement::WheelElement(u32 id, const std::string& nickname, const std::string& category, const std::string& displayName, const glm::vec4& color,
-                           ConditionalProperties defaultProps, Texture2D tex)
+                           ConditionalProperties defaultProps, Texture2D tex, const std::optional<AtlasRect>& texRegion)
     : sortingPriorityOption_(displayName + " Priority", nickname + "_priority", category, static_cast<int>(id))
     , props_("", nickname + "_props", category, defaultProps)
     , nickname_(nickname)
@@ -23,15 +25,24 @@ WheelElement::WheelElement(u32 id, const std::string& nickname, const std::strin
 {
     auto dev = Core::i().device();
     if (!appearance_.srv)
+    {
+        auto scope  = Core::i().startupProfile().Measure(std::format("Texture {}", nickname_));
         appearance_ = CreateTextureFromResource(dev.Get(), Core::i().dllModule(), elementId_);
+    }
 
     GW2_ASSERT(appearance_.srv);
 
     D3D11_TEXTURE2D_DESC desc;
     appearance_.texture->GetDesc(&desc);
 
-    aspectRatio_ = static_cast<float>(desc.Height) / static_cast<float>(desc.Width);
-    texWidth_    = static_cast<float>(desc.Width);
+    const AtlasRect region = texRegion.value_or(AtlasRect{ 0, 0, desc.Width, desc.Height });
+
+    aspectRatio_           = static_cast<float>(region.height) / static_cast<float>(region.width);
+    texWidth_              = static_cast<float>(region.width);
+    appearanceUvRect_      = { static_cast<float>(region.x) / static_cast<float>(desc.Width), static_cast<float>(region.y) / static_cast<float>(desc.Height),
+                               static_cast<float>(region.width) / static_cast<float>(desc.Width), static_cast<float>(region.height) / static_cast<float>(desc.Height) };
+
+    atlasEntry_            = Core::i().iconAtlas().Add(appearance_, texRegion);
 
     if (auto cb = cb_s.lock())
         cb_ = cb;
@@ -168,109 +179,54 @@ int WheelElement::DrawPriority(int extremumIndicator)
     return rv;
 }
 
-void WheelElement::SetShaderState(ID3D11DeviceContext* ctx) const
+glm::vec4 WheelElement::adjustedColor() const
 {
-    glm::vec4 adjustedColor  = color_;
-    adjustedColor.x          = Lerp(1, adjustedColor.x, colorizeAmount_);
-    adjustedColor.y          = Lerp(1, adjustedColor.y, colorizeAmount_);
-    adjustedColor.z          = Lerp(1, adjustedColor.z, colorizeAmount_);
-
-    auto& sm                 = ShaderManager::i();
-
-    (*cb_)->adjustedColor    = adjustedColor;
-    (*cb_)->premultiplyAlpha = premultiplyAlpha_;
+    glm::vec4 adjustedColor = color_;
+    adjustedColor.x         = Lerp(1, adjustedColor.x, colorizeAmount_);
+    adjustedColor.y         = Lerp(1, adjustedColor.y, colorizeAmount_);
+    adjustedColor.z         = Lerp(1, adjustedColor.z, colorizeAmount_);
 
-    cb_->Update(ctx);
-    ctx->PSSetConstantBuffers(1, 1, cb_->buffer().GetAddressOf());
+    return adjustedColor;
 }
 
-void WheelElement::SetShaderState(ID3D11DeviceContext* ctx, const glm::vec4& spriteDimensions, const ComPtr<ID3D11Buffer>& wheelCb, bool shadow, float hoverRatio) const
+void WheelElement::SetShaderState(ID3D11DeviceContext* ctx) const
 {
-    glm::vec4 adjustedColor    = color_;
-    adjustedColor.x            = Lerp(1, adjustedColor.x, colorizeAmount_);
-    adjustedColor.y            = Lerp(1, adjustedColor.y, colorizeAmount_);
-    adjustedColor.z            = Lerp(1, adjustedColor.z, colorizeAmount_);
-
-    auto& sm                   = ShaderManager::i();
-
-    (*cb_)->elementHoverFadeIn = hoverRatio;
-    (*cb_)->adjustedColor      = shadow ? glm::vec4{ 0.f, 0.f, 0.f, shadowStrength_ } : adjustedColor;
-    (*cb_)->premultiplyAlpha   = shadow ? false : premultiplyAlpha_;
+    (*cb_)->adjustedColor    = adjustedColor();
+    (*cb_)->iconUvRect       = appearanceUvRect_;
+    (*cb_)->premultiplyAlpha = premultiplyAlpha_;
 
     cb_->Update(ctx);
-    ID3D11Buffer* cbs[] = { wheelCb.Get(), cb_->buffer().Get() };
-    ctx->PSSetConstantBuffers(0, u32(std::size(cbs)), cbs);
-
-    auto& vscb             = *Core::i().vertexCB();
-    vscb->spriteDimensions = spriteDimensions;
-    if (shadow)
-    {
-        vscb->spriteDimensions.z *= 1.05f + hoverRatio * 0.04f;
-        vscb->spriteDimensions.w *= 1.05f + hoverRatio * 0.04f;
-    }
-    vscb->spriteZ = shadow ? 0.f : 0.02f + hoverRatio * 0.04f;
-    vscb.Update(ctx);
-    ctx->VSSetConstantBuffers(0, 1, vscb.buffer().GetAddressOf());
+    ctx->PSSetConstantBuffers(1, 1, cb_->buffer().GetAddressOf());
 }
 
-void WheelElement::Draw(ID3D11DeviceContext* ctx, int n, glm::vec4 spriteDimensions, size_t activeElementsCount, const mstime& currentTime, const WheelElement* elementHovered,
-                        const Wheel* parent)
+u32 WheelElement::FillInstances(Instance* instances, int n, size_t activeElementsCount, const glm::vec4& spriteDimensions, const mstime& currentTime, const Wheel* parent) const
 {
-    const float hoverTimer   = SmoothStep(hoverFadeIn(currentTime, parent));
-
-    float       elementAngle = static_cast<float>(n) / static_cast<float>(activeElementsCount) * 2 * static_cast<float>(M_PI);
-    if (activeElementsCount == 1)
-        elementAngle = 0;
-    const glm::vec2 elementLocation{ cos(elementAngle - static_cast<float>(M_PI) / 2) * 0.2f, sin(elementAngle - static_cast<float>(M_PI) / 2) * 0.2f };
-
-    spriteDimensions.x += elementLocation.x * spriteDimensions.z;
-    spriteDimensions.y += elementLocation.y * spriteDimensions.w;
-
-    float elementDiameter = static_cast<float>(sin((2 * M_PI / static_cast<double>(activeElementsCount)) / 2)) * 2.f * 0.2f * 0.66f;
-    if (activeElementsCount == 1)
-        elementDiameter = 2.f * 0.2f;
-    else
-        elementDiameter *= Lerp(1.f, 1.1f, hoverTimer);
-
-    switch (activeElementsCount)
-    {
-        case 1:
-            spriteDimensions.z *= 0.5f;
-            spriteDimensions.w *= 0.5f;
-            break;
-        case 2:
-            spriteDimensions.z *= 0.7f;
-            spriteDimensions.w *= 0.7f;
-            break;
-        case 3:
-            spriteDimensions.z *= 0.9f;
-            spriteDimensions.w *= 0.9f;
-            break;
-        case 4:
-            spriteDimensions.z *= 0.95f;
-            spriteDimensions.w *= 0.95f;
-            break;
-        default:
-            break;
-    }
-
-    spriteDimensions.z *= elementDiameter;
-    spriteDimensions.w *= elementDiameter;
-
-    spriteDimensions.w *= aspectRatio_;
-
-    ctx->PSSetShaderResources(1, 1, appearance_.srv.GetAddressOf());
+    const float hoverTimer = SmoothStep(hoverFadeIn(currentTime, parent));
+    const auto  layout     = ComputeElementLayout(n, activeElementsCount, spriteDimensions, hoverTimer, aspectRatio_);
 
+    u32         count      = 0;
     if (shadowStrength_ > 0.f)
     {
-        SetShaderState(ctx, spriteDimensions, parent->GetConstantBuffer(), true, hoverTimer);
-
-        DrawScreenQuad(ctx);
+        auto& shadow            = instances[count++];
+        shadow.spriteDimensions = layout.shadowSpriteDimensions;
+        shadow.color            = { 0.f, 0.f, 0.f, shadowStrength_ };
+        shadow.uvRect           = atlasEntry_->uvRect;
+        shadow.slice            = atlasEntry_->page;
+        shadow.hoverFadeIn      = hoverTimer;
+        shadow.spriteZ          = layout.shadowSpriteZ;
+        shadow.flags            = atlasEntry_->distanceField ? DistanceFieldFlag : 0;
     }
 
-    SetShaderState(ctx, spriteDimensions, parent->GetConstantBuffer(), false, hoverTimer);
+    auto& icon            = instances[count++];
+    icon.spriteDimensions = layout.spriteDimensions;
+    icon.color            = adjustedColor();
+    icon.uvRect           = atlasEntry_->uvRect;
+    icon.slice            = atlasEntry_->page;
+    icon.hoverFadeIn      = hoverTimer;
+    icon.spriteZ          = layout.spriteZ;
+    icon.flags            = (premultiplyAlpha_ ? PremultiplyAlphaFlag : 0) | (atlasEntry_->distanceField ? DistanceFieldFlag : 0);
 
-    DrawScreenQuad(ctx);
+    return count;
 }
 
 float WheelElement::hoverFadeIn(const mstime& currentTime, const Wheel* parent) const
@@ -0,0 +1,186 @@
+#include <WheelLayout.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GW2Radial
+{
+ElementLayout ComputeElementLayout(int n, size_t activeElementsCount, glm::vec4 spriteDimensions, float hoverTimer, float aspectRatio)
+{
+    constexpr float pi           = std::numbers::pi_v<float>;
+
+    float           elementAngle = static_cast<float>(n) / static_cast<float>(activeElementsCount) * 2 * pi;
+    if (activeElementsCount == 1)
+        elementAngle = 0;
+    const glm::vec2 elementLocation{ std::cos(elementAngle - pi / 2) * 0.2f, std::sin(elementAngle - pi / 2) * 0.2f };
+
+    spriteDimensions.x += elementLocation.x * spriteDimensions.z;
+    spriteDimensions.y += elementLocation.y * spriteDimensions.w;
+
+    float elementDiameter = static_cast<float>(std::sin((2 * std::numbers::pi / static_cast<double>(activeElementsCount)) / 2)) * 2.f * 0.2f * 0.66f;
+    if (activeElementsCount == 1)
+        elementDiameter = 2.f * 0.2f;
+    else
+        elementDiameter *= std::lerp(1.f, 1.1f, hoverTimer);
+
+    switch (activeElementsCount)
+    {
+        case 1:
+            spriteDimensions.z *= 0.5f;
+            spriteDimensions.w *= 0.5f;
+            break;
+        case 2:
+            spriteDimensions.z *= 0.7f;
+            spriteDimensions.w *= 0.7f;
+            break;
+        case 3:
+            spriteDimensions.z *= 0.9f;
+            spriteDimensions.w *= 0.9f;
+            break;
+        case 4:
+            spriteDimensions.z *= 0.95f;
+            spriteDimensions.w *= 0.95f;
+            break;
+        default:
+            break;
+    }
+
+    spriteDimensions.z *= elementDiameter;
+    spriteDimensions.w *= elementDiameter;
+
+    spriteDimensions.w *= aspectRatio;
+
+    ElementLayout layout;
+    layout.spriteDimensions         = spriteDimensions;
+    layout.spriteZ                  = 0.02f + hoverTimer * 0.04f;
+
+    layout.shadowSpriteDimensions   = spriteDimensions;
+    layout.shadowSpriteDimensions.z *= 1.05f + hoverTimer * 0.04f;
+    layout.shadowSpriteDimensions.w *= 1.05f + hoverTimer * 0.04f;
+    layout.shadowSpriteZ            = 0.f;
+
+    return layout;
+}
+
+namespace
+{
+// Rotates a screen-space offset so that straight up maps to angle zero and angles grow clockwise on screen,
+// i.e. atan2(result.y, result.x) equals the angle the hover code has always used
+glm::vec2 ToSectorSpace(glm::vec2 offset)
+{
+    return { -offset.y, offset.x };
+}
+
+// Octant of a sector-space direction, counting counterclockwise from +x over [0, 2pi); boundary handling mirrors atan2
+std::uint32_t OctantOf(glm::vec2 p)
+{
+    std::uint32_t octant = 0;
+    if (p.y < 0 || (p.y == 0 && p.x < 0))
+    {
+        p = -p;
+        octant += 4;
+    }
+    if (p.x <= 0 && p.y > 0)
+    {
+        p = { p.y, -p.x };
+        octant += 2;
+    }
+    if (p.y >= p.x && p.y > 0)
+        octant += 1;
+    return octant;
+}
+
+float Cross(glm::vec2 a, glm::vec2 b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+} // namespace
+
+void SectorTable::BuildUniform(size_t count)
+{
+    std::vector<float> weights(count, 1.f);
+    Build(weights);
+}
+
+void SectorTable::Build(std::span<const float> weights)
+{
+    constexpr double twoPi = 2 * std::numbers::pi;
+
+    sectorCount_           = weights.size();
+    boundaries_.clear();
+    octants_ = {};
+    if (weights.empty())
+        return;
+
+    double total = 0;
+    for (float w : weights)
+        total += std::max(w, 0.f);
+    if (total <= 0)
+    {
+        // Degenerate weights fall back to equal slices rather than an unusable table
+        std::vector<float> uniform(weights.size(), 1.f);
+        Build(uniform);
+        return;
+    }
+
+    // Sector 0 straddles angle zero, so the first boundary sits half its width counterclockwise of it
+    struct AngleBoundary
+    {
+        double        angle;
+        std::uint32_t sector;
+    };
+    std::vector<AngleBoundary> angles;
+    angles.reserve(weights.size());
+
+    double start = -0.5 * std::max(weights[0], 0.f) / total * twoPi;
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        const double width = std::max(weights[i], 0.f) / total * twoPi;
+        if (width > 0)
+        {
+            double a = std::fmod(start, twoPi);
+            if (a < 0)
+                a += twoPi;
+            angles.push_back({ a, static_cast<std::uint32_t>(i) });
+        }
+        start += width;
+    }
+    std::ranges::stable_sort(angles, {}, &AngleBoundary::angle);
+
+    boundaries_.reserve(angles.size());
+    for (const auto& b : angles)
+        boundaries_.push_back({ glm::vec2(static_cast<float>(std::cos(b.angle)), static_cast<float>(std::sin(b.angle))), b.sector });
+
+    size_t cursor = 0;
+    for (std::uint32_t o = 0; o < octants_.size(); o++)
+    {
+        const double octantStart = o * twoPi / 8;
+        const double octantEnd   = (o + 1) * twoPi / 8;
+
+        // The sector covering the start of the octant is the one opened by the last boundary before it, wrapping around
+        while (cursor < angles.size() && angles[cursor].angle < octantStart)
+            cursor++;
+        auto& octant       = octants_[o];
+        octant.firstSector = cursor == 0 ? angles.back().sector : angles[cursor - 1].sector;
+        octant.begin       = static_cast<std::uint32_t>(cursor);
+
+        size_t last        = cursor;
+        while (last < angles.size() && angles[last].angle < octantEnd)
+            last++;
+        octant.end = static_cast<std::uint32_t>(last);
+    }
+}
+
+size_t SectorTable::Resolve(glm::vec2 offset) const
+{
+    const glm::vec2 p      = ToSectorSpace(offset);
+    const auto&     octant = octants_[OctantOf(p)];
+
+    // Boundaries within one octant span less than pi, so the sign of the cross product orders them against p
+    const auto      first  = boundaries_.begin() + octant.begin;
+    const auto      last   = boundaries_.begin() + octant.end;
+    const auto      it     = std::partition_point(first, last, [&](const Boundary& b) { return Cross(b.direction, p) >= 0; });
+
+    return it == first ? octant.firstSector : std::prev(it)->sector;
+}
+} // namespace GW2Radial
@@ -0,0 +1,247 @@
+#include <Core.h>
+#include <GFXSettings.h>
+#include <PlatformConversions.h>
+#include <Win32Platform.h>
+#include <algorithm>
+#include <imgui.h>
+#include <ranges>
+
+namespace GW2Radial
+{
+namespace
+{
+// ScanCode values are set 1 make codes, keeping the 0xE0/0xE1 prefix of extended keys in the high byte
+bool IsKeyboardScanCode(u32 code)
+{
+    const u32 prefix = code >> 8;
+    return code != 0 && (prefix == 0 || prefix == 0xE0 || prefix == 0xE1);
+}
+
+INPUT MakeKeyInput(u32 code, bool down)
+{
+    INPUT input      = {};
+    input.type       = INPUT_KEYBOARD;
+    input.ki.wScan   = WORD(code & 0xFF);
+    input.ki.dwFlags = KEYEVENTF_SCANCODE;
+    if (code >> 8)
+        input.ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
+    if (!down)
+        input.ki.dwFlags |= KEYEVENTF_KEYUP;
+    return input;
+}
+
+struct ModifierKey
+{
+    Modifier mod;
+    u32      scanCode;
+    int      virtualKey;
+};
+constexpr ModifierKey ModifierKeys[] = { { Modifier::Ctrl, 0x1D, VK_CONTROL }, { Modifier::Shift, 0x2A, VK_SHIFT }, { Modifier::Alt, 0x38, VK_MENU } };
+
+u32                   HeldModifiers()
+{
+    u32 held = 0;
+    for (const auto& key : ModifierKeys)
+        if (GetAsyncKeyState(key.virtualKey) & 0x8000)
+            held |= u32(ToUnderlying(key.mod));
+    return held;
+}
+
+// Pressed in order and released in reverse, so a chord goes down and comes up like one typed by hand
+void AppendModifiers(std::vector<INPUT>& inputs, u32 modifiers, bool down)
+{
+    const auto append = [&](const ModifierKey& key)
+    {
+        if (modifiers & u32(ToUnderlying(key.mod)))
+            inputs.push_back(MakeKeyInput(key.scanCode, down));
+    };
+    if (down)
+        std::ranges::for_each(ModifierKeys, append);
+    else
+        std::ranges::for_each(ModifierKeys | std::views::reverse, append);
+}
+
+void Send(std::vector<INPUT>& inputs)
+{
+    if (!inputs.empty())
+        SendInput(UINT(inputs.size()), inputs.data(), sizeof(INPUT));
+}
+} // namespace
+
+PlatformTime Win32Platform::now() const
+{
+    return TimeInMilliseconds();
+}
+
+void Win32Platform::SendKeybind(const KeyChord& keys, std::optional<glm::ivec2> cursorPos)
+{
+    Input::i().SendKeybind(ToKeyCombo(keys), ToPoint(cursorPos));
+}
+
+void Win32Platform::KeyUpActive()
+{
+    Input::i().KeyUpActive();
+}
+
+bool Win32Platform::PressKeybindNow(const KeyChord& keys)
+{
+    // SendInput goes to whichever window has focus, never type into chat or another application
+    if (GetForegroundWindow() != Core::i().gameWindow() || MumbleLink::i().textboxHasFocus())
+        return false;
+
+    // Mouse buttons have no scan code to inject, they go through Input on the next update instead
+    if (!IsKeyboardScanCode(keys.scanCode))
+    {
+        std::lock_guard lock(deferredMutex_);
+        deferredKeybinds_.push_back(ToKeyCombo(keys));
+        return true;
+    }
+
+    const auto         modifiers = ModifierChanges::For(keys.modifiers, HeldModifiers());
+
+    std::vector<INPUT> inputs;
+    AppendModifiers(inputs, modifiers.release, false);
+    AppendModifiers(inputs, modifiers.press, true);
+    inputs.push_back(MakeKeyInput(keys.scanCode, true));
+    Send(inputs);
+
+    pressedKeybinds_.push_back({ keys, modifiers });
+    return true;
+}
+
+void Win32Platform::ReleaseKeybindNow(const KeyChord& keys)
+{
+    // Only what Press sent is released, but whatever has focus by now, so nothing is left held down
+    auto it = std::ranges::find(pressedKeybinds_, keys, &PressedKeybind::keys);
+    if (it == pressedKeybinds_.end())
+        return;
+    const auto modifiers = it->modifiers;
+    pressedKeybinds_.erase(it);
+
+    std::vector<INPUT> inputs;
+    inputs.push_back(MakeKeyInput(keys.scanCode, false));
+    AppendModifiers(inputs, modifiers.press, false);
+    AppendModifiers(inputs, modifiers.release, true);
+    Send(inputs);
+}
+
+void Win32Platform::FlushDeferredKeybinds()
+{
+    std::vector<KeyCombo> keybinds;
+    {
+        std::lock_guard lock(deferredMutex_);
+        keybinds.swap(deferredKeybinds_);
+    }
+
+    for (const auto& ks : keybinds)
+        Input::i().SendKeybind(ks, std::nullopt);
+}
+
+Win32Platform::SubscriptionId Win32Platform::SubscribeMouseMove(MouseMoveHandler handler)
+{
+    const auto id = nextSubscription_++;
+    subscriptions_.emplace(id, Subscription{ false, Input::i().mouseMoveEvent().AddCallback(std::move(handler)) });
+    return id;
+}
+
+Win32Platform::SubscriptionId Win32Platform::SubscribeMouseButton(MouseButtonHandler handler)
+{
+    auto       callback = [handler = std::move(handler)](EventKey ek, bool& rv) { handler(std::uint32_t(ToUnderlying(ek.sc)), ek.down, rv); };
+    const auto id       = nextSubscription_++;
+    subscriptions_.emplace(id, Subscription{ true, Input::i().mouseButtonEvent().AddCallback(std::move(callback)) });
+    return id;
+}
+
+void Win32Platform::Unsubscribe(SubscriptionId id)
+{
+    auto it = subscriptions_.find(id);
+    if (it == subscriptions_.end())
+        return;
+
+    // Input may already be gone during shutdown, taking its callbacks with it
+    Input::f(
+        [&](auto& i)
+        {
+            if (it->second.button)
+                i.mouseButtonEvent().RemoveCallback(std::move(it->second.handle));
+            else
+                i.mouseMoveEvent().RemoveCallback(std::move(it->second.handle));
+        });
+    subscriptions_.erase(it);
+}
+
+std::uint32_t Win32Platform::currentState() const
+{
+    return ToGameConditions(MumbleLink::i().currentState());
+}
+
+bool Win32Platform::gameHasFocus() const
+{
+    return MumbleLink::i().gameHasFocus();
+}
+
+bool Win32Platform::isMapOpen() const
+{
+    return MumbleLink::i().isMapOpen();
+}
+
+bool Win32Platform::isMounted() const
+{
+    return MumbleLink::i().isMounted();
+}
+
+bool Win32Platform::isInWvW() const
+{
+    return MumbleLink::i().isInWvW();
+}
+
+std::uint32_t Win32Platform::uiScale() const
+{
+    return static_cast<std::uint32_t>(MumbleLink::i().uiScale());
+}
+
+glm::vec2 Win32Platform::position() const
+{
+    const auto& io = ImGui::GetIO();
+    return { io.MousePos.x, io.MousePos.y };
+}
+
+glm::vec2 Win32Platform::livePosition() const
+{
+    POINT pt = {};
+    if (!GetCursorPos(&pt) || !ScreenToClient(Core::i().gameWindow(), &pt))
+        return position();
+
+    return { float(pt.x), float(pt.y) };
+}
+
+bool Win32Platform::CenterInWindow()
+{
+    RECT rect = {};
+    if (!GetWindowRect(Core::i().gameWindow(), &rect))
+        return false;
+
+    if (!SetCursorPos((rect.right - rect.left) / 2 + rect.left, (rect.bottom - rect.top) / 2 + rect.top))
+        return false;
+
+    // ImGui only sees the new position next frame, so update it now to keep hover consistent
+    auto& io      = ImGui::GetIO();
+    io.MousePos.x = float(Core::i().screenWidth()) * 0.5f;
+    io.MousePos.y = float(Core::i().screenHeight()) * 0.5f;
+
+    return true;
+}
+
+glm::ivec2 Win32Platform::screenSize() const
+{
+    return { Core::i().screenWidth(), Core::i().screenHeight() };
+}
+
+float Win32Platform::dpiScale() const
+{
+    if (!GFXSettings::i().dpiScaling())
+        return 1.f;
+
+    return float(Core::i().GetDpiForWindow(Core::i().gameWindow())) / 96.f;
+}
+} // namespace GW2Radial
@@ -0,0 +1,183 @@
+#include <ActionChainExecutor.h>
+#include <PlatformTypes.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+
+namespace GW2Radial
+{
+namespace
+{
+using Clock = ActionChainExecutor::Clock;
+using namespace std::chrono_literals;
+
+// Stands in for the platform's input sink, recording when each key went down and up
+class FakeSink
+{
+public:
+    struct Event
+    {
+        int               key;
+        bool              down;
+        Clock::time_point time;
+    };
+
+    // Presses of keys listed here fail, as they do when the game stops taking input
+    std::vector<int> refused;
+
+    void             Append(std::vector<ActionChainExecutor::Step>& steps, int key, std::chrono::milliseconds delayAfter)
+    {
+        ActionChainExecutor::AppendKeybind(steps, [this, key] { return Record(key, true); }, [this, key] { Record(key, false); }, delayAfter);
+    }
+
+    std::vector<Event> events()
+    {
+        std::lock_guard lock(mutex_);
+        return events_;
+    }
+
+private:
+    bool Record(int key, bool down)
+    {
+        std::lock_guard lock(mutex_);
+        events_.push_back({ key, down, Clock::now() });
+        return !down || std::ranges::find(refused, key) == refused.end();
+    }
+
+    std::mutex         mutex_;
+    std::vector<Event> events_;
+};
+
+void WaitFinished(const ActionChainExecutor::Handle& chain)
+{
+    ASSERT_TRUE(chain);
+    const auto timeout = Clock::now() + 5s;
+    while (!chain->finished && Clock::now() < timeout)
+        std::this_thread::sleep_for(1ms);
+    ASSERT_TRUE(chain->finished);
+}
+
+// Every key is held at least KeyHold even when its press runs late, and presses keep to their deadlines without drifting
+TEST(ActionChainExecutor, HoldsKeysAndKeepsDeadlines)
+{
+    constexpr int          Keys = 20;
+    constexpr auto         Gap  = 30ms;
+
+    ActionChainExecutor    executor;
+    FakeSink               sink;
+    std::vector<ActionChainExecutor::Step> steps;
+    for (int key = 0; key < Keys; key++)
+        sink.Append(steps, key, Gap);
+
+    const auto start = Clock::now() + 10ms;
+    const auto chain = executor.Submit(std::move(steps), start);
+    WaitFinished(chain);
+    EXPECT_FALSE(chain->dropped);
+
+    const auto events = sink.events();
+    ASSERT_EQ(events.size(), size_t(Keys) * 2);
+
+    std::vector<double> lateness;
+    for (int key = 0; key < Keys; key++)
+    {
+        const auto& press   = events[size_t(key) * 2];
+        const auto& release = events[size_t(key) * 2 + 1];
+        ASSERT_EQ(press.key, key);
+        ASSERT_TRUE(press.down);
+        ASSERT_EQ(release.key, key);
+        ASSERT_FALSE(release.down);
+
+        EXPECT_GE(release.time - press.time, ActionChainExecutor::KeyHold) << key;
+        EXPECT_GE(press.time, start + Gap * key) << key;
+        lateness.push_back(std::chrono::duration<double, std::milli>(press.time - (start + Gap * key)).count());
+    }
+
+    // Loose bounds, the machine running the tests may be busy; lateness piling up along the chain would blow them all the same
+    std::ranges::sort(lateness);
+    EXPECT_LT(lateness[lateness.size() / 2], 5.0);
+    EXPECT_LT(lateness.back(), 25.0);
+}
+
+TEST(ActionChainExecutor, CancelledChainStillReleasesKey)
+{
+    ActionChainExecutor                    executor;
+    FakeSink                               sink;
+    std::vector<ActionChainExecutor::Step> steps;
+    sink.Append(steps, 1, 0ms);
+    sink.Append(steps, 2, 0ms);
+
+    const auto chain = executor.Submit(std::move(steps));
+    while (sink.events().empty())
+        std::this_thread::sleep_for(100us);
+    ActionChainExecutor::Cancel(chain);
+    WaitFinished(chain);
+
+    const auto events = sink.events();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_TRUE(events[0].down);
+    EXPECT_EQ(events[1].key, 1);
+    EXPECT_FALSE(events[1].down);
+    EXPECT_FALSE(chain->dropped);
+}
+
+// A press the game refuses drops the rest of the chain and says so; keys already down still come up
+TEST(ActionChainExecutor, RefusedPressDropsChain)
+{
+    ActionChainExecutor                    executor;
+    FakeSink                               sink;
+    sink.refused = { 2 };
+    std::vector<ActionChainExecutor::Step> steps;
+    for (int key = 1; key <= 3; key++)
+        sink.Append(steps, key, 0ms);
+
+    const auto chain = executor.Submit(std::move(steps));
+    WaitFinished(chain);
+    EXPECT_TRUE(chain->dropped);
+    EXPECT_TRUE(chain->cancelled);
+
+    const auto events = sink.events();
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[0].key, 1);
+    EXPECT_EQ(events[1].key, 1);
+    EXPECT_FALSE(events[1].down);
+    EXPECT_EQ(events[2].key, 2);
+    EXPECT_TRUE(events[2].down);
+    EXPECT_EQ(events[3].key, 2);
+    EXPECT_FALSE(events[3].down);
+}
+
+TEST(ActionChainExecutor, DelaysCountFromPress)
+{
+    ActionChainExecutor                    executor;
+    FakeSink                               sink;
+    std::vector<ActionChainExecutor::Step> steps;
+    sink.Append(steps, 1, 60ms);
+    sink.Append(steps, 2, 0ms);
+
+    const auto chain = executor.Submit(std::move(steps));
+    WaitFinished(chain);
+
+    const auto events = sink.events();
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_GE(events[2].time - events[0].time, 60ms);
+    EXPECT_LT(events[2].time - events[0].time, 60ms + 25ms);
+}
+
+TEST(ModifierChanges, KeepsOnlyTheChordsModifiers)
+{
+    constexpr std::uint32_t Ctrl = 1, Shift = 2, Alt = 4;
+
+    EXPECT_EQ(ModifierChanges::For(Ctrl, 0).press, Ctrl);
+    EXPECT_EQ(ModifierChanges::For(Ctrl, 0).release, 0u);
+
+    // Already held modifiers of the chord are left alone, the others are released for the key and restored after
+    const auto changes = ModifierChanges::For(Ctrl | Alt, Ctrl | Shift);
+    EXPECT_EQ(changes.press, Alt);
+    EXPECT_EQ(changes.release, Shift);
+
+    EXPECT_EQ(ModifierChanges::For(0, Shift | Alt).release, Shift | Alt);
+    EXPECT_EQ(ModifierChanges::For(Shift, Shift).press, 0u);
+}
+} // namespace
+} // namespace GW2Radial
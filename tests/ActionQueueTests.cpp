@@ -0,0 +1,218 @@
+#include <ActionQueue.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+using Outcome = ActionQueue::Outcome;
+
+// Scripted time and game conditions; every callback the queue makes is logged in order
+class ActionQueueTest : public testing::Test
+{
+protected:
+    ActionQueue::Request Request(std::string name, std::int64_t expiry, std::int64_t sendDelay = 0)
+    {
+        ActionQueue::Request r;
+        r.owner     = this;
+        r.expiry    = expiry;
+        r.sendDelay = sendDelay;
+        r.ready     = [this]
+        {
+            readyCalls++;
+            return ready;
+        };
+        r.send      = [this, name]
+        {
+            log.push_back("send " + name + " @" + std::to_string(now));
+            return false;
+        };
+        r.finished  = [this, name](ActionQueue::Id, Outcome outcome)
+        {
+            static constexpr const char* Names[] = { "sent", "expired", "cancelled" };
+            log.push_back(std::string(Names[size_t(outcome)]) + " " + name + " @" + std::to_string(now));
+        };
+        return r;
+    }
+
+    // Steps the clock one millisecond at a time up to t, as frames would, flagging changed conditions once
+    void RunUntil(std::int64_t t, bool conditionsChanged = false)
+    {
+        for (; now <= t; now++)
+        {
+            queue.Update(now, conditionsChanged);
+            conditionsChanged = false;
+        }
+        now = t;
+    }
+
+    void SetReady(bool value)
+    {
+        ready = value;
+        queue.Update(now, true);
+    }
+
+    ActionQueue              queue;
+    std::int64_t             now        = 0;
+    bool                     ready      = true;
+    int                      readyCalls = 0;
+    std::vector<std::string> log;
+};
+
+TEST_F(ActionQueueTest, SendsOncePredicateHeldForSendDelay)
+{
+    queue.Push(Request("a", 1000, 50), now);
+    queue.Update(now, false);
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(queue.nextDeadline(), 50);
+
+    RunUntil(49);
+    EXPECT_TRUE(log.empty());
+    RunUntil(50);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @50", "sent a @50" }));
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_EQ(queue.nextDeadline(), std::nullopt);
+}
+
+TEST_F(ActionQueueTest, WaitsForNotBefore)
+{
+    auto r      = Request("a", 1000);
+    r.notBefore = 30;
+    queue.Push(std::move(r), now);
+    RunUntil(29);
+    EXPECT_TRUE(log.empty());
+    RunUntil(30);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @30", "sent a @30" }));
+}
+
+// A predicate that never holds is not polled every frame, only when conditions change and at expiry
+TEST_F(ActionQueueTest, ExpiresWithoutPolling)
+{
+    ready = false;
+    queue.Push(Request("a", 500), now);
+    RunUntil(499);
+    EXPECT_EQ(readyCalls, 1);
+    SetReady(false);
+    EXPECT_EQ(readyCalls, 2);
+
+    RunUntil(500);
+    EXPECT_EQ(log, (std::vector<std::string>{ "expired a @500" }));
+    RunUntil(600, true);
+    EXPECT_EQ(log.size(), 1u);
+}
+
+// The send delay restarts whenever the predicate stops holding
+TEST_F(ActionQueueTest, FlappingPredicateRestartsSendDelay)
+{
+    queue.Push(Request("a", 1000, 50), now);
+    RunUntil(40);
+    SetReady(false);
+    RunUntil(60);
+    SetReady(true);
+    RunUntil(90);
+    SetReady(false);
+    SetReady(true);
+    RunUntil(139);
+    EXPECT_TRUE(log.empty());
+    RunUntil(140);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @140", "sent a @140" }));
+}
+
+TEST_F(ActionQueueTest, RetriesUntilSendSucceeds)
+{
+    int  attempts   = 0;
+    auto r          = Request("a", 1000);
+    r.retryInterval = 100;
+    r.send          = [&]
+    {
+        log.push_back("send a @" + std::to_string(now));
+        return ++attempts < 3;
+    };
+    queue.Push(std::move(r), now);
+    RunUntil(300);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @0", "send a @100", "send a @200", "sent a @200" }));
+}
+
+// Retrying past the expiry expires the entry instead
+TEST_F(ActionQueueTest, RetriesStopAtExpiry)
+{
+    auto r          = Request("a", 150);
+    r.retryInterval = 100;
+    r.send          = [&]
+    {
+        log.push_back("send a @" + std::to_string(now));
+        return true;
+    };
+    queue.Push(std::move(r), now);
+    RunUntil(300);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @0", "send a @100", "expired a @150" }));
+}
+
+TEST_F(ActionQueueTest, CancelOwnerCancelsInQueuingOrder)
+{
+    ready = false;
+    queue.Push(Request("a", 1000), now);
+    auto other  = Request("b", 1000);
+    other.owner = &queue;
+    queue.Push(std::move(other), now);
+    queue.Push(Request("c", 1000), now);
+
+    queue.CancelOwner(this);
+    EXPECT_EQ(log, (std::vector<std::string>{ "cancelled a @0", "cancelled c @0" }));
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_FALSE(queue.Cancel(1));
+}
+
+// Entries due at the same time go out in queuing order
+TEST_F(ActionQueueTest, SendsDueEntriesInQueuingOrder)
+{
+    queue.Push(Request("a", 1000, 20), now);
+    queue.Push(Request("b", 1000, 20), now + 10);
+    queue.Push(Request("c", 1000, 20), now);
+    RunUntil(20);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @20", "sent a @20", "send c @20", "sent c @20" }));
+    RunUntil(30);
+    EXPECT_EQ(log.back(), "sent b @30");
+}
+
+// A callback may cancel its own entry and keeps running on its own state afterwards; entries it pushes that are already due go
+// out in the same update
+TEST_F(ActionQueueTest, CallbacksMayChangeQueue)
+{
+    ActionQueue::Id self = 0;
+    auto            r    = Request("a", 1000);
+    r.send               = [this, &self, name = std::string("a")]
+    {
+        log.push_back("send " + name + " @" + std::to_string(now));
+        queue.Push(Request("b", 1000), now);
+        queue.Cancel(self);
+        log.push_back("still " + name);
+        return false;
+    };
+    self = queue.Push(std::move(r), now);
+
+    queue.Update(now, false);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @0", "cancelled a @0", "still a", "send b @0", "sent b @0" }));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+// A cancelled retrying entry is not sent again, a surviving one keeps its send callback
+TEST_F(ActionQueueTest, RetryKeepsSendAcrossCancelOfOthers)
+{
+    ActionQueue::Id other = queue.Push(Request("b", 1000, 500), now);
+    auto            r     = Request("a", 1000);
+    r.retryInterval       = 100;
+    r.send                = [&, name = std::string("a")]
+    {
+        log.push_back("send " + name + " @" + std::to_string(now));
+        queue.Cancel(other);
+        return now < 200;
+    };
+    queue.Push(std::move(r), now);
+    RunUntil(300);
+    EXPECT_EQ(log, (std::vector<std::string>{ "send a @0", "cancelled b @0", "send a @100", "send a @200", "sent a @200" }));
+}
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,139 @@
+#include <AtlasPacker.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace GW2Radial
+{
+namespace
+{
+constexpr uint32_t PageSize = 2048;
+
+bool               Overlap(const AtlasRect& a, const AtlasRect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// Icon-like sizes: mostly square, up to the atlas' largest edge
+std::vector<AtlasSize> RandomSizes(size_t count, uint32_t seed)
+{
+    std::mt19937                            rng(seed);
+    std::uniform_int_distribution<uint32_t> edge(1, 512), stretch(0, 3);
+    std::vector<AtlasSize>                  sizes(count);
+    for (auto& size : sizes)
+    {
+        size.width  = edge(rng);
+        size.height = stretch(rng) == 0 ? edge(rng) : size.width;
+    }
+    return sizes;
+}
+
+// Cells stay inside the page, never overlap and hold their rectangle with at least the padding all around
+void ExpectValidCells(const AtlasPacker& packer, const std::vector<AtlasRect>& rects, uint32_t padding, uint32_t alignment)
+{
+    for (size_t i = 0; i < rects.size(); i++)
+    {
+        const auto cell = packer.Cell(rects[i]);
+        EXPECT_LE(cell.x + cell.width, packer.width()) << i;
+        EXPECT_LE(cell.y + cell.height, packer.height()) << i;
+        EXPECT_EQ(rects[i].x - cell.x, padding) << i;
+        EXPECT_EQ(rects[i].y - cell.y, padding) << i;
+        EXPECT_GE(cell.x + cell.width, rects[i].x + rects[i].width + padding) << i;
+        EXPECT_GE(cell.y + cell.height, rects[i].y + rects[i].height + padding) << i;
+        EXPECT_EQ(cell.x % alignment, 0u) << i;
+        EXPECT_EQ(cell.y % alignment, 0u) << i;
+        EXPECT_EQ(cell.width % alignment, 0u) << i;
+        EXPECT_EQ(cell.height % alignment, 0u) << i;
+
+        for (size_t j = 0; j < i; j++)
+            EXPECT_FALSE(Overlap(cell, packer.Cell(rects[j]))) << i << " and " << j;
+    }
+}
+
+TEST(AtlasPacker, CellsNeverOverlap)
+{
+    AtlasPacker            packer(PageSize, PageSize, 8);
+    std::vector<AtlasRect> rects;
+    for (const auto& size : RandomSizes(200, 1))
+        if (auto rect = packer.Insert(size.width, size.height))
+            rects.push_back(*rect);
+
+    ASSERT_GT(rects.size(), 10u);
+    ExpectValidCells(packer, rects, 8, 1);
+}
+
+// What keeps the atlas' mips apart: every cell starts and ends on a multiple of the alignment
+TEST(AtlasPacker, AlignsCells)
+{
+    for (const uint32_t alignment : { 4u, 16u })
+    {
+        AtlasPacker            packer(PageSize, PageSize, alignment, alignment);
+        std::vector<AtlasRect> rects;
+        for (const auto& size : RandomSizes(200, alignment))
+            if (auto rect = packer.Insert(size.width, size.height))
+                rects.push_back(*rect);
+
+        ASSERT_GT(rects.size(), 10u);
+        ExpectValidCells(packer, rects, alignment, alignment);
+    }
+}
+
+TEST(AtlasPacker, RejectsWhatCannotFit)
+{
+    AtlasPacker packer(64, 64, 4);
+    EXPECT_FALSE(packer.Insert(0, 10));
+    EXPECT_FALSE(packer.Insert(57, 10));
+    EXPECT_TRUE(packer.Insert(56, 56));
+    EXPECT_FALSE(packer.Insert(1, 1));
+    EXPECT_FLOAT_EQ(packer.occupancy(), 1.f);
+
+    packer.Reset();
+    EXPECT_EQ(packer.usedArea(), 0u);
+    EXPECT_TRUE(packer.Insert(1, 1));
+}
+
+TEST(AtlasPacker, FillsRowsBottomLeft)
+{
+    AtlasPacker packer(64, 64);
+    const auto  a = packer.Insert(32, 16);
+    const auto  b = packer.Insert(32, 16);
+    const auto  c = packer.Insert(32, 8);
+    ASSERT_TRUE(a && b && c);
+    EXPECT_EQ(a->x, 0u);
+    EXPECT_EQ(a->y, 0u);
+    EXPECT_EQ(b->x, 32u);
+    EXPECT_EQ(b->y, 0u);
+    EXPECT_EQ(c->y, 16u);
+}
+
+TEST(PackIntoPages, PlacesEverythingThatFits)
+{
+    auto sizes = RandomSizes(200, 7);
+    sizes.push_back({ PageSize, 1 });
+
+    const auto placements = PackIntoPages(sizes, PageSize, PageSize, 16, 16);
+    ASSERT_EQ(placements.size(), sizes.size());
+    EXPECT_FALSE(placements.back().has_value());
+
+    uint32_t pageCount = 0;
+    for (size_t i = 0; i + 1 < placements.size(); i++)
+    {
+        ASSERT_TRUE(placements[i].has_value()) << i;
+        EXPECT_EQ(placements[i]->rect.width, sizes[i].width);
+        EXPECT_EQ(placements[i]->rect.height, sizes[i].height);
+        pageCount = std::max(pageCount, placements[i]->page + 1);
+    }
+
+    // Cells only depend on the packer's padding and alignment, so any packer of the same shape checks a page's placements
+    for (uint32_t page = 0; page < pageCount; page++)
+    {
+        AtlasPacker            packer(PageSize, PageSize, 16, 16);
+        std::vector<AtlasRect> rects;
+        for (size_t i = 0; i + 1 < placements.size(); i++)
+            if (placements[i]->page == page)
+                rects.push_back(placements[i]->rect);
+        ExpectValidCells(packer, rects, 16, 16);
+    }
+}
+} // namespace
+} // namespace GW2Radial
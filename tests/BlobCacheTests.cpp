@@ -0,0 +1,216 @@
+#include <BlobCache.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <numeric>
+
+namespace GW2Radial
+{
+namespace
+{
+std::vector<uint8_t> Pixels(uint32_t width, uint32_t height, uint8_t seed)
+{
+    std::vector<uint8_t> pixels(size_t(width) * height * 4);
+    std::iota(pixels.begin(), pixels.end(), seed);
+    return pixels;
+}
+
+// Three blobs of sizes that do not align to 16 bytes on their own, added out of key order
+std::vector<uint8_t> Sample()
+{
+    BlobCache::Writer writer;
+    writer.Add(30, 3, 1, BlobCache::Format::RGBA8, Pixels(3, 1, 30));
+    writer.Add(10, 2, 2, BlobCache::Format::RGBA8, Pixels(2, 2, 10));
+    writer.Add(20, 5, 3, BlobCache::Format::RGBA8, Pixels(5, 3, 20));
+    return writer.Serialize();
+}
+
+void ExpectBlob(const BlobCache::Reader& reader, uint64_t key, uint32_t width, uint32_t height)
+{
+    const auto blob = reader.Find(key);
+    ASSERT_TRUE(blob) << key;
+    EXPECT_EQ(blob->width, width);
+    EXPECT_EQ(blob->height, height);
+    EXPECT_EQ(blob->format, BlobCache::Format::RGBA8);
+    const auto expected = Pixels(width, height, uint8_t(key));
+    ASSERT_EQ(blob->data.size(), expected.size());
+    EXPECT_TRUE(std::equal(blob->data.begin(), blob->data.end(), expected.begin())) << key;
+}
+
+class BlobCacheFile : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dir_ = std::filesystem::temp_directory_path() / (std::string("gw2radial_blobcache_") + testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    std::filesystem::path dir_;
+};
+
+TEST(BlobCache, RoundTrips)
+{
+    const auto        bytes = Sample();
+    BlobCache::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes));
+
+    EXPECT_EQ(reader.size(), 3u);
+    EXPECT_EQ(reader.keys(), (std::vector<uint64_t>{ 10, 20, 30 }));
+    ExpectBlob(reader, 10, 2, 2);
+    ExpectBlob(reader, 20, 5, 3);
+    ExpectBlob(reader, 30, 3, 1);
+    EXPECT_FALSE(reader.Find(15));
+    EXPECT_FALSE(reader.Find(40));
+}
+
+TEST(BlobCache, LaterAddReplacesKey)
+{
+    BlobCache::Writer writer;
+    writer.Add(10, 1, 1, BlobCache::Format::RGBA8, Pixels(1, 1, 99));
+    writer.Add(10, 2, 2, BlobCache::Format::RGBA8, Pixels(2, 2, 10));
+    const auto        bytes = writer.Serialize();
+
+    BlobCache::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes));
+    EXPECT_EQ(reader.size(), 1u);
+    ExpectBlob(reader, 10, 2, 2);
+}
+
+TEST(BlobCache, EmptyCacheRoundTrips)
+{
+    const auto        bytes = BlobCache::Writer{}.Serialize();
+    BlobCache::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes));
+    EXPECT_EQ(reader.size(), 0u);
+}
+
+// A corrupted blob is reported missing on its own, everything else stays readable
+TEST(BlobCache, CorruptBlobIsMissing)
+{
+    auto              bytes = Sample();
+    BlobCache::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes));
+    const auto offset = size_t(reader.Find(20)->data.data() - bytes.data());
+
+    bytes[offset + 7] ^= 0x40;
+    ASSERT_TRUE(reader.Open(bytes));
+    EXPECT_FALSE(reader.Find(20));
+    ExpectBlob(reader, 10, 2, 2);
+    ExpectBlob(reader, 30, 3, 1);
+}
+
+// Any damage to the header or the table rejects the whole file
+TEST(BlobCache, CorruptHeaderOrTableIsRejected)
+{
+    const auto        good = Sample();
+    BlobCache::Reader reader;
+
+    auto              badMagic = good;
+    badMagic[0] ^= 1;
+    EXPECT_FALSE(reader.Open(badMagic));
+
+    auto badVersion = good;
+    badVersion[4] ^= 1;
+    EXPECT_FALSE(reader.Open(badVersion));
+
+    // The table sits at the end of the file
+    auto badTable = good;
+    badTable[badTable.size() - 20] ^= 1;
+    EXPECT_FALSE(reader.Open(badTable));
+    EXPECT_EQ(reader.size(), 0u);
+
+    for (size_t size : { size_t(0), size_t(16), good.size() / 2, good.size() - 1 })
+        EXPECT_FALSE(reader.Open(std::span(good).first(size))) << size;
+
+    // Every byte that matters is covered by a check: the header's fields other than its reserved one, the blobs and the table.
+    // Only the padding between blobs may change unnoticed.
+    ASSERT_TRUE(reader.Open(good));
+    std::vector<bool> covered(good.size(), false);
+    for (size_t i = 0; i < 32; i++)
+        covered[i] = i < 12 || i >= 16;
+    for (uint64_t key : reader.keys())
+    {
+        const auto data  = reader.Find(key)->data;
+        const auto begin = size_t(data.data() - good.data());
+        std::fill(covered.begin() + begin, covered.begin() + begin + data.size(), true);
+    }
+    std::fill(covered.end() - 3 * 48, covered.end(), true);
+
+    for (size_t i = 0; i < good.size(); i++)
+    {
+        auto bytes = good;
+        bytes[i] ^= 0x80;
+        bool intact = reader.Open(bytes);
+        for (uint64_t key : { 10, 20, 30 })
+            intact = intact && reader.Find(key).has_value();
+        EXPECT_NE(intact, bool(covered[i])) << i;
+    }
+}
+
+TEST_F(BlobCacheFile, WriteFileRoundTrips)
+{
+    const auto path  = dir_ / "cache.bin";
+    const auto bytes = Sample();
+    ASSERT_TRUE(BlobCache::Writer::WriteFile(path, bytes));
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "cache.bin.tmp"));
+
+    BlobCache::MappedFile file(path);
+    BlobCache::Reader     reader;
+    ASSERT_TRUE(reader.Open(file.data()));
+    ExpectBlob(reader, 10, 2, 2);
+    ExpectBlob(reader, 20, 5, 3);
+    ExpectBlob(reader, 30, 3, 1);
+}
+
+TEST_F(BlobCacheFile, WriteFileReplacesExisting)
+{
+    const auto path = dir_ / "cache.bin";
+    {
+        std::ofstream old(path, std::ios::binary);
+        old << "an older, longer file that must be replaced entirely, not overwritten in place";
+    }
+
+    BlobCache::Writer writer;
+    writer.Add(10, 2, 2, BlobCache::Format::RGBA8, Pixels(2, 2, 10));
+    const auto bytes = writer.Serialize();
+    ASSERT_TRUE(BlobCache::Writer::WriteFile(path, bytes));
+    EXPECT_EQ(std::filesystem::file_size(path), bytes.size());
+
+    BlobCache::MappedFile file(path);
+    BlobCache::Reader     reader;
+    ASSERT_TRUE(reader.Open(file.data()));
+    ExpectBlob(reader, 10, 2, 2);
+}
+
+// A failed write reports it and leaves the previous file alone
+TEST_F(BlobCacheFile, FailedWriteKeepsPrevious)
+{
+    const auto path = dir_ / "cache.bin";
+    ASSERT_TRUE(BlobCache::Writer::WriteFile(path, Sample()));
+
+    // A directory in the temporary file's place makes the write fail before the rename
+    std::filesystem::create_directory(dir_ / "cache.bin.tmp");
+    EXPECT_FALSE(BlobCache::Writer::WriteFile(path, BlobCache::Writer{}.Serialize()));
+
+    BlobCache::MappedFile file(path);
+    BlobCache::Reader     reader;
+    ASSERT_TRUE(reader.Open(file.data()));
+    EXPECT_EQ(reader.size(), 3u);
+}
+
+TEST_F(BlobCacheFile, MissingFileMapsEmpty)
+{
+    BlobCache::MappedFile file(dir_ / "missing.bin");
+    EXPECT_TRUE(file.data().empty());
+}
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,476 @@
+#include <ChatSender.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+using namespace std::chrono_literals;
+using Clock = ChatSender::Clock;
+
+// A chat box that opens and closes as soon as it is told to, unless feedback is switched off; records every action in order
+class FakeChat : public ChatSender::Sink
+{
+public:
+    bool                     open     = false;
+    bool                     feedback = true;
+    ChatSender::HeldInputs   held;
+    std::vector<std::string> calls;
+    std::function<void()>    onOpenChat;
+
+    bool                     chatOpen() override
+    {
+        return open;
+    }
+
+    ChatSender::HeldInputs CaptureHeld() override
+    {
+        calls.push_back("capture");
+        return held;
+    }
+
+    void Release(const ChatSender::HeldInputs& h) override
+    {
+        calls.push_back(h.w ? "release w" : "release");
+    }
+
+    void OpenChat(bool broadcast) override
+    {
+        calls.push_back(broadcast ? "open broadcast" : "open");
+        open = open || feedback;
+        if (onOpenChat)
+            onOpenChat();
+    }
+
+    void Type(const std::wstring& text) override
+    {
+        calls.push_back("type " + std::string(text.begin(), text.end()));
+    }
+
+    void Submit() override
+    {
+        calls.push_back("submit");
+        open = open && !feedback;
+    }
+
+    void Restore(const ChatSender::HeldInputs& h) override
+    {
+        calls.push_back(h.w ? "restore w" : "restore");
+    }
+};
+
+const Clock::time_point T0 = Clock::time_point{} + 1h;
+
+TEST(ChatSender, RunsStagesInOrder)
+{
+    FakeChat   chat;
+    chat.held.w = true;
+    ChatSender sender(chat);
+    ASSERT_TRUE(sender.Enqueue({ L"hello", false }));
+
+    // Held keys are released first, chat opens once beforeOpen has passed
+    EXPECT_EQ(sender.Advance(T0), T0 + 15ms);
+    EXPECT_EQ(chat.calls, (std::vector<std::string>{ "capture", "release w" }));
+    EXPECT_EQ(sender.Advance(T0 + 10ms), T0 + 15ms);
+
+    // The chat box reports open right away, so typing follows immediately and submitting after beforeSubmit
+    EXPECT_EQ(sender.Advance(T0 + 15ms), T0 + 65ms);
+    EXPECT_EQ(chat.calls, (std::vector<std::string>{ "capture", "release w", "open", "type hello" }));
+
+    EXPECT_EQ(sender.Advance(T0 + 65ms), std::nullopt);
+    EXPECT_EQ(chat.calls, (std::vector<std::string>{ "capture", "release w", "open", "type hello", "submit", "restore w" }));
+    EXPECT_TRUE(sender.idle());
+    EXPECT_EQ(sender.latencies()[size_t(ChatSender::FeedbackStep::OpenChat)].count(), 1u);
+    EXPECT_EQ(sender.latencies()[size_t(ChatSender::FeedbackStep::CloseChat)].count(), 1u);
+}
+
+TEST(ChatSender, BroadcastOpensWithItsOwnStep)
+{
+    FakeChat   chat;
+    ChatSender sender(chat);
+    sender.Enqueue({ L"squad", true });
+    sender.Advance(T0);
+    sender.Advance(T0 + 15ms);
+    sender.Advance(T0 + 65ms);
+    EXPECT_EQ(chat.calls, (std::vector<std::string>{ "capture", "release", "open broadcast", "type squad", "submit", "restore" }));
+    EXPECT_EQ(sender.latencies()[size_t(ChatSender::FeedbackStep::OpenBroadcast)].count(), 1u);
+}
+
+// Without feedback, each wait polls until its bound runs out and goes on anyway, recording a timeout
+TEST(ChatSender, WaitsForFeedbackUpToBound)
+{
+    FakeChat   chat;
+    chat.feedback = false;
+    ChatSender sender(chat);
+    sender.Enqueue({ L"hi", false });
+    sender.Advance(T0);
+
+    EXPECT_EQ(sender.Advance(T0 + 15ms), T0 + 16ms);
+    EXPECT_EQ(sender.Advance(T0 + 40ms), T0 + 41ms);
+    EXPECT_EQ(chat.calls.back(), "open");
+
+    EXPECT_EQ(sender.Advance(T0 + 65ms), T0 + 115ms);
+    EXPECT_EQ(chat.calls.back(), "type hi");
+    EXPECT_EQ(sender.latencies()[size_t(ChatSender::FeedbackStep::OpenChat)].timeouts(), 1u);
+
+    // Chat reports open until submitting closes it, which never comes either; restoring waits out restoreChat
+    chat.open = true;
+    EXPECT_EQ(sender.Advance(T0 + 115ms), T0 + 116ms);
+    EXPECT_EQ(chat.calls.back(), "submit");
+    EXPECT_EQ(sender.Advance(T0 + 175ms), std::nullopt);
+    EXPECT_EQ(chat.calls.back(), "restore");
+}
+
+TEST(ChatSender, SkipsMessageWhenChatAlreadyOpen)
+{
+    FakeChat   chat;
+    chat.open = true;
+    ChatSender sender(chat);
+    sender.Enqueue({ L"hi", false });
+    EXPECT_EQ(sender.Advance(T0), std::nullopt);
+    EXPECT_TRUE(chat.calls.empty());
+    EXPECT_TRUE(sender.idle());
+}
+
+TEST(ChatSender, RejectsDuplicatesAndOverflow)
+{
+    FakeChat   chat;
+    ChatSender sender(chat);
+    EXPECT_TRUE(sender.Enqueue({ L"a", false }));
+    EXPECT_FALSE(sender.Enqueue({ L"a", false }));
+    EXPECT_TRUE(sender.Enqueue({ L"a", true }));
+    for (size_t i = sender.pendingCount(); i < ChatSender::Capacity; i++)
+        EXPECT_TRUE(sender.Enqueue({ std::to_wstring(i), false }));
+    EXPECT_FALSE(sender.Enqueue({ L"overflow", false }));
+    EXPECT_EQ(sender.pendingCount(), ChatSender::Capacity);
+}
+
+// Messages never interleave: the next one only starts once the previous has restored held inputs
+TEST(ChatSender, SendsQueuedMessagesOneAfterAnother)
+{
+    FakeChat   chat;
+    ChatSender sender(chat);
+    sender.Enqueue({ L"one", false });
+    sender.Enqueue({ L"two", false });
+
+    auto now = T0;
+    while (auto next = sender.Advance(now))
+        now = *next;
+    EXPECT_EQ(chat.calls, (std::vector<std::string>{ "capture", "release", "open", "type one", "submit", "restore", "capture", "release", "open", "type two", "submit",
+                                                     "restore" }));
+}
+
+TEST(ChatSender, CancelAbandonsWithoutRestoring)
+{
+    FakeChat   chat;
+    ChatSender sender(chat);
+    sender.Enqueue({ L"one", false });
+    sender.Enqueue({ L"two", false });
+    sender.Advance(T0);
+    sender.Advance(T0 + 15ms);
+
+    sender.Cancel();
+    EXPECT_TRUE(sender.idle());
+    EXPECT_EQ(sender.Advance(T0 + 100ms), std::nullopt);
+    EXPECT_EQ(chat.calls.back(), "type one");
+}
+
+// The worker lets Cancel in during sink calls; the message it was on must stop right there
+TEST(ChatSender, CancelDuringSinkCallStopsMessage)
+{
+    FakeChat   chat;
+    ChatSender sender(chat);
+    chat.onOpenChat = [&] { sender.Cancel(); };
+    sender.Enqueue({ L"one", false });
+    sender.Advance(T0);
+
+    EXPECT_EQ(sender.Advance(T0 + 15ms), std::nullopt);
+    EXPECT_EQ(chat.calls.back(), "open");
+    EXPECT_TRUE(sender.idle());
+
+    // Messages enqueued after the cancel go out as usual
+    chat.onOpenChat = {};
+    chat.open       = false;
+    sender.Enqueue({ L"two", false });
+    sender.Advance(T0 + 20ms);
+    sender.Advance(T0 + 35ms);
+    EXPECT_EQ(chat.calls.back(), "type two");
+}
+
+// Fast feedback shrinks a wait's bound to twice the slowest recent latency, but never below MinBound
+TEST(ChatSender, BoundAdaptsToFeedback)
+{
+    FakeChat   chat;
+    ChatSender sender(chat);
+    auto       now = T0;
+    for (size_t i = 0; i < ChatSender::StepLatency::MinSamples; i++)
+    {
+        sender.Enqueue({ std::to_wstring(i), false });
+        while (auto next = sender.Advance(now))
+            now = *next;
+    }
+
+    chat.feedback = false;
+    sender.Enqueue({ L"late", false });
+    now = *sender.Advance(now);
+    sender.Advance(now);
+    const auto opened = now;
+    EXPECT_EQ(chat.calls.back(), "open");
+
+    sender.Advance(opened + ChatSender::StepLatency::MinBound - 1ms);
+    EXPECT_EQ(chat.calls.back(), "open");
+    sender.Advance(opened + ChatSender::StepLatency::MinBound);
+    EXPECT_EQ(chat.calls.back(), "type late");
+}
+
+TEST(ChatSenderStepLatency, BoundFollowsRecentSamples)
+{
+    ChatSender::StepLatency latency;
+    EXPECT_EQ(latency.Bound(50ms), 50ms);
+    for (size_t i = 0; i < ChatSender::StepLatency::MinSamples; i++)
+        latency.Record(12ms, false);
+    EXPECT_EQ(latency.Bound(50ms), 24ms);
+    EXPECT_EQ(latency.Bound(20ms), 20ms);
+
+    // A timeout is recorded at the bound it ran into, doubling the next one back up towards the configured value
+    latency.Record(24ms, true);
+    EXPECT_EQ(latency.Bound(50ms), 48ms);
+    EXPECT_EQ(latency.timeouts(), 1u);
+    EXPECT_EQ(latency.max(), 24ms);
+}
+
+// The chat box as the add-on sees it through MumbleLink: it opens and closes some time after the keystrokes, and textboxHasFocus
+// only reflects that as of the game's last MumbleLink update. Reads the scripted time the test advances the sender with.
+class SimulatedMumbleChat : public ChatSender::Sink
+{
+public:
+    SimulatedMumbleChat(const Clock::time_point& now, Clock::duration openLatency, Clock::duration closeLatency)
+        : now_(now)
+        , openLatency_(openLatency)
+        , closeLatency_(closeLatency)
+    {
+    }
+
+    // How often the game updates MumbleLink; zero for every millisecond
+    Clock::duration                                        updateInterval{};
+    // While false, MumbleLink is frozen at whatever it last reported
+    bool                                                   live = true;
+    std::vector<std::pair<std::string, Clock::time_point>> calls;
+
+    bool                                                   chatOpen() override
+    {
+        if (live)
+        {
+            auto published = now_;
+            if (updateInterval.count() > 0)
+                published -= (now_.time_since_epoch() % updateInterval);
+            reported_ = openedAt_ && *openedAt_ <= published && !(closedAt_ && *closedAt_ <= published);
+        }
+        return reported_;
+    }
+
+    ChatSender::HeldInputs CaptureHeld() override
+    {
+        return {};
+    }
+
+    void Release(const ChatSender::HeldInputs&) override
+    {
+    }
+
+    void OpenChat(bool) override
+    {
+        calls.emplace_back("open", now_);
+        openedAt_ = now_ + openLatency_;
+        closedAt_.reset();
+    }
+
+    void Type(const std::wstring&) override
+    {
+        calls.emplace_back("type", now_);
+    }
+
+    void Submit() override
+    {
+        calls.emplace_back("submit", now_);
+        closedAt_ = now_ + closeLatency_;
+    }
+
+    void Restore(const ChatSender::HeldInputs&) override
+    {
+        calls.emplace_back("restore", now_);
+    }
+
+    // Time from opening chat to typing into it, for the most recent message
+    [[nodiscard]] Clock::duration OpenWait() const
+    {
+        Clock::time_point opened;
+        for (const auto& [call, at] : calls)
+        {
+            if (call == "open")
+                opened = at;
+            else if (call == "type")
+                return at - opened;
+        }
+        return {};
+    }
+
+private:
+    const Clock::time_point&         now_;
+    Clock::duration                  openLatency_, closeLatency_;
+    std::optional<Clock::time_point> openedAt_, closedAt_;
+    bool                             reported_ = false;
+};
+
+// Sends one message to completion, stepping the scripted clock to each deadline; returns how long it took
+Clock::duration SendOne(ChatSender& sender, SimulatedMumbleChat& chat, Clock::time_point& now, std::wstring text)
+{
+    chat.calls.clear();
+    const auto start = now;
+    sender.Enqueue({ std::move(text), false });
+    while (auto next = sender.Advance(now))
+        now = *next;
+    return now - start;
+}
+
+// With feedback, a message takes beforeOpen + open latency + beforeSubmit + close latency rather than the sum of the bounds
+TEST(ChatSenderFeedback, FollowsChatBoxLatency)
+{
+    Clock::time_point   now = T0;
+    SimulatedMumbleChat chat(now, 5ms, 7ms);
+    ChatSender          sender(chat);
+
+    EXPECT_EQ(SendOne(sender, chat, now, L"hi"), 15ms + 5ms + 50ms + 7ms);
+    EXPECT_EQ(chat.OpenWait(), 5ms);
+    EXPECT_EQ(chat.calls.back().first, "restore");
+
+    const auto& open = sender.latencies()[size_t(ChatSender::FeedbackStep::OpenChat)];
+    EXPECT_EQ(open.count(), 1u);
+    EXPECT_EQ(open.max(), 5ms);
+    EXPECT_EQ(open.timeouts(), 0u);
+    EXPECT_EQ(sender.latencies()[size_t(ChatSender::FeedbackStep::CloseChat)].max(), 7ms);
+}
+
+// MumbleLink only updates once per game frame, so feedback arrives on the first update after the chat box changed
+TEST(ChatSenderFeedback, WaitsForNextMumbleUpdate)
+{
+    Clock::time_point   now = T0;
+    SimulatedMumbleChat chat(now, 5ms, 7ms);
+    chat.updateInterval = 16ms;
+    ChatSender sender(chat);
+
+    SendOne(sender, chat, now, L"hi");
+    const auto opened = chat.calls.front().second;
+    const auto typed  = opened + chat.OpenWait();
+    EXPECT_GE(typed, opened + 5ms);
+    EXPECT_LT(typed, opened + 5ms + 16ms);
+    EXPECT_EQ(typed.time_since_epoch() % 16ms, Clock::duration::zero());
+}
+
+// Once MumbleLink stops updating, every wait times out and the bound doubles back up to the configured one
+TEST(ChatSenderFeedback, BoundRecoversWhenFeedbackStops)
+{
+    Clock::time_point   now = T0;
+    SimulatedMumbleChat chat(now, 10ms, 10ms);
+    ChatSender          sender(chat);
+    for (size_t i = 0; i < ChatSender::StepLatency::MinSamples; i++)
+        SendOne(sender, chat, now, std::to_wstring(i));
+    EXPECT_EQ(chat.OpenWait(), 10ms);
+
+    chat.live = false;
+    std::vector<Clock::duration> waits;
+    for (int i = 0; i < 4; i++)
+    {
+        SendOne(sender, chat, now, L"late" + std::to_wstring(i));
+        waits.push_back(chat.OpenWait());
+    }
+    EXPECT_EQ(waits, (std::vector<Clock::duration>{ 20ms, 40ms, 50ms, 50ms }));
+    EXPECT_EQ(sender.latencies()[size_t(ChatSender::FeedbackStep::OpenChat)].timeouts(), 4u);
+
+    // Feedback is followed again as soon as it returns, once the chat box left open by the last message has closed
+    chat.live = true;
+    now += 100ms;
+    EXPECT_EQ(SendOne(sender, chat, now, L"back"), 15ms + 10ms + 50ms + 10ms);
+}
+
+// Blocks inside OpenChat until the test lets it go, standing in for a SendInput that takes its time
+class BlockingChat : public ChatSender::Sink
+{
+public:
+    std::promise<void>       entered;
+    std::promise<void>       proceed;
+    std::atomic<int>         typed = 0;
+
+    bool                     chatOpen() override
+    {
+        return opened_;
+    }
+
+    ChatSender::HeldInputs CaptureHeld() override
+    {
+        return {};
+    }
+
+    void Release(const ChatSender::HeldInputs&) override
+    {
+    }
+
+    void OpenChat(bool) override
+    {
+        entered.set_value();
+        proceed.get_future().wait();
+        opened_ = true;
+    }
+
+    void Type(const std::wstring&) override
+    {
+        typed++;
+    }
+
+    void Submit() override
+    {
+        opened_ = false;
+    }
+
+    void Restore(const ChatSender::HeldInputs&) override
+    {
+    }
+
+private:
+    std::atomic<bool> opened_ = false;
+};
+
+TEST(ChatSendWorker, SinkCallsDoNotBlockCallers)
+{
+    BlockingChat   chat;
+    ChatSendWorker worker(chat, ChatSender::Timing{});
+    ASSERT_TRUE(worker.Enqueue({ L"one", false }));
+    ASSERT_EQ(chat.entered.get_future().wait_for(5s), std::future_status::ready);
+
+    // The worker is inside OpenChat; handing over and cancelling must not wait for it
+    auto enqueued = std::async(std::launch::async, [&] { return worker.Enqueue({ L"two", false }); });
+    EXPECT_EQ(enqueued.wait_for(1s), std::future_status::ready);
+    auto cancelled = std::async(std::launch::async, [&] { worker.Cancel(); });
+    EXPECT_EQ(cancelled.wait_for(1s), std::future_status::ready);
+    auto latencies = std::async(std::launch::async, [&] { return worker.latencies(); });
+    EXPECT_EQ(latencies.wait_for(1s), std::future_status::ready);
+
+    chat.proceed.set_value();
+    enqueued.wait();
+    cancelled.wait();
+    latencies.wait();
+
+    // Cancelled while opening chat, so neither message is typed
+    std::this_thread::sleep_for(150ms);
+    EXPECT_EQ(chat.typed, 0);
+}
+} // namespace
+} // namespace GW2Radial
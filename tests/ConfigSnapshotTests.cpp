@@ -0,0 +1,225 @@
+#include <ConfigSnapshot.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <list>
+#include <map>
+
+namespace GW2Radial
+{
+namespace
+{
+using namespace std::chrono_literals;
+
+constexpr uint64_t SourceSize = 1234;
+
+std::string Section(uint32_t option)
+{
+    return "Section" + std::to_string(option / 25);
+}
+
+std::string Key(uint32_t option)
+{
+    return "option_" + std::to_string(option);
+}
+
+std::string Value(uint32_t option)
+{
+    return "value " + std::to_string(option * 7);
+}
+
+std::vector<uint8_t> Sample(uint32_t options)
+{
+    ConfigSnapshot::Writer writer;
+    for (uint32_t i = 0; i < options; i++)
+        writer.Add(Section(i), Key(i), Value(i));
+    return writer.Serialize(SourceSize);
+}
+
+// Just enough of CSimpleIniA's interface for AddAll
+class FakeIni
+{
+public:
+    struct Entry
+    {
+        const char* pItem;
+    };
+    using TNamesDepend = std::list<Entry>;
+
+    void Set(std::string section, std::string key, std::string value)
+    {
+        sections_[std::move(section)][std::move(key)] = std::move(value);
+    }
+
+    void GetAllSections(TNamesDepend& names) const
+    {
+        names.clear();
+        for (const auto& [section, keys] : sections_)
+            names.push_back({ section.c_str() });
+    }
+
+    void GetAllKeys(const char* section, TNamesDepend& names) const
+    {
+        names.clear();
+        for (const auto& [key, value] : sections_.at(section))
+            names.push_back({ key.c_str() });
+    }
+
+    const char* GetValue(const char* section, const char* key, const char* defaultValue) const
+    {
+        const auto& keys = sections_.at(section);
+        const auto  it   = keys.find(key);
+        return it == keys.end() ? defaultValue : it->second.c_str();
+    }
+
+private:
+    std::map<std::string, std::map<std::string, std::string>> sections_;
+};
+
+TEST(ConfigSnapshot, RoundTripsThousandOptions)
+{
+    const auto             bytes = Sample(1000);
+    ConfigSnapshot::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes, SourceSize));
+
+    EXPECT_EQ(reader.size(), 1000u);
+    for (uint32_t i = 0; i < 1000; i++)
+        EXPECT_EQ(reader.Find(Section(i), Key(i)), Value(i)) << i;
+    EXPECT_FALSE(reader.Find(Section(0), Key(1000)));
+    // Only the key's own section holds it
+    EXPECT_FALSE(reader.Find(Section(100), Key(0)));
+}
+
+TEST(ConfigSnapshot, LaterAddReplacesValue)
+{
+    ConfigSnapshot::Writer writer;
+    writer.Add("General", "value", "1");
+    writer.Add("General", "other", "2");
+    writer.Add("General", "value", "3");
+    const auto             bytes = writer.Serialize(SourceSize);
+
+    ConfigSnapshot::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes, SourceSize));
+    EXPECT_EQ(reader.size(), 2u);
+    EXPECT_EQ(reader.Find("General", "value"), "3");
+    EXPECT_EQ(reader.Find("General", "other"), "2");
+}
+
+TEST(ConfigSnapshot, EmptyValuesAndSnapshots)
+{
+    ConfigSnapshot::Writer writer;
+    ConfigSnapshot::Reader reader;
+    const auto             empty = writer.Serialize(SourceSize);
+    ASSERT_TRUE(reader.Open(empty, SourceSize));
+    EXPECT_EQ(reader.size(), 0u);
+    EXPECT_FALSE(reader.Find("General", "value"));
+
+    writer.Add("General", "value", "");
+    const auto bytes = writer.Serialize(SourceSize);
+    ASSERT_TRUE(reader.Open(bytes, SourceSize));
+    EXPECT_EQ(reader.Find("General", "value"), "");
+}
+
+TEST(ConfigSnapshot, AddsEveryIniValue)
+{
+    FakeIni ini;
+    ini.Set("Core", "first_message_shown_v1", "true");
+    ini.Set("Chat Commands", "wave_message", "/wave");
+    ini.Set("Chat Commands", "wave_label", "Wave");
+
+    ConfigSnapshot::Writer writer;
+    ConfigSnapshot::AddAll(writer, ini);
+    const auto             bytes = writer.Serialize(SourceSize);
+
+    ConfigSnapshot::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes, SourceSize));
+    EXPECT_EQ(reader.size(), 3u);
+    EXPECT_EQ(reader.Find("Core", "first_message_shown_v1"), "true");
+    EXPECT_EQ(reader.Find("Chat Commands", "wave_message"), "/wave");
+    EXPECT_EQ(reader.Find("Chat Commands", "wave_label"), "Wave");
+}
+
+TEST(ConfigSnapshot, RejectsCorruption)
+{
+    const auto             bytes = Sample(100);
+    ConfigSnapshot::Reader reader;
+
+    auto                   flipped = bytes;
+    flipped[flipped.size() / 2] ^= 0x40;
+    EXPECT_FALSE(reader.Open(flipped, SourceSize));
+    EXPECT_EQ(reader.size(), 0u);
+    EXPECT_FALSE(reader.Find(Section(0), Key(0)));
+
+    const std::vector truncated(bytes.begin(), bytes.end() - 1);
+    EXPECT_FALSE(reader.Open(truncated, SourceSize));
+    EXPECT_FALSE(reader.Open(std::span(bytes).first(16), SourceSize));
+    EXPECT_FALSE(reader.Open({}, SourceSize));
+
+    auto badMagic = bytes;
+    badMagic[0] ^= 1;
+    EXPECT_FALSE(reader.Open(badMagic, SourceSize));
+}
+
+TEST(ConfigSnapshot, RejectsOtherVersion)
+{
+    auto           bytes   = Sample(10);
+    const uint32_t version = ConfigSnapshot::Version + 1;
+    std::memcpy(bytes.data() + sizeof(uint32_t), &version, sizeof(version));
+
+    ConfigSnapshot::Reader reader;
+    EXPECT_FALSE(reader.Open(bytes, SourceSize));
+}
+
+// The INI was saved since, by something other than the write-behind store
+TEST(ConfigSnapshot, RejectsOtherSourceSize)
+{
+    const auto             bytes = Sample(10);
+    ConfigSnapshot::Reader reader;
+    EXPECT_FALSE(reader.Open(bytes, SourceSize + 1));
+    EXPECT_TRUE(reader.Open(bytes, SourceSize));
+}
+
+TEST(ConfigSnapshot, FailedOpenClosesPrevious)
+{
+    const auto             bytes = Sample(10);
+    ConfigSnapshot::Reader reader;
+    ASSERT_TRUE(reader.Open(bytes, SourceSize));
+    EXPECT_FALSE(reader.Open(bytes, SourceSize + 1));
+    EXPECT_EQ(reader.size(), 0u);
+    EXPECT_FALSE(reader.Find(Section(0), Key(0)));
+}
+
+TEST(ConfigSnapshot, PathReplacesExtension)
+{
+    EXPECT_EQ(ConfigSnapshot::PathFor(std::filesystem::path("addons") / "config.ini"), std::filesystem::path("addons") / "config.snapshot");
+}
+
+TEST(ConfigSnapshot, CurrentOnlyIfNotOlderThanIni)
+{
+    const auto dir = std::filesystem::temp_directory_path() / "gw2radial_config_snapshot_current";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto ini      = dir / "config.ini";
+    const auto snapshot = ConfigSnapshot::PathFor(ini);
+
+    std::ofstream(ini) << "[General]\nvalue=1\n";
+    EXPECT_FALSE(ConfigSnapshot::IsCurrent(ini));
+
+    std::ofstream(snapshot) << "snapshot";
+    const auto iniTime = std::filesystem::last_write_time(ini);
+    std::filesystem::last_write_time(snapshot, iniTime);
+    EXPECT_TRUE(ConfigSnapshot::IsCurrent(ini));
+
+    // Edited by hand after the snapshot was written
+    std::filesystem::last_write_time(ini, iniTime + 1s);
+    EXPECT_FALSE(ConfigSnapshot::IsCurrent(ini));
+
+    std::filesystem::remove(ini);
+    EXPECT_FALSE(ConfigSnapshot::IsCurrent(ini));
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+} // namespace
+} // namespace GW2Radial
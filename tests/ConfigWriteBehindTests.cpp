@@ -0,0 +1,239 @@
+#include <ConfigSnapshot.h>
+#include <ConfigWriteBehind.h>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace GW2Radial
+{
+namespace
+{
+using namespace std::chrono_literals;
+using Clock = ConfigWriteBehind::Clock;
+
+constexpr auto Idle = 50ms;
+
+class ConfigWriteBehindTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dir_  = std::filesystem::temp_directory_path() / (std::string("gw2radial_config_") + testing::UnitTest::GetInstance()->current_test_info()->name());
+        path_ = dir_ / "config.ini";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    std::string Read() const
+    {
+        std::ifstream     file(path_, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    // Stands in for GW2Common's synchronous INIConfigurationFile::Save
+    void SaveDirectly(const std::string& contents) const
+    {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        file << contents;
+    }
+
+    ConfigWriteBehind::Serializer Serializer()
+    {
+        return [this] { return std::optional(config_); };
+    }
+
+    // The whole file as the one value, so the snapshot can be checked against what was written
+    static ConfigWriteBehind::Snapshotter Snapshotter()
+    {
+        return [](const std::string& contents)
+        {
+            ConfigSnapshot::Writer writer;
+            writer.Add("File", "contents", contents);
+            return writer.Serialize(contents.size());
+        };
+    }
+
+    std::filesystem::path dir_, path_;
+    std::string           config_ = "[General]\nvalue=1\n";
+};
+
+TEST_F(ConfigWriteBehindTest, CoalescesBurstIntoOneWrite)
+{
+    ConfigWriteBehind store(path_, Serializer(), Idle);
+    const auto        start = Clock::now();
+    for (int i = 0; i < 20; i++)
+    {
+        config_ = "[General]\nvalue=" + std::to_string(i) + "\n";
+        store.MarkDirty("General", start + 10ms * i);
+        store.Update(start + 10ms * i);
+    }
+    EXPECT_TRUE(store.dirty());
+    EXPECT_FALSE(std::filesystem::exists(path_));
+
+    store.Update(start + 10ms * 19 + Idle);
+    EXPECT_FALSE(store.dirty());
+    EXPECT_TRUE(store.Flush());
+    EXPECT_EQ(store.writeCount(), 1u);
+    EXPECT_EQ(Read(), "[General]\nvalue=19\n");
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "config.ini.tmp"));
+}
+
+// A synchronous save between taking the contents and putting them in place holds everything they did; it must not be replaced
+TEST_F(ConfigWriteBehindTest, KeepsNewerDirectSave)
+{
+    ConfigWriteBehind store(path_, Serializer(), Idle);
+    const auto        start = Clock::now();
+    store.MarkDirty("General", start);
+    store.Update(start + Idle);
+
+    SaveDirectly("[General]\nvalue=1\nother=2\n");
+    EXPECT_TRUE(store.Flush());
+    EXPECT_EQ(Read(), "[General]\nvalue=1\nother=2\n");
+    EXPECT_EQ(store.writeCount(), 0u);
+    EXPECT_EQ(store.staleCount(), 1u);
+}
+
+TEST_F(ConfigWriteBehindTest, ReplacesOlderDirectSave)
+{
+    SaveDirectly("[General]\nvalue=0\n");
+
+    ConfigWriteBehind store(path_, Serializer(), Idle);
+    store.MarkDirty("General");
+    EXPECT_TRUE(store.Flush());
+    EXPECT_EQ(Read(), config_);
+    EXPECT_EQ(store.writeCount(), 1u);
+}
+
+// Contents taken while an earlier write was still in flight are not mistaken for stale once that write lands
+TEST_F(ConfigWriteBehindTest, BackToBackWritesAreNotStale)
+{
+    ConfigWriteBehind store(path_, Serializer(), Idle);
+    const auto        start = Clock::now();
+    for (int i = 0; i < 5; i++)
+    {
+        config_ = "[General]\nvalue=" + std::to_string(i) + "\n";
+        store.MarkDirty("General", start + Idle * 2 * i);
+        store.Update(start + Idle * (2 * i + 1));
+    }
+    EXPECT_TRUE(store.Flush());
+    EXPECT_EQ(Read(), "[General]\nvalue=4\n");
+    EXPECT_EQ(store.staleCount(), 0u);
+    EXPECT_GE(store.writeCount(), 1u);
+}
+
+TEST_F(ConfigWriteBehindTest, WritesSnapshotOfFile)
+{
+    ConfigWriteBehind store(path_, Serializer(), Idle, Snapshotter());
+    store.MarkDirty("General");
+    EXPECT_TRUE(store.Flush());
+
+    const auto snapshotPath = ConfigSnapshot::PathFor(path_);
+    ASSERT_TRUE(std::filesystem::exists(snapshotPath));
+    EXPECT_TRUE(ConfigSnapshot::IsCurrent(path_));
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "config.snapshot.tmp"));
+
+    std::ifstream              file(snapshotPath, std::ios::binary);
+    const std::vector<uint8_t> bytes(std::istreambuf_iterator<char>(file), {});
+    ConfigSnapshot::Reader     reader;
+    ASSERT_TRUE(reader.Open(bytes, std::filesystem::file_size(path_)));
+    EXPECT_EQ(reader.Find("File", "contents"), config_);
+}
+
+// Contents dropped as stale take their snapshot with them, the direct save is newer than any snapshot left from before
+TEST_F(ConfigWriteBehindTest, StaleWriteLeavesNoSnapshot)
+{
+    ConfigWriteBehind store(path_, Serializer(), Idle, Snapshotter());
+    const auto        start = Clock::now();
+    store.MarkDirty("General", start);
+    store.Update(start + Idle);
+
+    SaveDirectly("[General]\nvalue=1\nother=2\n");
+    EXPECT_TRUE(store.Flush());
+    EXPECT_EQ(store.staleCount(), 1u);
+    EXPECT_FALSE(std::filesystem::exists(ConfigSnapshot::PathFor(path_)));
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "config.snapshot.tmp"));
+}
+
+TEST_F(ConfigWriteBehindTest, RetriesFailedWrite)
+{
+    const auto        path = dir_ / "missing" / "config.ini";
+    ConfigWriteBehind store(path, Serializer(), Idle);
+    store.MarkDirty("General");
+    EXPECT_FALSE(store.Flush());
+    EXPECT_TRUE(store.lastWriteFailed());
+    EXPECT_TRUE(store.dirty());
+
+    std::filesystem::create_directories(path.parent_path());
+    store.Update(Clock::now() + Idle);
+    EXPECT_TRUE(store.Flush());
+    EXPECT_FALSE(store.lastWriteFailed());
+    EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+TEST_F(ConfigWriteBehindTest, EmptyPathNeverWrites)
+{
+    ConfigWriteBehind store({}, Serializer(), Idle);
+    store.MarkDirty("General");
+    EXPECT_FALSE(store.dirty());
+    EXPECT_TRUE(store.Flush());
+    EXPECT_EQ(store.writeCount(), 0u);
+}
+
+// A writer killed at any point leaves either no file or one complete version of it, never a mix or a truncated one
+TEST_F(ConfigWriteBehindTest, KilledWriterLeavesCompleteFile)
+{
+#ifdef _WIN32
+    GTEST_SKIP() << "Needs fork";
+#else
+    const std::string  first(200'000, 'a'), second(300'000, 'b');
+    std::mt19937       rng(1234);
+    std::uniform_int_distribution<int> delay(0, 3000);
+
+    for (int run = 0; run < 40; run++)
+    {
+        const pid_t child = fork();
+        ASSERT_GE(child, 0);
+        if (child == 0)
+        {
+            std::string       contents = first;
+            ConfigWriteBehind store(path_, [&] { return std::optional(contents); }, Idle);
+            for (;;)
+            {
+                contents = contents == first ? second : first;
+                store.MarkDirty("General");
+                store.Flush();
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(delay(rng)));
+        kill(child, SIGKILL);
+        int status = 0;
+        waitpid(child, &status, 0);
+
+        if (std::filesystem::exists(path_))
+        {
+            const auto contents = Read();
+            EXPECT_TRUE(contents == first || contents == second) << "run " << run << ", " << contents.size() << " bytes";
+        }
+    }
+#endif
+}
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,233 @@
+#include <CustomWheelLoader.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <thread>
+
+namespace GW2Radial
+{
+namespace
+{
+using namespace std::chrono_literals;
+
+std::vector<std::uint8_t> Bytes(std::string_view text)
+{
+    return { text.begin(), text.end() };
+}
+
+constexpr std::string_view TwoElements = "[General]\n"
+                                         "nickname = Elements\n"
+                                         "display_name = Two Elements\n"
+                                         "\n"
+                                         "[Fire]\n"
+                                         "color = 255, 0, 0\n"
+                                         "icon = fire.png\n"
+                                         "shadow_strength = 0.5\n"
+                                         "premultiply_alpha = false\n"
+                                         "\n"
+                                         "[Air]\n"
+                                         "name = Lightning\n"
+                                         "color = 255, 128\n"
+                                         "props = 3\n";
+
+TEST(ParseCustomWheel, ReadsElementsInFileOrder)
+{
+    const auto settings = ParseCustomWheel("custom/elements/config.ini", Bytes(TwoElements));
+    ASSERT_TRUE(settings.error.empty());
+    EXPECT_EQ(settings.nickname, "Elements");
+    EXPECT_EQ(settings.displayName, "Two Elements");
+    ASSERT_EQ(settings.elements.size(), 2u);
+
+    const auto& fire = settings.elements[0];
+    EXPECT_EQ(fire.nickname, "elements_fire");
+    EXPECT_EQ(fire.category, "Elements");
+    EXPECT_EQ(fire.name, "Fire");
+    EXPECT_EQ(fire.color, glm::vec4(1.f, 0.f, 0.f, 1.f));
+    EXPECT_FLOAT_EQ(fire.shadow, 0.5f);
+    EXPECT_FLOAT_EQ(fire.colorize, 1.f);
+    EXPECT_FALSE(fire.premultiply);
+    EXPECT_EQ(fire.iconPath, std::filesystem::path("custom/elements") / "fire.png");
+    EXPECT_EQ(fire.props, ConditionalProperties(static_cast<std::uint32_t>(ConditionalProperties::UsableAll) | static_cast<std::uint32_t>(ConditionalProperties::VisibleAll)));
+
+    // Missing channels are zero, the icon is optional
+    const auto& air = settings.elements[1];
+    EXPECT_EQ(air.name, "Lightning");
+    EXPECT_NEAR(air.color.y, 128.f / 255.f, 1e-6f);
+    EXPECT_EQ(air.color.z, 0.f);
+    EXPECT_TRUE(air.iconPath.empty());
+    EXPECT_EQ(air.props, ConditionalProperties(3));
+}
+
+TEST(ParseCustomWheel, RejectsIncompleteConfigs)
+{
+    EXPECT_FALSE(ParseCustomWheel("a/config.ini", Bytes("[Fire]\ncolor = 1, 2, 3\n")).error.empty());
+    EXPECT_FALSE(ParseCustomWheel("a/config.ini", Bytes("[General]\nnickname = a\n")).error.empty());
+    EXPECT_FALSE(ParseCustomWheel("a/config.ini", Bytes("[General]\ndisplay_name = A\n")).error.empty());
+}
+
+// Wheels on disk, plus a zip archive only the stubbed file functions see into; icons are decoded by a stub that stands in for
+// WIC and the device, recording what it was asked to decode
+class CustomWheelLoaderTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dir_ = std::filesystem::temp_directory_path() / (std::string("gw2radial_wheels_") + testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    void Write(const std::filesystem::path& relative, std::string_view contents)
+    {
+        const auto path = dir_ / relative;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary) << contents;
+    }
+
+    CustomWheelFiles Files()
+    {
+        return {
+            .exists     = [this](const std::filesystem::path& path) { return zipped_.contains(path) || std::filesystem::exists(path); },
+            .read       = [this](const std::filesystem::path& path)
+            {
+                if (auto it = zipped_.find(path); it != zipped_.end())
+                    return Bytes(it->second);
+                std::ifstream file(path, std::ios::binary);
+                return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), {});
+            },
+            .zipFolders = [this](const std::filesystem::path& archive)
+            {
+                std::vector<std::filesystem::path> folders;
+                for (const auto& [path, contents] : zipped_)
+                    if (path.parent_path().parent_path() == archive && std::ranges::find(folders, path.parent_path()) == folders.end())
+                        folders.push_back(path.parent_path());
+                return folders;
+            },
+        };
+    }
+
+    CustomIconDecoder Decoder()
+    {
+        return [this](const std::filesystem::path& path, std::span<const std::uint8_t> data, std::wstring& error)
+        {
+            std::lock_guard lock(decodedMutex_);
+            decoded_.push_back(path.filename().string());
+            if (data.size() < 4)
+            {
+                error = L"too small";
+                return CustomIconData{};
+            }
+            return CustomIconData{ std::uint32_t(data.size()), 1, { data.begin(), data.end() }, {} };
+        };
+    }
+
+    std::vector<CustomWheelSettings> Load(CustomWheelLoader::ContentHashes known = {})
+    {
+        CustomWheelLoader loader(Files(), Decoder());
+        loader.Start(dir_, std::move(known));
+        const auto timeout = std::chrono::steady_clock::now() + 10s;
+        while (std::chrono::steady_clock::now() < timeout)
+        {
+            if (auto results = loader.TakeResults())
+                return std::move(*results);
+            std::this_thread::sleep_for(1ms);
+        }
+        ADD_FAILURE() << "Loading timed out";
+        return {};
+    }
+
+    std::vector<std::string> Decoded()
+    {
+        std::lock_guard lock(decodedMutex_);
+        auto            decoded = decoded_;
+        std::ranges::sort(decoded);
+        return decoded;
+    }
+
+    std::filesystem::path                        dir_;
+    std::map<std::filesystem::path, std::string> zipped_;
+    std::mutex                                   decodedMutex_;
+    std::vector<std::string>                     decoded_;
+};
+
+TEST_F(CustomWheelLoaderTest, LoadsFoldersAndArchives)
+{
+    Write("a/config.ini", "[General]\nnickname = a\ndisplay_name = A\n[One]\nicon = one.png\n[Two]\nicon = missing.png\n");
+    Write("a/one.png", "pixels");
+    Write("b/config.ini", "not an ini");
+    Write("ignored.txt", "");
+    Write("pack.zip", "");
+    zipped_[dir_ / "pack.zip" / "c" / "config.ini"] = "[General]\nnickname = c\ndisplay_name = C\n[Three]\nicon = three.png\n";
+    zipped_[dir_ / "pack.zip" / "c" / "three.png"]  = "abc";
+
+    const auto wheels = Load();
+    ASSERT_EQ(wheels.size(), 3u);
+
+    const auto& a = wheels[0];
+    EXPECT_TRUE(a.error.empty());
+    EXPECT_EQ(a.elements[0].icon.width, 6u);
+    EXPECT_TRUE(a.elements[1].icon.empty());
+    ASSERT_EQ(a.warnings.size(), 1u);
+    EXPECT_NE(a.warnings[0].find(L"file not found"), std::wstring::npos);
+
+    EXPECT_FALSE(wheels[1].error.empty());
+
+    // Decoding errors only cost the icon
+    const auto& c = wheels[2];
+    EXPECT_EQ(c.nickname, "c");
+    EXPECT_TRUE(c.elements[0].icon.empty());
+    EXPECT_EQ(c.warnings, std::vector<std::wstring>{ L"too small" });
+
+    EXPECT_EQ(Decoded(), (std::vector<std::string>{ "one.png", "three.png" }));
+}
+
+// Wheels hashing the same as last time are flagged unchanged and none of their icons are decoded
+TEST_F(CustomWheelLoaderTest, SkipsUnchangedWheels)
+{
+    Write("a/config.ini", "[General]\nnickname = a\ndisplay_name = A\n[One]\nicon = one.png\n");
+    Write("a/one.png", "first");
+    Write("b/config.ini", "[General]\nnickname = b\ndisplay_name = B\n[Two]\nicon = two.png\n");
+    Write("b/two.png", "second");
+
+    CustomWheelLoader::ContentHashes known;
+    for (const auto& wheel : Load())
+        known[wheel.configPath] = wheel.contentHash;
+    decoded_.clear();
+
+    auto wheels = Load(known);
+    ASSERT_EQ(wheels.size(), 2u);
+    EXPECT_TRUE(wheels[0].unchanged);
+    EXPECT_TRUE(wheels[1].unchanged);
+    EXPECT_TRUE(Decoded().empty());
+
+    Write("b/two.png", "changed");
+    wheels = Load(known);
+    EXPECT_TRUE(wheels[0].unchanged);
+    EXPECT_FALSE(wheels[1].unchanged);
+    EXPECT_NE(wheels[1].contentHash, known[wheels[1].configPath]);
+    EXPECT_EQ(Decoded(), std::vector<std::string>{ "two.png" });
+}
+
+TEST_F(CustomWheelLoaderTest, MissingFolderLoadsNothing)
+{
+    CustomWheelLoader loader(Files(), Decoder());
+    loader.Start(dir_ / "missing");
+    const auto timeout = std::chrono::steady_clock::now() + 10s;
+    std::optional<std::vector<CustomWheelSettings>> results;
+    while (!results && std::chrono::steady_clock::now() < timeout)
+        results = loader.TakeResults();
+    ASSERT_TRUE(results);
+    EXPECT_TRUE(results->empty());
+    EXPECT_FALSE(loader.TakeResults());
+}
+} // namespace
+} // namespace GW2Radial
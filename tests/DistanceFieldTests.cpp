@@ -0,0 +1,180 @@
+#include <DistanceField.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+
+namespace GW2Radial
+{
+namespace
+{
+struct Image
+{
+    uint32_t             width = 0, height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Goldens are binary PGMs so they open in any image viewer. Set GW2RADIAL_UPDATE_GOLDENS to rewrite them from the current output.
+std::filesystem::path GoldenPath(const std::string& name)
+{
+    return std::filesystem::path(GW2RADIAL_TEST_DATA_DIR) / (name + ".pgm");
+}
+
+std::optional<Image> ReadPgm(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string   magic;
+    Image         image;
+    int           maxValue = 0;
+    if (!(file >> magic >> image.width >> image.height >> maxValue) || magic != "P5" || maxValue != 255)
+        return std::nullopt;
+    file.get();
+
+    image.pixels.resize(size_t(image.width) * image.height);
+    if (!file.read(reinterpret_cast<char*>(image.pixels.data()), std::streamsize(image.pixels.size())))
+        return std::nullopt;
+    return image;
+}
+
+void WritePgm(const std::filesystem::path& path, const Image& image)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "P5\n" << image.width << " " << image.height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(image.pixels.data()), std::streamsize(image.pixels.size()));
+}
+
+// Encoded values may drift by one step between compilers' float rounding, anything more is a change in behavior
+void ExpectMatchesGolden(const std::string& name, const Image& actual)
+{
+    const auto path = GoldenPath(name);
+    if (std::getenv("GW2RADIAL_UPDATE_GOLDENS"))
+        WritePgm(path, actual);
+
+    const auto golden = ReadPgm(path);
+    ASSERT_TRUE(golden) << path;
+    ASSERT_EQ(golden->width, actual.width);
+    ASSERT_EQ(golden->height, actual.height);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < actual.pixels.size(); i++)
+        mismatches += std::abs(int(actual.pixels[i]) - int(golden->pixels[i])) > 1;
+    EXPECT_EQ(mismatches, 0u) << name;
+}
+
+// Coverage of a disc, antialiased by 4x4 supersampling
+Image Disc(uint32_t size, float radius)
+{
+    Image image{ size, size, std::vector<uint8_t>(size_t(size) * size) };
+    for (uint32_t y = 0; y < size; y++)
+        for (uint32_t x = 0; x < size; x++)
+        {
+            int inside = 0;
+            for (int sy = 0; sy < 4; sy++)
+                for (int sx = 0; sx < 4; sx++)
+                {
+                    const float px = float(x) + (float(sx) + 0.5f) / 4.f - float(size) / 2.f;
+                    const float py = float(y) + (float(sy) + 0.5f) / 4.f - float(size) / 2.f;
+                    inside += px * px + py * py <= radius * radius;
+                }
+            image.pixels[size_t(y) * size + x] = uint8_t(std::lround(float(inside) * 255.f / 16.f));
+        }
+    return image;
+}
+
+// A hard-edged ring with a bar through it, roughly the shape of a glyph
+Image Glyph()
+{
+    Image image{ 48, 32, std::vector<uint8_t>(48 * 32) };
+    for (uint32_t y = 0; y < image.height; y++)
+        for (uint32_t x = 0; x < image.width; x++)
+        {
+            const bool ring                  = x >= 8 && x < 40 && y >= 4 && y < 28 && !(x >= 14 && x < 34 && y >= 10 && y < 22);
+            const bool bar                   = y >= 15 && y < 17;
+            image.pixels[size_t(y) * 48 + x] = ring || bar ? 255 : 0;
+        }
+    return image;
+}
+
+Image Generate(const Image& coverage, float spread, uint32_t factor)
+{
+    return { coverage.width / factor, coverage.height / factor, DistanceField::Generate(coverage.pixels, coverage.width, coverage.height, spread, factor) };
+}
+
+TEST(DistanceField, DiscMatchesGolden)
+{
+    ExpectMatchesGolden("distance_field_disc", Generate(Disc(64, 20.f), 8.f, 1));
+}
+
+TEST(DistanceField, DownsampledDiscMatchesGolden)
+{
+    ExpectMatchesGolden("distance_field_disc_half", Generate(Disc(64, 20.f), 8.f, 2));
+}
+
+TEST(DistanceField, GlyphMatchesGolden)
+{
+    ExpectMatchesGolden("distance_field_glyph", Generate(Glyph(), 4.f, 1));
+}
+
+// Independent of the goldens: decoding the field must put the disc's edge where it analytically is
+TEST(DistanceField, DiscDistancesAreAccurate)
+{
+    constexpr float Spread = 8.f, Radius = 20.f;
+    for (uint32_t factor : { 1u, 2u })
+    {
+        const auto field = Generate(Disc(64, Radius), Spread, factor);
+        double     sum   = 0.0;
+        float      worst = 0.f;
+        size_t     count = 0;
+        for (uint32_t y = 0; y < field.height; y++)
+            for (uint32_t x = 0; x < field.width; x++)
+            {
+                // Texel centre in source pixels, relative to the disc's centre
+                const float cx       = (float(x) + 0.5f) * float(factor) - 32.f;
+                const float cy       = (float(y) + 0.5f) * float(factor) - 32.f;
+                const float expected = std::sqrt(cx * cx + cy * cy) - Radius;
+                if (std::abs(expected) >= Spread - 1.f)
+                    continue;
+
+                const float decoded = (0.5f - float(field.pixels[size_t(y) * field.width + x]) / 255.f) * 2.f * Spread;
+                const float error   = std::abs(decoded - expected);
+                sum += error;
+                worst = std::max(worst, error);
+                count++;
+            }
+
+        ASSERT_GT(count, 0u);
+        EXPECT_LT(sum / double(count), 0.35) << factor;
+        EXPECT_LT(worst, 1.f) << factor;
+    }
+}
+
+TEST(DistanceField, UniformMasksSaturate)
+{
+    const std::vector<uint8_t> empty(16 * 16, 0), full(16 * 16, 255);
+    for (uint8_t v : DistanceField::Generate(empty, 16, 16, 2.f))
+        EXPECT_EQ(v, 0);
+    for (uint8_t v : DistanceField::Generate(full, 16, 16, 2.f))
+        EXPECT_EQ(v, 255);
+}
+
+TEST(DistanceField, RejectsInvalidInput)
+{
+    const std::vector<uint8_t> coverage(8 * 8, 0);
+    EXPECT_TRUE(DistanceField::Generate(std::span(coverage).first(10), 8, 8, 2.f).empty());
+    EXPECT_TRUE(DistanceField::Generate(coverage, 8, 8, 2.f, 16).empty());
+    EXPECT_EQ(DistanceField::Generate(coverage, 8, 8, 2.f, 3).size(), 4u);
+}
+
+TEST(DistanceField, EncodesEdgeAtHalf)
+{
+    EXPECT_EQ(DistanceField::Encode(0.f, 4.f), 128);
+    EXPECT_EQ(DistanceField::Encode(-4.f, 4.f), 255);
+    EXPECT_EQ(DistanceField::Encode(4.f, 4.f), 0);
+    EXPECT_GT(DistanceField::Encode(-1.f, 4.f), DistanceField::Encode(1.f, 4.f));
+}
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,116 @@
+#include <ElementConditions.h>
+#include <gtest/gtest.h>
+
+namespace GW2Radial
+{
+namespace
+{
+constexpr std::uint32_t PropsCount = 1024; // every combination of the ten Visible*/Usable* flags
+
+bool                    Has(std::uint32_t props, ConditionalProperties p)
+{
+    return (props & static_cast<std::uint32_t>(p)) != 0;
+}
+
+// The branch chains IsUsable and IsVisible were before conditions were compiled to masks
+bool ReferenceAllowed(std::uint32_t conditions, std::uint32_t props, bool usable)
+{
+    using enum ConditionalProperties;
+    if (conditions == GameCondition::None && !Has(props, usable ? UsableDefault : VisibleDefault))
+        return false;
+    if ((conditions & GameCondition::InWvW) && !Has(props, usable ? UsableWvW : VisibleWvW))
+        return false;
+    if ((conditions & GameCondition::InCombat) && !Has(props, usable ? UsableInCombat : VisibleInCombat))
+        return false;
+    if ((conditions & GameCondition::Underwater) && !Has(props, usable ? UsableUnderwater : VisibleUnderwater))
+        return false;
+    if ((conditions & GameCondition::OnWater) && !Has(props, usable ? UsableOnWater : VisibleOnWater))
+        return false;
+    return true;
+}
+
+// How WheelElement combined its customBehavior lambda with props before gates were compiled
+bool ReferenceElement(bool lambda, bool precheck, bool bound, bool allowedByProps)
+{
+    if (precheck)
+        return lambda && bound && allowedByProps;
+    return lambda || (bound && allowedByProps);
+}
+
+TEST(ElementConditions, MasksMatchBranchChains)
+{
+    for (std::uint32_t conditions = 0; conditions <= GameCondition::All; conditions++)
+        for (std::uint32_t props = 0; props < PropsCount; props++)
+        {
+            const auto cp  = ConditionalProperties(props);
+            const auto key = StateKey(conditions);
+            EXPECT_EQ((key & ~UsableStates(cp)) == 0, ReferenceAllowed(conditions, props, true)) << conditions << " " << props;
+            EXPECT_EQ((key & ~VisibleStates(cp)) == 0, ReferenceAllowed(conditions, props, false)) << conditions << " " << props;
+        }
+}
+
+TEST(ElementConditions, GatesMatchCustomBehavior)
+{
+    for (std::uint32_t conditions = 0; conditions <= GameCondition::All; conditions++)
+        for (std::uint32_t props = 0; props < PropsCount; props++)
+            for (bool bound : { false, true })
+                for (bool passes : { false, true })
+                {
+                    const auto allowed = UsableStates(ConditionalProperties(props));
+                    const bool byProps = ReferenceAllowed(conditions, props, true);
+                    const auto key     = StateKey(conditions);
+                    EXPECT_EQ(EvaluateElement(allowed, key, bound, GateMode::None, passes), bound && byProps);
+                    EXPECT_EQ(EvaluateElement(allowed, key, bound, GateMode::Override, passes), ReferenceElement(passes, false, bound, byProps));
+                    EXPECT_EQ(EvaluateElement(allowed, key, bound, GateMode::Precheck, passes), ReferenceElement(passes, true, bound, byProps));
+                }
+}
+
+// MountWheel's cancel and force elements, against the lambdas they replaced. Both clear their props, as customBehavior does.
+TEST(ElementConditions, MountGatesMatchLambdas)
+{
+    for (std::uint32_t inputs = 0; inputs < 32; inputs++)
+    {
+        const bool    queuing = inputs & 1, showCancel = inputs & 2, showForce = inputs & 4, queued = inputs & 8, forceable = inputs & 16;
+        // Only a queued mount can be a forceable one
+        if (forceable && !queued)
+            continue;
+
+        std::uint64_t word = 0;
+        word |= queuing ? MountGate::QueuingEnabledBit : 0;
+        word |= showCancel ? MountGate::ShowCancelBit : 0;
+        word |= showForce ? MountGate::ShowForceBit : 0;
+        word |= queued ? MountGate::InputQueuedBit : 0;
+        word |= forceable ? MountGate::ForceableMountQueuedBit : 0;
+
+        const bool cancelLambda = queuing && showCancel && queued;
+        const bool forceLambda  = queuing && showForce && forceable;
+        const auto none         = UsableStates(ConditionalProperties::None);
+        for (std::uint32_t conditions = 0; conditions <= GameCondition::All; conditions++)
+            for (bool bound : { false, true })
+            {
+                const auto key = StateKey(conditions);
+                EXPECT_EQ(EvaluateElement(none, key, bound, MountGate::Cancel.mode, MountGate::Cancel.passes(word)), ReferenceElement(cancelLambda, false, bound, false));
+                EXPECT_EQ(EvaluateElement(none, key, bound, MountGate::Force.mode, MountGate::Force.passes(word)), ReferenceElement(forceLambda, false, bound, false));
+            }
+    }
+}
+
+// TemplateWheel (a combo has a keybind) and ChatWheel (a command is enabled with a message) gate each slot as a precheck
+TEST(ElementConditions, SlotGatesMatchLambdas)
+{
+    constexpr std::size_t Slots = 8;
+    const auto            cp    = ConditionalProperties(std::uint32_t(ConditionalProperties::UsableDefault) | std::uint32_t(ConditionalProperties::UsableInCombat));
+    for (std::uint64_t word = 0; word < (1u << Slots); word++)
+        for (std::size_t slot = 0; slot < Slots; slot++)
+        {
+            const ElementGate gate{ GateMode::Precheck, SlotBit(slot) };
+            const bool        lambda = (word >> slot) & 1;
+            for (std::uint32_t conditions = 0; conditions <= GameCondition::All; conditions++)
+            {
+                const bool byProps = ReferenceAllowed(conditions, std::uint32_t(cp), true);
+                EXPECT_EQ(EvaluateElement(UsableStates(cp), StateKey(conditions), true, gate.mode, gate.passes(word)), ReferenceElement(lambda, true, true, byProps));
+            }
+        }
+}
+} // namespace
+} // namespace GW2Radial
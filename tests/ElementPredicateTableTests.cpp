@@ -0,0 +1,88 @@
+#include <ElementPredicateTable.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+// Elements spread over every props value, gate mode and a few gate bits, so every table path is exercised
+std::vector<ElementConditions> RandomElements(size_t count, std::uint32_t seed)
+{
+    std::mt19937                   rng(seed);
+    std::vector<ElementConditions> elements(count);
+    for (auto& e : elements)
+    {
+        const auto props = ConditionalProperties(rng() % 1024);
+        e.visibleStates  = VisibleStates(props);
+        e.usableStates   = UsableStates(props);
+        e.bound          = rng() % 4 != 0;
+        e.gate           = { GateMode(rng() % 3), rng() % 8 };
+    }
+    return elements;
+}
+
+void ExpectMatchesPerElement(const std::vector<ElementConditions>& elements)
+{
+    ElementPredicateTable table;
+    table.Compile(elements);
+    ASSERT_TRUE(table.valid());
+
+    for (std::uint32_t conditions = 0; conditions <= GameCondition::All; conditions++)
+        for (std::uint64_t word = 0; word < 8; word++)
+        {
+            const auto visible = table.Visible(conditions, word);
+            const auto usable  = table.Usable(conditions, word);
+            const auto key     = StateKey(conditions);
+            for (size_t i = 0; i < elements.size(); i++)
+            {
+                const auto& e = elements[i];
+                EXPECT_EQ(visible.test(i), EvaluateElement(e.visibleStates, key, e.bound, e.gate.mode, e.gate.passes(word))) << i;
+                EXPECT_EQ(usable.test(i), EvaluateElement(e.usableStates, key, e.bound, e.gate.mode, e.gate.passes(word))) << i;
+                EXPECT_EQ(table.bound().test(i), e.bound);
+            }
+            for (size_t i = elements.size(); i < ElementPredicateTable::Capacity; i++)
+                EXPECT_FALSE(visible.test(i) || usable.test(i));
+        }
+}
+
+TEST(ElementPredicateTable, MatchesPerElementEvaluation)
+{
+    for (size_t count : { 0, 1, 4, 16, 64, 127, 128 })
+        ExpectMatchesPerElement(RandomElements(count, std::uint32_t(count)));
+}
+
+TEST(ElementPredicateTable, StateIndexSeparatesDefaultState)
+{
+    EXPECT_EQ(ElementPredicateTable::StateIndex(GameCondition::None), 0u);
+    for (std::uint32_t conditions = 1; conditions <= GameCondition::All; conditions++)
+    {
+        EXPECT_NE(ElementPredicateTable::StateIndex(conditions), 0u);
+        EXPECT_LT(ElementPredicateTable::StateIndex(conditions), ElementPredicateTable::StateCount);
+    }
+}
+
+// The gate result memo must follow the state word
+TEST(ElementPredicateTable, GatesFollowStateWord)
+{
+    ElementConditions gated;
+    gated.gate = { GateMode::Override, 0b10 };
+
+    ElementPredicateTable table;
+    table.Compile(std::vector{ gated });
+    EXPECT_FALSE(table.Usable(GameCondition::None, 0b01).test(0));
+    EXPECT_TRUE(table.Usable(GameCondition::None, 0b11).test(0));
+    EXPECT_FALSE(table.Usable(GameCondition::None, 0b01).test(0));
+}
+
+TEST(ElementPredicateTable, FirstSet)
+{
+    ElementPredicateTable::Mask mask;
+    EXPECT_EQ(ElementPredicateTable::FirstSet(mask), mask.size());
+    mask.set(70);
+    mask.set(100);
+    EXPECT_EQ(ElementPredicateTable::FirstSet(mask), 70u);
+}
+} // namespace
+} // namespace GW2Radial
@@ -0,0 +1,276 @@
+#include <ElementPredicateTable.h>
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <new>
+#include <numeric>
+#include <vector>
+
+// Counts every allocation the test binary makes while a test asks for it. This replaces the global allocation functions, so
+// the file is built into a test binary of its own, and every form is replaced so array and aligned allocations are still
+// paired with the matching deallocation.
+namespace
+{
+std::atomic<bool>        countAllocations = false;
+std::atomic<std::size_t> allocationCount  = 0;
+
+void* Allocate(std::size_t size, std::size_t alignment = 0) noexcept
+{
+    if (countAllocations)
+        allocationCount++;
+    size = size ? size : 1;
+#ifdef _WIN32
+    return alignment ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+    return alignment ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment) : std::malloc(size);
+#endif
+}
+
+void Free(void* p, bool aligned) noexcept
+{
+#ifdef _WIN32
+    aligned ? _aligned_free(p) : std::free(p);
+#else
+    (void)aligned;
+    std::free(p);
+#endif
+}
+
+void* AllocateOrThrow(std::size_t size, std::size_t alignment = 0)
+{
+    if (void* p = Allocate(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return AllocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return AllocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, std::size_t(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Allocate(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    Free(p, false);
+}
+
+void operator delete[](void* p) noexcept
+{
+    Free(p, false);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    Free(p, false);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    Free(p, false);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    Free(p, false);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    Free(p, false);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    Free(p, true);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    Free(p, true);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    Free(p, true);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    Free(p, true);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    Free(p, true);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    Free(p, true);
+}
+
+namespace GW2Radial
+{
+namespace
+{
+struct Element
+{
+    int id;
+};
+
+ElementConditions Mount(std::initializer_list<ConditionalProperties> props)
+{
+    std::uint32_t combined = 0;
+    for (auto p : props)
+        combined |= static_cast<std::uint32_t>(p);
+    return { VisibleStates(ConditionalProperties(combined)), UsableStates(ConditionalProperties(combined)), true, {} };
+}
+
+// The mount wheel: mounts restricted the way their defaults are, then its gated cancel and force elements
+std::vector<ElementConditions> MountWheelConditions()
+{
+    using enum ConditionalProperties;
+    std::vector<ElementConditions> conditions;
+    for (int i = 0; i < 9; i++)
+        conditions.push_back(Mount({ VisibleAll, UsableDefault, UsableWvW }));
+    conditions.push_back(Mount({ VisibleAll, UsableOnWater, UsableUnderwater })); // skimmer
+    conditions.push_back(Mount({ VisibleWvW, UsableWvW }));                       // warclaw
+    conditions.push_back({ 0, 0, true, MountGate::Cancel });
+    conditions.push_back({ 0, 0, true, MountGate::Force });
+    return conditions;
+}
+
+class ElementSetCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        conditions_ = MountWheelConditions();
+        table_.Compile(conditions_);
+        for (int i = 0; i < int(conditions_.size()); i++)
+            elements_.push_back({ i });
+
+        // Displayed in reverse, so the cache has an order of its own to keep
+        order_.resize(elements_.size());
+        std::iota(order_.rbegin(), order_.rend(), 0u);
+        visible_.Reserve(elements_.size());
+        usable_.Reserve(elements_.size());
+    }
+
+    const std::vector<Element*>& Visible(std::uint32_t conditions, std::uint64_t word)
+    {
+        return visible_.Get(conditions, word, order_, [&] { return table_.Visible(conditions, word); }, [&](std::uint32_t i) { return &elements_[i]; });
+    }
+
+    const std::vector<Element*>& Usable(std::uint32_t conditions, std::uint64_t word)
+    {
+        return usable_.Get(conditions, word, order_, [&] { return table_.Usable(conditions, word); }, [&](std::uint32_t i) { return &elements_[i]; });
+    }
+
+    std::vector<ElementConditions> conditions_;
+    ElementPredicateTable          table_;
+    std::vector<Element>           elements_;
+    std::vector<std::uint32_t>     order_;
+    ElementSetCache<Element>       visible_, usable_;
+};
+
+TEST_F(ElementSetCacheTest, KeepsDisplayOrderAndMatchesTable)
+{
+    for (std::uint32_t conditions = 0; conditions <= GameCondition::All; conditions++)
+    {
+        const auto& visible = Visible(conditions, 0);
+        const auto  mask    = table_.Visible(conditions, 0);
+        ASSERT_EQ(visible.size(), mask.count());
+        for (size_t i = 1; i < visible.size(); i++)
+            EXPECT_GT(visible[i - 1]->id, visible[i]->id);
+        for (const auto* e : visible)
+            EXPECT_TRUE(mask.test(size_t(e->id)));
+    }
+
+    // The cancel element only shows with its gate bits set
+    constexpr auto cancelWord = MountGate::QueuingEnabledBit | MountGate::ShowCancelBit | MountGate::InputQueuedBit;
+    EXPECT_EQ(Usable(GameCondition::None, cancelWord).front()->id, int(elements_.size()) - 2);
+}
+
+TEST_F(ElementSetCacheTest, RefillsOnlyWhenQueryChanges)
+{
+    Visible(GameCondition::None, 0);
+    Visible(GameCondition::None, 0);
+    EXPECT_EQ(visible_.fillCount(), 1u);
+    Visible(GameCondition::InCombat, 0);
+    Visible(GameCondition::InCombat, MountGate::QueuingEnabledBit);
+    EXPECT_EQ(visible_.fillCount(), 3u);
+
+    visible_.Invalidate();
+    Visible(GameCondition::InCombat, MountGate::QueuingEnabledBit);
+    EXPECT_EQ(visible_.fillCount(), 4u);
+}
+
+// The render and hover paths of 10k frames of the mount wheel: draw queries both sets, several mouse moves query the visible
+// one, and the game state and queued input change every so often. None of it may allocate.
+TEST_F(ElementSetCacheTest, FramesDoNotAllocate)
+{
+    constexpr int           Frames   = 10'000;
+    constexpr std::uint32_t States[] = { GameCondition::None, GameCondition::InCombat, GameCondition::OnWater, GameCondition::InWvW,
+                                         GameCondition::InWvW | GameCondition::InCombat };
+    constexpr std::uint64_t Words[]  = { MountGate::QueuingEnabledBit | MountGate::ShowCancelBit,
+                                         MountGate::QueuingEnabledBit | MountGate::ShowCancelBit | MountGate::InputQueuedBit };
+    size_t                  visibleCount = 0;
+
+    allocationCount  = 0;
+    countAllocations = true;
+    for (int frame = 0; frame < Frames; frame++)
+    {
+        const auto conditions = States[(frame / 200) % std::size(States)];
+        const auto word       = Words[(frame / 70) % std::size(Words)];
+
+        visibleCount += Visible(conditions, word).size();
+        visibleCount += Usable(conditions, word).size();
+        for (int move = 0; move < 4; move++)
+            visibleCount += Visible(conditions, word).size();
+    }
+    countAllocations = false;
+
+    EXPECT_EQ(allocationCount, 0u);
+    EXPECT_GT(visibleCount, 0u);
+    // Only state changes refill, never a frame that asks for the same state again
+    EXPECT_LT(visible_.fillCount(), size_t(Frames / 50));
+}
+} // namespace
+} // namespace GW2Radial
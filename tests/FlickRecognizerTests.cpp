@@ -0,0 +1,105 @@
+#include <FlickRecognizer.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+using Sample = HoverTracker::Sample;
+using State  = FlickRecognizer::State;
+
+// What Wheel::FlickThresholds gives for a 0.02 dead zone
+constexpr FlickRecognizer::Thresholds Thresholds{ .deadZone = 0.02f, .distance = 0.06f, .minSpeed = 0.0005f, .maxDuration = 150 };
+
+// Straight out from the center at a steady pace, one sample per interval milliseconds
+std::vector<Sample> Stroke(std::int64_t start, std::int64_t interval, float step, size_t count, glm::vec2 direction = { 1.f, 0.f })
+{
+    std::vector<Sample> trace;
+    for (size_t i = 0; i <= count; i++)
+        trace.push_back({ start + std::int64_t(i) * interval, direction * (step * float(i)) });
+    return trace;
+}
+
+TEST(FlickRecognizer, FastFlickCommits)
+{
+    const auto trace = Stroke(0, 8, 0.015f, 4);
+    EXPECT_EQ(FlickRecognizer::Replay(trace, Thresholds), glm::vec2(0.06f, 0.f));
+}
+
+// Aiming at an element moves too slowly to reach the commit distance within maxDuration
+TEST(FlickRecognizer, SlowAimingIsRejected)
+{
+    const auto      trace = Stroke(0, 16, 0.003f, 40);
+    EXPECT_EQ(FlickRecognizer::Replay(trace, Thresholds), std::nullopt);
+
+    FlickRecognizer recognizer;
+    recognizer.Reset(0, Thresholds);
+    for (const auto& s : trace)
+        EXPECT_EQ(recognizer.Feed(s.time, s.offset), std::nullopt);
+    EXPECT_EQ(recognizer.state(), State::Rejected);
+}
+
+// Reaching the distance in time is not enough if the average speed from the dead zone edge is too low
+TEST(FlickRecognizer, SlowArrivalIsRejected)
+{
+    const std::vector<Sample> trace{ { 0, { 0.f, 0.f } }, { 10, { 0.f, 0.021f } }, { 140, { 0.f, 0.06f } } };
+    EXPECT_EQ(FlickRecognizer::Replay(trace, Thresholds), std::nullopt);
+}
+
+TEST(FlickRecognizer, RearmsInCenterAfterRejection)
+{
+    auto trace = Stroke(0, 16, 0.003f, 40);
+    trace.push_back({ 700, { 0.f, 0.f } });
+    for (const auto& s : Stroke(716, 8, 0.015f, 5, { 0.f, -1.f }))
+        trace.push_back(s);
+
+    FlickRecognizer recognizer;
+    recognizer.Reset(0, Thresholds);
+    std::optional<glm::vec2> committed;
+    for (const auto& s : trace)
+    {
+        if (s.time == 700)
+        {
+            EXPECT_EQ(recognizer.state(), State::Rejected);
+        }
+        if (auto offset = recognizer.Feed(s.time, s.offset))
+        {
+            EXPECT_FALSE(committed) << "committed twice";
+            committed = offset;
+        }
+    }
+    EXPECT_EQ(committed, glm::vec2(0.f, -0.06f));
+    EXPECT_EQ(recognizer.state(), State::Committed);
+}
+
+// Returning to the center mid-gesture starts over instead of rejecting
+TEST(FlickRecognizer, ReturningToCenterRearms)
+{
+    const std::vector<Sample> trace{ { 0, { 0.f, 0.f } }, { 8, { 0.03f, 0.f } }, { 16, { 0.01f, 0.f } }, { 200, { 0.01f, 0.01f } }, { 208, { -0.07f, 0.f } } };
+    EXPECT_EQ(FlickRecognizer::Replay(trace, Thresholds), glm::vec2(-0.07f, 0.f));
+}
+
+// A single mouse move after the cursor rested counts as a gesture starting with that move
+TEST(FlickRecognizer, JumpAfterRestCommits)
+{
+    const std::vector<Sample> trace{ { 0, { 0.f, 0.f } }, { 1000, { 0.f, 0.1f } } };
+    EXPECT_EQ(FlickRecognizer::Replay(trace, Thresholds), glm::vec2(0.f, 0.1f));
+}
+
+TEST(FlickRecognizer, CommittedIsTerminalUntilReset)
+{
+    FlickRecognizer recognizer;
+    recognizer.Reset(0, Thresholds);
+    EXPECT_FALSE(recognizer.Feed(8, { 0.01f, 0.f }));
+    EXPECT_TRUE(recognizer.Feed(16, { 0.08f, 0.f }));
+    EXPECT_FALSE(recognizer.Feed(24, { 0.f, 0.f }));
+    EXPECT_FALSE(recognizer.Feed(32, { 0.f, 0.08f }));
+    EXPECT_EQ(recognizer.state(), State::Committed);
+
+    recognizer.Reset(100, Thresholds);
+    EXPECT_EQ(recognizer.state(), State::Armed);
+    EXPECT_TRUE(recognizer.Feed(108, { 0.f, 0.08f }));
+}
+} // namespace
+} // namespace GW2Radial
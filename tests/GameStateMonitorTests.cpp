@@ -0,0 +1,144 @@
+#include <GameStateMonitor.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+using Monitor = GameStateMonitor;
+
+// What MumbleLink would report over a short session: loading in, mounting, a fight, opening the map and swapping characters
+std::vector<GameSnapshot> Session()
+{
+    GameSnapshot              s{ .state = GameCondition::None, .gameHasFocus = true, .mapId = 15, .characterName = L"First" };
+    std::vector<GameSnapshot> session{ s };
+
+    s.mounted = true;
+    session.push_back(s);
+    session.push_back(s); // nothing changed between two updates
+    s.state = GameCondition::InCombat;
+    session.push_back(s);
+    s.state   = GameCondition::None;
+    s.mounted = false;
+    session.push_back(s);
+    s.mapOpen = true;
+    session.push_back(s);
+    s.mapOpen = false;
+    s.mapId   = 50;
+    session.push_back(s);
+    s.characterName = L"Second";
+    session.push_back(s);
+    s.gameHasFocus    = false;
+    s.textboxHasFocus = true;
+    session.push_back(s);
+    return session;
+}
+
+TEST(GameStateMonitor, DiffsEveryField)
+{
+    const GameSnapshot base;
+    auto               changed = [&](auto&& edit)
+    {
+        GameSnapshot s = base;
+        edit(s);
+        return Monitor::Diff(base, s);
+    };
+    EXPECT_EQ(Monitor::Diff(base, base), 0u);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.state = GameCondition::Underwater; }), Monitor::StateField);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.mounted = true; }), Monitor::MountedField);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.mapOpen = true; }), Monitor::MapOpenField);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.gameHasFocus = true; }), Monitor::FocusField);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.textboxHasFocus = true; }), Monitor::TextboxFocusField);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.mapId = 1; }), Monitor::MapField);
+    EXPECT_EQ(changed([](GameSnapshot& s) { s.characterName = L"x"; }), Monitor::CharacterField);
+}
+
+TEST(GameStateMonitor, PublishesSessionChanges)
+{
+    Monitor                    monitor;
+    std::vector<std::uint32_t> changes;
+    for (const auto& s : Session())
+        changes.push_back(monitor.Publish(s));
+
+    EXPECT_EQ(changes, (std::vector<std::uint32_t>{ Monitor::AllFields, Monitor::MountedField, 0, Monitor::StateField, Monitor::StateField | Monitor::MountedField,
+                                                    Monitor::MapOpenField, Monitor::MapOpenField | Monitor::MapField, Monitor::CharacterField,
+                                                    Monitor::FocusField | Monitor::TextboxFocusField }));
+    EXPECT_EQ(monitor.current().characterName, L"Second");
+}
+
+// Listeners hear of changes to their fields only, with the snapshots on either side of the change
+TEST(GameStateMonitor, NotifiesSubscribedFieldsOnly)
+{
+    Monitor                   monitor;
+    std::vector<GameSnapshot> mounts;
+    int                       mapNotifications = 0;
+    monitor.Publish({});
+    monitor.Subscribe(Monitor::MountedField,
+                      [&](const GameSnapshot& previous, const GameSnapshot& current, std::uint32_t changed)
+                      {
+                          EXPECT_TRUE(changed & Monitor::MountedField);
+                          EXPECT_NE(previous.mounted, current.mounted);
+                          mounts.push_back(current);
+                      });
+    monitor.Subscribe(Monitor::MapOpenField | Monitor::MapField, [&](const GameSnapshot&, const GameSnapshot&, std::uint32_t) { mapNotifications++; });
+
+    for (const auto& s : Session())
+        monitor.Publish(s);
+    ASSERT_EQ(mounts.size(), 2u);
+    EXPECT_TRUE(mounts[0].mounted);
+    EXPECT_FALSE(mounts[1].mounted);
+    EXPECT_EQ(mapNotifications, 3);
+}
+
+TEST(GameStateMonitor, FirstSnapshotNotifiesEveryone)
+{
+    Monitor monitor;
+    int     notified = 0;
+    monitor.Subscribe(Monitor::CharacterField,
+                      [&](const GameSnapshot&, const GameSnapshot&, std::uint32_t changed)
+                      {
+                          EXPECT_EQ(changed, Monitor::AllFields);
+                          notified++;
+                      });
+    EXPECT_EQ(monitor.Publish({}), Monitor::AllFields);
+    EXPECT_EQ(notified, 1);
+    EXPECT_EQ(monitor.Publish({}), 0u);
+    EXPECT_EQ(notified, 1);
+}
+
+// Subscriptions made while notifying wait for the next change; unsubscribing takes effect at once
+TEST(GameStateMonitor, ListenersMaySubscribeAndUnsubscribe)
+{
+    Monitor             monitor;
+    std::vector<int>    calls;
+    Monitor::ListenerId second = 0;
+    monitor.Subscribe(Monitor::AllFields,
+                      [&](const GameSnapshot&, const GameSnapshot&, std::uint32_t)
+                      {
+                          calls.push_back(1);
+                          if (second)
+                          {
+                              monitor.Unsubscribe(second);
+                              second = 0;
+                          }
+                          else
+                              monitor.Subscribe(Monitor::AllFields, [&](const GameSnapshot&, const GameSnapshot&, std::uint32_t) { calls.push_back(3); });
+                      });
+    second = monitor.Subscribe(Monitor::AllFields, [&](const GameSnapshot&, const GameSnapshot&, std::uint32_t) { calls.push_back(2); });
+
+    const auto session = Session();
+    monitor.Publish(session[0]);
+    EXPECT_EQ(calls, (std::vector<int>{ 1 }));
+    EXPECT_EQ(monitor.listenerCount(), 1u);
+
+    monitor.Publish(session[1]);
+    EXPECT_EQ(calls, (std::vector<int>{ 1, 1 }));
+    EXPECT_EQ(monitor.listenerCount(), 2u);
+
+    monitor.Publish(session[3]);
+    EXPECT_EQ(calls, (std::vector<int>{ 1, 1, 1, 3 }));
+    EXPECT_EQ(monitor.listenerCount(), 3u);
+}
+} // namespace
+} // namespace GW2Radial
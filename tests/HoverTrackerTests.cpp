@@ -0,0 +1,92 @@
+#include <HoverTracker.h>
+#include <WheelLayout.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+using Sample = HoverTracker::Sample;
+
+constexpr float        DeadZoneSq  = 0.05f * 0.05f;
+constexpr std::int64_t FlickWindow = 100;
+
+// A quick flick up and to the right, springing back to the center as the key is released
+const std::vector<Sample> FlickTrace{
+    { 0, { 0.f, 0.f } },       { 8, { 0.01f, -0.02f } }, { 16, { 0.04f, -0.07f } }, { 24, { 0.09f, -0.12f } },
+    { 32, { 0.11f, -0.13f } }, { 40, { 0.05f, -0.04f } }, { 48, { 0.01f, -0.01f } }, { 56, { 0.f, 0.f } },
+};
+
+TEST(HoverTracker, EmptyTrackerReleasesAtCenter)
+{
+    EXPECT_EQ(HoverTracker::Replay({}, 0, DeadZoneSq, FlickWindow), std::nullopt);
+}
+
+TEST(HoverTracker, RestingOutsideDeadZoneSelectsNewestSample)
+{
+    const std::vector<Sample> trace{ { 0, { 0.f, 0.f } }, { 10, { 0.2f, 0.f } }, { 20, { 0.f, 0.2f } } };
+    EXPECT_EQ(HoverTracker::Replay(trace, 1000, DeadZoneSq, FlickWindow), glm::vec2(0.f, 0.2f));
+}
+
+// The last sample outside the dead zone decides, not the furthest one
+TEST(HoverTracker, FlickSelectsSectorItReached)
+{
+    const auto offset = HoverTracker::Replay(FlickTrace, 60, DeadZoneSq, FlickWindow);
+    ASSERT_TRUE(offset);
+    EXPECT_EQ(*offset, glm::vec2(0.05f, -0.04f));
+
+    SectorTable sectors;
+    sectors.BuildUniform(8);
+    EXPECT_EQ(sectors.Resolve(*offset), 1u);
+}
+
+// Back in the center for longer than the flick window is a deliberate return
+TEST(HoverTracker, SettledInCenterReleasesAtCenter)
+{
+    EXPECT_EQ(HoverTracker::Replay(FlickTrace, 48 + FlickWindow, DeadZoneSq, FlickWindow), glm::vec2(0.05f, -0.04f));
+    EXPECT_EQ(HoverTracker::Replay(FlickTrace, 48 + FlickWindow + 1, DeadZoneSq, FlickWindow), std::nullopt);
+}
+
+// Mouse moves reporting the same offset again do not restart the time the cursor arrived in the center
+TEST(HoverTracker, RepeatedOffsetKeepsArrivalTime)
+{
+    HoverTracker tracker;
+    tracker.Push(0, { 0.2f, 0.f });
+    tracker.Push(10, { 0.f, 0.f });
+    tracker.Push(90, { 0.f, 0.f });
+    EXPECT_EQ(tracker.size(), 2u);
+    EXPECT_EQ(tracker.sample(0).time, 10);
+    EXPECT_EQ(tracker.ReleaseOffset(100, DeadZoneSq, FlickWindow), glm::vec2(0.2f, 0.f));
+    EXPECT_EQ(tracker.ReleaseOffset(111, DeadZoneSq, FlickWindow), std::nullopt);
+}
+
+// Jitter within the dead zone for longer than the history holds forgets the flick
+TEST(HoverTracker, KeepsOnlyCapacitySamples)
+{
+    std::vector<Sample> trace{ { 0, { 0.3f, 0.f } } };
+    for (std::int64_t t = 1; t <= std::int64_t(HoverTracker::Capacity); t++)
+        trace.push_back({ t, { 0.001f * float(t % 2), 0.f } });
+
+    HoverTracker tracker;
+    for (const auto& s : trace)
+        tracker.Push(s.time, s.offset);
+    EXPECT_EQ(tracker.size(), HoverTracker::Capacity);
+    EXPECT_EQ(tracker.sample(HoverTracker::Capacity - 1).time, 1);
+    EXPECT_EQ(tracker.ReleaseOffset(70, DeadZoneSq, FlickWindow), std::nullopt);
+
+    trace.pop_back();
+    EXPECT_EQ(HoverTracker::Replay(trace, 70, DeadZoneSq, FlickWindow), glm::vec2(0.3f, 0.f));
+}
+
+TEST(HoverTracker, ResetForgetsTrajectory)
+{
+    HoverTracker tracker;
+    tracker.Push(0, { 0.3f, 0.f });
+    tracker.Reset();
+    EXPECT_EQ(tracker.size(), 0u);
+    EXPECT_EQ(tracker.latest(), std::nullopt);
+    EXPECT_EQ(tracker.ReleaseOffset(0, DeadZoneSq, FlickWindow), std::nullopt);
+}
+} // namespace
+} // namespace GW2Radial
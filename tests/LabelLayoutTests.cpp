@@ -0,0 +1,88 @@
+#include <LabelLayout.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+namespace GW2Radial
+{
+namespace
+{
+struct Vec2
+{
+    float x, y;
+};
+
+// Measures text like ImFont::CalcTextSizeA: advances are given at FontSize and scaled to the requested size, lines stack
+// vertically and the widest one sets the width
+struct FakeFont
+{
+    static constexpr float FontSize = 16.f;
+
+    [[nodiscard]] static float Advance(char c)
+    {
+        switch (c)
+        {
+        case 'i':
+            return 4.f;
+        case 'W':
+            return 15.f;
+        default:
+            return 8.f;
+        }
+    }
+
+    [[nodiscard]] Vec2 CalcTextSizeA(float size, float, float, const char* text) const
+    {
+        const float scale = size / FontSize;
+        float       width = 0.f, line = 0.f;
+        int         lines = 1;
+        for (; *text; text++)
+        {
+            if (*text == '\n')
+            {
+                lines++;
+                line = 0.f;
+                continue;
+            }
+            line += Advance(*text) * scale;
+            width = std::max(width, line);
+        }
+        return { width, float(lines) * size };
+    }
+};
+
+const FakeFont  Font;
+const AtlasRect Rect{ 100, 40, 200, 30 };
+
+TEST(LabelLayout, CentersTextHorizontally)
+{
+    const auto at = LayoutLabel(&Font, 16.f, "iiWi", Rect);
+    EXPECT_FLOAT_EQ(at.x, 100.f + (200.f - 27.f) * 0.5f);
+    EXPECT_FLOAT_EQ(at.y, 40.f);
+}
+
+TEST(LabelLayout, ScalesWithFontSize)
+{
+    EXPECT_FLOAT_EQ(LayoutLabel(&Font, 32.f, "ab", Rect).x, 100.f + (200.f - 32.f) * 0.5f);
+    EXPECT_FLOAT_EQ(LayoutLabel(&Font, 8.f, "ab", Rect).x, 100.f + (200.f - 8.f) * 0.5f);
+}
+
+TEST(LabelLayout, WideTextOverhangsEvenly)
+{
+    const std::string text(30, 'W');
+    const auto        at = LayoutLabel(&Font, 16.f, text, Rect);
+    EXPECT_FLOAT_EQ(at.x, 100.f - (450.f - 200.f) * 0.5f);
+    EXPECT_FLOAT_EQ(at.x + 450.f * 0.5f, 100.f + 200.f * 0.5f);
+}
+
+TEST(LabelLayout, EmptyTextSitsAtCenter)
+{
+    EXPECT_FLOAT_EQ(LayoutLabel(&Font, 16.f, "", Rect).x, 200.f);
+}
+
+// ImGui draws every line from the same origin, so the widest one is centered
+TEST(LabelLayout, CentersWidestLine)
+{
+    EXPECT_FLOAT_EQ(LayoutLabel(&Font, 16.f, "ab\nabcd\ni", Rect).x, 100.f + (200.f - 32.f) * 0.5f);
+}
+} // namespace
+} // namespace GW2Radial
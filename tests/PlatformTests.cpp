@@ -0,0 +1,95 @@
+#include <NullPlatform.h>
+#include <gtest/gtest.h>
+
+namespace GW2Radial
+{
+namespace
+{
+TEST(Platform, InstallsServices)
+{
+    const Platform previous = CurrentPlatform();
+
+    NullPlatform   platform;
+    SetCurrentPlatform(platform.platform());
+    platform.time = 1234;
+    EXPECT_EQ(CurrentPlatform().clock->now(), 1234u);
+    EXPECT_EQ(CurrentPlatform().input, static_cast<InputSink*>(&platform));
+    EXPECT_EQ(CurrentPlatform().monitor, nullptr);
+
+    // Nothing else to restore when this runs first
+    if (previous.clock)
+        SetCurrentPlatform(previous);
+}
+
+TEST(NullPlatform, RecordsKeybindsWithTheirTime)
+{
+    NullPlatform platform;
+    platform.time = 100;
+    platform.SendKeybind({ 0x1E, 0 }, std::nullopt);
+    platform.Advance(50);
+    platform.SendKeybind({}, glm::ivec2(10, 20));
+    EXPECT_TRUE(platform.PressKeybindNow({ 0x1F, 2 }));
+    platform.ReleaseKeybindNow({ 0x1F, 2 });
+
+    ASSERT_EQ(platform.sentKeybinds.size(), 3u);
+    EXPECT_EQ(platform.sentKeybinds[0].keys, (KeyChord{ 0x1E, 0 }));
+    EXPECT_EQ(platform.sentKeybinds[0].time, 100u);
+    EXPECT_EQ(platform.sentKeybinds[1].time, 150u);
+    EXPECT_EQ(platform.sentKeybinds[1].cursorPos, glm::ivec2(10, 20));
+    EXPECT_EQ(platform.sentKeybinds[2].keys, (KeyChord{ 0x1F, 2 }));
+    ASSERT_EQ(platform.releasedKeybinds.size(), 1u);
+    EXPECT_EQ(platform.releasedKeybinds[0].keys, (KeyChord{ 0x1F, 2 }));
+
+    // Moving the cursor as part of a keybind moves the recorded cursor as well
+    EXPECT_EQ(platform.position(), glm::vec2(10.f, 20.f));
+
+    // Without focus the game cannot receive the press
+    platform.hasFocus = false;
+    EXPECT_FALSE(platform.PressKeybindNow({ 0x20, 0 }));
+    EXPECT_EQ(platform.sentKeybinds.size(), 3u);
+
+    platform.Reset();
+    EXPECT_TRUE(platform.sentKeybinds.empty());
+    EXPECT_TRUE(platform.releasedKeybinds.empty());
+}
+
+TEST(NullPlatform, CentersCursor)
+{
+    NullPlatform platform;
+    platform.screen = { 800, 600 };
+    EXPECT_TRUE(platform.CenterInWindow());
+    EXPECT_EQ(platform.position(), glm::vec2(400.f, 300.f));
+    EXPECT_EQ(platform.centerCount, 1u);
+}
+
+TEST(NullPlatform, RaisesMouseEventsToSubscribers)
+{
+    NullPlatform platform;
+    int          moves = 0, buttons = 0;
+    const auto   move   = platform.SubscribeMouseMove([&](bool&) { moves++; });
+    const auto   button = platform.SubscribeMouseButton(
+        [&](std::uint32_t scanCode, bool down, bool& passToGame)
+        {
+            buttons++;
+            if (scanCode == 1 && down)
+                passToGame = false;
+        });
+    EXPECT_EQ(platform.subscriptionCount(), 2u);
+
+    EXPECT_TRUE(platform.RaiseMouseMove({ 5.f, 6.f }));
+    EXPECT_EQ(platform.livePosition(), glm::vec2(5.f, 6.f));
+    EXPECT_FALSE(platform.RaiseMouseButton(1, true));
+    EXPECT_TRUE(platform.RaiseMouseButton(1, false));
+    EXPECT_EQ(moves, 1);
+    EXPECT_EQ(buttons, 2);
+
+    platform.Unsubscribe(move);
+    platform.Unsubscribe(button);
+    EXPECT_EQ(platform.subscriptionCount(), 0u);
+    platform.RaiseMouseMove({});
+    platform.RaiseMouseButton(1, true);
+    EXPECT_EQ(moves, 1);
+    EXPECT_EQ(buttons, 2);
+}
+} // namespace
+} // namespace GW2Radial
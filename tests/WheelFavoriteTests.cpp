@@ -0,0 +1,59 @@
+#include <WheelFavorite.h>
+#include <gtest/gtest.h>
+
+namespace GW2Radial
+{
+namespace
+{
+WheelFavorite Favorite(int baseline, int inCombat, int onWater, int underwater, int inWvW)
+{
+    WheelFavorite fav{};
+    fav.bits.baseline   = baseline;
+    fav.bits.inCombat   = inCombat;
+    fav.bits.onWater    = onWater;
+    fav.bits.underwater = underwater;
+    fav.bits.inWvW      = inWvW;
+    return fav;
+}
+
+// Every index the favorite pickers offer, and -1, survives a round trip through the stored word without touching the other fields
+TEST(WheelFavorite, StoresEveryIndexUpToMaxIndex)
+{
+    for (int index = -1; index <= WheelFavorite::MaxIndex; index++)
+    {
+        WheelFavorite stored{};
+        stored.value = Favorite(index, 1, -1, index, 2).value;
+        EXPECT_EQ(stored.bits.baseline, index);
+        EXPECT_EQ(stored.bits.inCombat, 1);
+        EXPECT_EQ(stored.bits.onWater, -1);
+        EXPECT_EQ(stored.bits.underwater, index);
+        EXPECT_EQ(stored.bits.inWvW, 2);
+    }
+}
+
+// Why the pickers stop at MaxIndex: the next index does not fit and reads back as something else entirely
+TEST(WheelFavorite, IndexPastMaxIndexDoesNotFit)
+{
+    const auto fav = Favorite(WheelFavorite::MaxIndex + 1, -1, -1, -1, -1);
+    EXPECT_NE(fav.bits.baseline, WheelFavorite::MaxIndex + 1);
+    EXPECT_LT(fav.bits.baseline, 0);
+}
+
+TEST(WheelFavorite, PicksByPrecedence)
+{
+    const auto fav = Favorite(0, 1, 2, 3, 4);
+    EXPECT_EQ(fav.Pick(GameCondition::None), 0);
+    EXPECT_EQ(fav.Pick(GameCondition::Underwater), 3);
+    EXPECT_EQ(fav.Pick(GameCondition::OnWater | GameCondition::Underwater), 2);
+    EXPECT_EQ(fav.Pick(GameCondition::InCombat | GameCondition::OnWater), 1);
+    EXPECT_EQ(fav.Pick(GameCondition::All), 4);
+}
+
+TEST(WheelFavorite, UnsetStatesFallBackToBaseline)
+{
+    const auto fav = Favorite(WheelFavorite::MaxIndex, -1, -1, 5, -1);
+    EXPECT_EQ(fav.Pick(GameCondition::InWvW | GameCondition::InCombat), WheelFavorite::MaxIndex);
+    EXPECT_EQ(fav.Pick(GameCondition::InWvW | GameCondition::Underwater), 5);
+}
+} // namespace
+} // namespace GW2Radial
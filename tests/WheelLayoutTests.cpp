@@ -0,0 +1,183 @@
+#include <WheelLayout.h>
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace GW2Radial
+{
+namespace
+{
+constexpr glm::vec4 Wheel{ 0.5f, 0.5f, 1.f, 1.f };
+
+TEST(ComputeElementLayout, PlacesElementsClockwiseFromTop)
+{
+    const auto top    = ComputeElementLayout(0, 4, Wheel, 0.f, 1.f);
+    const auto right  = ComputeElementLayout(1, 4, Wheel, 0.f, 1.f);
+    const auto bottom = ComputeElementLayout(2, 4, Wheel, 0.f, 1.f);
+    const auto left   = ComputeElementLayout(3, 4, Wheel, 0.f, 1.f);
+
+    EXPECT_NEAR(top.spriteDimensions.x, 0.5f, 1e-6f);
+    EXPECT_NEAR(top.spriteDimensions.y, 0.3f, 1e-6f);
+    EXPECT_NEAR(right.spriteDimensions.x, 0.7f, 1e-6f);
+    EXPECT_NEAR(right.spriteDimensions.y, 0.5f, 1e-6f);
+    EXPECT_NEAR(bottom.spriteDimensions.y, 0.7f, 1e-6f);
+    EXPECT_NEAR(left.spriteDimensions.x, 0.3f, 1e-6f);
+}
+
+// Values the inline math in WheelElement::Draw produced before it was factored out
+TEST(ComputeElementLayout, MatchesPreviousDrawMath)
+{
+    const auto four = ComputeElementLayout(1, 4, Wheel, 0.f, 1.f);
+    EXPECT_NEAR(four.spriteDimensions.z, 0.95f * std::sin(0.25f * 3.14159265f) * 0.264f, 1e-6f);
+    EXPECT_EQ(four.spriteDimensions.z, four.spriteDimensions.w);
+    EXPECT_FLOAT_EQ(four.spriteZ, 0.02f);
+    EXPECT_FLOAT_EQ(four.shadowSpriteZ, 0.f);
+
+    const auto single = ComputeElementLayout(0, 1, { 0.5f, 0.5f, 2.f, 1.f }, 1.f, 1.f);
+    EXPECT_NEAR(single.spriteDimensions.x, 0.5f, 1e-6f);
+    EXPECT_NEAR(single.spriteDimensions.y, 0.3f, 1e-6f);
+    EXPECT_NEAR(single.spriteDimensions.z, 2.f * 0.5f * 0.4f, 1e-6f);
+    EXPECT_NEAR(single.spriteDimensions.w, 1.f * 0.5f * 0.4f, 1e-6f);
+}
+
+TEST(ComputeElementLayout, HoverGrowsElementAndShadow)
+{
+    for (size_t count : { 2u, 5u, 12u, 40u })
+    {
+        const auto idle    = ComputeElementLayout(1, count, Wheel, 0.f, 1.f);
+        const auto hovered = ComputeElementLayout(1, count, Wheel, 1.f, 1.f);
+        EXPECT_NEAR(hovered.spriteDimensions.z / idle.spriteDimensions.z, 1.1f, 1e-5f) << count;
+        EXPECT_NEAR(hovered.spriteZ, 0.06f, 1e-6f) << count;
+        EXPECT_NEAR(idle.shadowSpriteDimensions.z / idle.spriteDimensions.z, 1.05f, 1e-5f) << count;
+        EXPECT_NEAR(hovered.shadowSpriteDimensions.z / hovered.spriteDimensions.z, 1.09f, 1e-5f) << count;
+
+        // Hovering scales the element in place
+        EXPECT_EQ(hovered.spriteDimensions.x, idle.spriteDimensions.x);
+        EXPECT_EQ(hovered.shadowSpriteDimensions.x, hovered.spriteDimensions.x);
+    }
+}
+
+TEST(ComputeElementLayout, AspectRatioOnlyScalesHeight)
+{
+    const auto square = ComputeElementLayout(3, 8, Wheel, 0.5f, 1.f);
+    const auto tall   = ComputeElementLayout(3, 8, Wheel, 0.5f, 2.f);
+    EXPECT_EQ(tall.spriteDimensions.z, square.spriteDimensions.z);
+    EXPECT_NEAR(tall.spriteDimensions.w, square.spriteDimensions.w * 2.f, 1e-6f);
+    EXPECT_EQ(tall.spriteDimensions.x, square.spriteDimensions.x);
+    EXPECT_EQ(tall.spriteDimensions.y, square.spriteDimensions.y);
+}
+
+// An element is sized to a fraction of the chord to its neighbor, which hovering never grows past
+TEST(ComputeElementLayout, StaysWithinChordToNeighbor)
+{
+    for (size_t count = 2; count <= 128; count++)
+    {
+        const auto  a        = ComputeElementLayout(0, count, Wheel, 1.f, 1.f);
+        const auto  b        = ComputeElementLayout(1, count, Wheel, 1.f, 1.f);
+        const float distance = std::hypot(a.spriteDimensions.x - b.spriteDimensions.x, a.spriteDimensions.y - b.spriteDimensions.y);
+        EXPECT_LT(a.spriteDimensions.z, distance) << count;
+    }
+}
+
+constexpr float TwoPi = 2 * std::numbers::pi_v<float>;
+
+// Clockwise angle from straight up of a screen-space offset, as the atan2 formulation SectorTable replaced computed it
+float ClockwiseAngle(glm::vec2 offset)
+{
+    float angle = std::atan2(-offset.y, -offset.x) - 0.5f * std::numbers::pi_v<float>;
+    if (angle < 0)
+        angle += TwoPi;
+    return angle;
+}
+
+// Points in the ring around the center, at any angle and distance
+std::vector<glm::vec2> RandomOffsets(size_t count)
+{
+    std::mt19937                          rng(1234);
+    std::uniform_real_distribution<float> angle(0.f, TwoPi), radius(0.01f, 2.f);
+    std::vector<glm::vec2>                offsets(count);
+    for (auto& o : offsets)
+    {
+        const float a = angle(rng);
+        o             = radius(rng) * glm::vec2(std::cos(a), std::sin(a));
+    }
+    return offsets;
+}
+
+// Points this close to a boundary may round either way in either formulation
+constexpr float BoundaryTolerance = 1e-4f;
+
+TEST(SectorTable, UniformMatchesAtan2)
+{
+    const auto offsets = RandomOffsets(10'000);
+    for (size_t count = 1; count <= 128; count++)
+    {
+        SectorTable sectors;
+        sectors.BuildUniform(count);
+        ASSERT_EQ(sectors.sectorCount(), count);
+
+        const float elementAngle = TwoPi / float(count);
+        for (const auto& o : offsets)
+        {
+            const float mouseAngle = ClockwiseAngle(o);
+            const float fromEdge   = std::fmod(mouseAngle + elementAngle / 2, elementAngle);
+            if (count > 1 && std::min(fromEdge, elementAngle - fromEdge) < BoundaryTolerance)
+                continue;
+
+            const auto expected = size_t((mouseAngle - elementAngle / 2) / elementAngle + 1) % count;
+            ASSERT_EQ(sectors.Resolve(o), expected) << count << " sectors, angle " << mouseAngle;
+        }
+    }
+}
+
+// Each weighted sector spans its share of the circle, starting with sector 0 centered straight up
+TEST(SectorTable, WeightedMatchesAngles)
+{
+    const std::vector<float> weights{ 1.f, 3.f, 0.f, 0.5f, 2.f, -1.f, 1.f };
+    float                    total = 0.f;
+    for (float w : weights)
+        total += std::max(w, 0.f);
+
+    SectorTable sectors;
+    sectors.Build(weights);
+    for (const auto& o : RandomOffsets(10'000))
+    {
+        float t = std::fmod(ClockwiseAngle(o) + 0.5f * weights[0] / total * TwoPi, TwoPi);
+
+        size_t expected = 0;
+        bool   nearEdge = t < BoundaryTolerance || TwoPi - t < BoundaryTolerance;
+        for (size_t i = 0; i < weights.size(); i++)
+        {
+            const float width = std::max(weights[i], 0.f) / total * TwoPi;
+            if (t < width)
+            {
+                expected = i;
+                nearEdge = nearEdge || width - t < BoundaryTolerance;
+                break;
+            }
+            t -= width;
+            nearEdge = nearEdge || std::abs(t) < BoundaryTolerance;
+        }
+        if (nearEdge)
+            continue;
+
+        const auto sector = sectors.Resolve(o);
+        EXPECT_GT(weights[sector], 0.f);
+        ASSERT_EQ(sector, expected);
+    }
+}
+
+TEST(SectorTable, NonPositiveWeightsFallBackToUniform)
+{
+    const std::vector<float> weights{ 0.f, -1.f, 0.f, 0.f };
+    SectorTable              sectors, uniform;
+    sectors.Build(weights);
+    uniform.BuildUniform(weights.size());
+    for (const auto& o : RandomOffsets(1'000))
+        ASSERT_EQ(sectors.Resolve(o), uniform.Resolve(o));
+}
+} // namespace
+} // namespace GW2Radial